@@ -0,0 +1,240 @@
+#include "bench_common.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <new>
+
+static std::atomic<u64> s_allocationCount{0};
+
+void *operator new(size_t size)
+{
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void *pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == NTT_NULL)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace ntt
+{
+    namespace
+    {
+        struct BenchmarkEntry
+        {
+            const char *name;
+            BenchmarkFunction function;
+        };
+
+        Vector<BenchmarkEntry> &GetBenchmarks()
+        {
+            static Vector<BenchmarkEntry> benchmarks;
+            return benchmarks;
+        }
+
+        constexpr f64 TARGET_SECONDS = 0.5;
+        constexpr u32 MAX_ITERATIONS = 100000;
+    } // namespace anonymous
+
+    BenchmarkState::BenchmarkState(u32 iterations)
+        : m_iterations(iterations), m_remainingIterations(iterations), m_isStarted(NTT_FALSE),
+          m_startAllocations(0), m_pauseAllocations(0), m_pausedSeconds(0.0), m_pausedAllocations(0),
+          m_elapsedSeconds(0.0), m_allocations(0),
+          m_bytesPerIteration(0), m_itemsPerIteration(0), m_itemUnit("items")
+    {
+    }
+
+    b8 BenchmarkState::KeepRunning()
+    {
+        if (!m_isStarted)
+        {
+            m_isStarted = NTT_TRUE;
+            m_startAllocations = GetAllocationCount();
+            m_startTime = std::chrono::steady_clock::now();
+        }
+
+        if (m_remainingIterations > 0)
+        {
+            m_remainingIterations--;
+            return NTT_TRUE;
+        }
+
+        m_elapsedSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - m_startTime).count() -
+                           m_pausedSeconds;
+        m_allocations = GetAllocationCount() - m_startAllocations - m_pausedAllocations;
+        return NTT_FALSE;
+    }
+
+    void BenchmarkState::PauseTiming()
+    {
+        m_pauseAllocations = GetAllocationCount();
+        m_pauseTime = std::chrono::steady_clock::now();
+    }
+
+    void BenchmarkState::ResumeTiming()
+    {
+        m_pausedSeconds += std::chrono::duration<f64>(std::chrono::steady_clock::now() - m_pauseTime).count();
+        m_pausedAllocations += GetAllocationCount() - m_pauseAllocations;
+    }
+
+    b8 RegisterBenchmark(const char *name, BenchmarkFunction function)
+    {
+        GetBenchmarks().push_back({name, function});
+        return NTT_TRUE;
+    }
+
+    u64 GetAllocationCount()
+    {
+        return s_allocationCount.load(std::memory_order_relaxed);
+    }
+} // namespace ntt
+
+namespace
+{
+    struct BaselineResult
+    {
+        f64 microsecondsPerIteration;
+        f64 allocationsPerIteration;
+    };
+
+    /**
+     * A benchmark is reported as a regression when it is this much slower than the
+     *      baseline, or when it allocates more.
+     */
+    constexpr f64 REGRESSION_RATIO = 1.10;
+
+    std::map<std::string, BaselineResult> LoadBaseline(const char *path)
+    {
+        std::map<std::string, BaselineResult> baseline;
+        std::ifstream file(path);
+        std::string name;
+        BaselineResult result;
+        while (file >> name >> result.microsecondsPerIteration >> result.allocationsPerIteration)
+        {
+            baseline[name] = result;
+        }
+        return baseline;
+    }
+} // namespace anonymous
+
+/**
+ * Runs every registered benchmark, or only those whose name contains the filter.
+ *
+ * Usage: CCompiler_bench [filter] [--save <file>] [--compare <file>]
+ *      --save writes the time and allocations of every benchmark to the file.
+ *      --compare reads a file written by --save and fails when a benchmark regressed.
+ */
+int main(int argc, char **argv)
+{
+    using namespace ntt;
+    const char *filter = NTT_NULL;
+    const char *savePath = NTT_NULL;
+    const char *comparePath = NTT_NULL;
+
+    for (int argumentIndex = 1; argumentIndex < argc; argumentIndex++)
+    {
+        if (std::strcmp(argv[argumentIndex], "--save") == 0 && argumentIndex + 1 < argc)
+        {
+            savePath = argv[++argumentIndex];
+        }
+        else if (std::strcmp(argv[argumentIndex], "--compare") == 0 && argumentIndex + 1 < argc)
+        {
+            comparePath = argv[++argumentIndex];
+        }
+        else
+        {
+            filter = argv[argumentIndex];
+        }
+    }
+
+    std::map<std::string, BaselineResult> baseline;
+    if (comparePath != NTT_NULL)
+    {
+        baseline = LoadBaseline(comparePath);
+    }
+
+    std::ofstream saveFile;
+    if (savePath != NTT_NULL)
+    {
+        saveFile.open(savePath);
+    }
+
+    printf("%-40s %10s %14s %14s %10s %10s %16s\n",
+           "benchmark", "iterations", "time/iter(us)", "allocs/iter", "MB/s", "ns/item", "items/s");
+
+    u32 numberOfRegressions = 0;
+    for (const auto &benchmark : GetBenchmarks())
+    {
+        if (filter != NTT_NULL && std::strstr(benchmark.name, filter) == NTT_NULL)
+        {
+            continue;
+        }
+
+        BenchmarkState calibration(1);
+        benchmark.function(calibration);
+
+        u32 iterations = MAX_ITERATIONS;
+        if (calibration.GetElapsedSeconds() > 0.0)
+        {
+            f64 estimatedIterations = TARGET_SECONDS / calibration.GetElapsedSeconds();
+            iterations = u32(std::max(1.0, std::min(f64(MAX_ITERATIONS), estimatedIterations)));
+        }
+
+        BenchmarkState state(iterations);
+        benchmark.function(state);
+
+        f64 seconds = state.GetElapsedSeconds();
+        f64 secondsPerIteration = seconds / state.GetIterations();
+        f64 allocationsPerIteration = f64(state.GetAllocations()) / state.GetIterations();
+        f64 megabytesPerSecond = seconds > 0.0
+                                     ? f64(state.GetBytesPerIteration()) * state.GetIterations() / seconds / 1e6
+                                     : 0.0;
+        f64 itemsPerSecond = seconds > 0.0
+                                 ? f64(state.GetItemsPerIteration()) * state.GetIterations() / seconds
+                                 : 0.0;
+
+        f64 nanosecondsPerItem = itemsPerSecond > 0.0 ? 1e9 / itemsPerSecond : 0.0;
+
+        printf("%-40s %10u %14.2f %14.1f %10.2f %10.2f %12.0f %s",
+               benchmark.name,
+               state.GetIterations(),
+               secondsPerIteration * 1e6,
+               allocationsPerIteration,
+               megabytesPerSecond,
+               nanosecondsPerItem,
+               itemsPerSecond,
+               state.GetItemUnit());
+
+        auto baselineResult = baseline.find(benchmark.name);
+        if (baselineResult != baseline.end())
+        {
+            f64 timeRatio = secondsPerIteration * 1e6 / baselineResult->second.microsecondsPerIteration;
+            b8 isRegression = timeRatio > REGRESSION_RATIO ||
+                              allocationsPerIteration > baselineResult->second.allocationsPerIteration + 0.5;
+            printf("  x%.2f%s", timeRatio, isRegression ? " REGRESSION" : "");
+            numberOfRegressions += isRegression;
+        }
+        printf("\n");
+
+        if (saveFile.is_open())
+        {
+            saveFile << benchmark.name << " " << secondsPerIteration * 1e6 << " " << allocationsPerIteration << "\n";
+        }
+    }
+
+    return numberOfRegressions > 0 ? 1 : 0;
+}
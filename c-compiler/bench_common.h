@@ -0,0 +1,75 @@
+#pragma once
+#include "pch.h"
+#include <chrono>
+
+namespace ntt
+{
+    /**
+     * Handed to every benchmark, the benchmark prepares its input and then runs the
+     *      measured code inside `while (state.KeepRunning())`. Only the loop is timed and
+     *      only the allocations made inside the loop are counted.
+     */
+    class BenchmarkState
+    {
+    public:
+        BenchmarkState(u32 iterations);
+
+        b8 KeepRunning();
+
+        /**
+         * The time and the allocations between these two calls are not counted, used to
+         *      prepare the input of each iteration inside the loop.
+         */
+        void PauseTiming();
+        void ResumeTiming();
+
+        /**
+         * Amount of input processed by one iteration, used for the throughput columns.
+         */
+        inline void SetBytesPerIteration(u64 bytes) { m_bytesPerIteration = bytes; }
+        inline void SetItemsPerIteration(u64 items, const char *unit)
+        {
+            m_itemsPerIteration = items;
+            m_itemUnit = unit;
+        }
+
+        inline u32 GetIterations() const { return m_iterations; }
+        inline f64 GetElapsedSeconds() const { return m_elapsedSeconds; }
+        inline u64 GetAllocations() const { return m_allocations; }
+        inline u64 GetBytesPerIteration() const { return m_bytesPerIteration; }
+        inline u64 GetItemsPerIteration() const { return m_itemsPerIteration; }
+        inline const char *GetItemUnit() const { return m_itemUnit; }
+
+    private:
+        u32 m_iterations;
+        u32 m_remainingIterations;
+        b8 m_isStarted;
+        std::chrono::steady_clock::time_point m_startTime;
+        u64 m_startAllocations;
+
+        std::chrono::steady_clock::time_point m_pauseTime;
+        u64 m_pauseAllocations;
+        f64 m_pausedSeconds;
+        u64 m_pausedAllocations;
+
+        f64 m_elapsedSeconds;
+        u64 m_allocations;
+        u64 m_bytesPerIteration;
+        u64 m_itemsPerIteration;
+        const char *m_itemUnit;
+    };
+
+    typedef void (*BenchmarkFunction)(BenchmarkState &state);
+
+    b8 RegisterBenchmark(const char *name, BenchmarkFunction function);
+
+    /**
+     * @return The number of heap allocations made by the process so far.
+     */
+    u64 GetAllocationCount();
+} // namespace ntt
+
+#define NTT_BENCHMARK(name)                                                   \
+    static void name(ntt::BenchmarkState &state);                             \
+    static const b8 name##Registered = ntt::RegisterBenchmark(#name, name); \
+    static void name(ntt::BenchmarkState &state)
@@ -0,0 +1,131 @@
+#pragma once
+#include "pch.h"
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace ntt
+{
+    class SourceFile;
+
+    /**
+     * Region allocator for the nodes of one compilation. The nodes are bump allocated
+     *      inside big blocks together with their reference counter, so a node costs no
+     *      heap allocation of its own.
+     *
+     * The nodes are handed out as normal owning `Ref`: a node is destroyed with its last
+     *      ref, and every node keeps the blocks alive, so the refs copied out of the tree
+     *      stay valid after the arena and the tree are gone. The memory of the destroyed
+     *      nodes is only reused when all the blocks are released.
+     *
+     * The blocks also keep the source file of the tree alive, the tokens of the nodes
+     *      view their text in it.
+     */
+    class AstArena
+    {
+    public:
+        static constexpr u32 DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+        AstArena(u32 blockSize = DEFAULT_BLOCK_SIZE);
+        AstArena(const AstArena &) = delete;
+        AstArena &operator=(const AstArena &) = delete;
+        ~AstArena();
+
+        /**
+         * Constructs the object inside the arena, its destructor is called when its last
+         *      ref is released.
+         */
+        template <typename T, typename... Args>
+        Ref<T> Create(Args &&...args)
+        {
+            m_objectCount++;
+            return std::allocate_shared<T>(Allocator<T>(m_blocks), std::forward<Args>(args)...);
+        }
+
+        /**
+         * Keeps `source` alive with the nodes, instead of the previous source file.
+         */
+        inline void SetSource(const Ref<SourceFile> &source) { m_blocks->source = source; }
+
+        inline u32 GetObjectCount() const { return m_objectCount; }
+        inline u32 GetBlockCount() const { return u32(m_blocks->blocks.size()); }
+
+    private:
+        /**
+         * The memory of the arena, it is released when the arena and all the objects
+         *      allocated in it are gone.
+         */
+        struct Blocks
+        {
+            u32 blockSize;
+            Vector<Scope<u8[]>> blocks;
+            u8 *cursor;
+            u8 *end;
+            Ref<SourceFile> source;
+
+            /**
+             * The arena and the objects which are not destroyed yet, counted apart from
+             *      the refs so that copying the allocator costs nothing.
+             */
+            std::atomic<u32> numberOfUsers;
+
+            void *Allocate(u32 size, u32 alignment);
+            void Release();
+        };
+
+        /**
+         * Allocator of `std::allocate_shared`, the object and its counter are allocated
+         *      in the blocks and never freed one by one.
+         */
+        template <typename T>
+        struct Allocator
+        {
+            typedef T value_type;
+
+            Allocator(Blocks *blocks) : blocks(blocks) {}
+
+            template <typename U>
+            Allocator(const Allocator<U> &other) : blocks(other.blocks) {}
+
+            T *allocate(size_t count)
+            {
+                blocks->numberOfUsers++;
+                return static_cast<T *>(blocks->Allocate(u32(count * sizeof(T)), u32(alignof(T))));
+            }
+
+            void deallocate(T *pointer, size_t count)
+            {
+                NTT_UNUSED(pointer);
+                NTT_UNUSED(count);
+                blocks->Release();
+            }
+
+            template <typename U>
+            b8 operator==(const Allocator<U> &other) const { return blocks == other.blocks; }
+
+            template <typename U>
+            b8 operator!=(const Allocator<U> &other) const { return blocks != other.blocks; }
+
+            Blocks *blocks;
+        };
+
+    private:
+        Blocks *m_blocks;
+        u32 m_objectCount;
+    };
+
+    /**
+     * Creates the node inside the arena, or as a normal shared node when there is no
+     *      arena (for the trees which are built by hand).
+     */
+    template <typename T, typename... Args>
+    Ref<T> CreateNode(AstArena *arena, Args &&...args)
+    {
+        if (arena != NTT_NULL)
+        {
+            return arena->Create<T>(std::forward<Args>(args)...);
+        }
+
+        return CreateRef<T>(std::forward<Args>(args)...);
+    }
+} // namespace ntt
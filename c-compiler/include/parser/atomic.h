@@ -12,16 +12,24 @@ namespace ntt
         ~Atomic();
 
         inline NodeType GetType() const override { return NodeType::ATOMIC; }
+        static inline b8 IsTypeOf(NodeType type) { return type == NodeType::ATOMIC; }
+
         JSON ToJSON() override;
 
         void Compress() override;
         void Parse() override;
+        void Accept(NodeVisitor &visitor) override;
 
         /**
          * @return The token that this atomic node represents.
          */
         inline const Token &GetToken() const { return m_token; }
 
+        /**
+         * Moves the token of this atomic, see `Token::Rebase`.
+         */
+        inline void Rebase(u32 startIndex, const SourceFile &source) { m_token.Rebase(startIndex, source); }
+
     private:
         Token m_token;
     };
@@ -1,45 +1,71 @@
 #pragma once
 #include "pch.h"
 #include "node.h"
+#include "tokenizer/source_file.h"
+#include "tokenizer/symbol_table.h"
+#include "ast_arena.h"
 
 namespace ntt
 {
+    class Atomic;
+
     /**
      * This type of node will contain multiple nodes inside it.
      */
     class BlockNode : public Node
     {
+        friend class IncrementalParser;
+
     public:
         BlockNode(NodeType type, const String &content);
         BlockNode(NodeType type, const Vector<Ref<Node>> &children);
         ~BlockNode();
 
         inline NodeType GetType() const override { return m_type; }
+        static b8 IsTypeOf(NodeType type);
+
         JSON ToJSON() override;
 
         void Compress() override;
         void Parse() override;
+        void Accept(NodeVisitor &visitor) override;
 
     public:
         inline const Vector<Ref<Node>> &GetChildren() const { return m_children; }
+        inline Vector<Ref<Node>> &GetChildren() { return m_children; }
+
+        /**
+         * @return The text the tokens of this tree view into, only set for the blocks
+         *      which are created from the text content.
+         */
+        inline const Ref<SourceFile> &GetSource() const { return m_source; }
+
+        /**
+         * The first and the last token the block was built from, the brackets of a group
+         *      and the semicolon of a statement included. The last one is null for the
+         *      groups without closing bracket and the statements without semicolon, both
+         *      are null for the blocks which are not built from tokens.
+         */
+        inline const Atomic *GetFirstAtomic() const { return m_firstAtomic; }
+        inline const Atomic *GetLastAtomic() const { return m_lastAtomic; }
 
     private:
         void TokenizeContent();
 
-        Vector<Ref<Node>> CompressWithBrackets(const Vector<Ref<Node>> &nodes,
-                                               NodeType blockType,
-                                               const String &bracketOpen,
-                                               const String &bracketClose);
+        /**
+         * Creates a child block which allocates its own nodes from the same arena.
+         */
+        Ref<BlockNode> CreateBlock(NodeType type, const Vector<Ref<Node>> &children) const;
 
-        void ParseUnaryOperations(const Vector<Ref<Node>> &sourceNodes,
-                                  Vector<Ref<Node>> &outNodes,
-                                  b8 &hasAnyChange,
-                                  const std::set<String> &operators);
+        /**
+         * Groups the nodes between the brackets into BLOCK, EXPRESSION and INDEX nodes,
+         *      braces take precedence over parentheses which take precedence over square
+         *      brackets. Linear in the number of nodes for any nesting depth.
+         */
+        Vector<Ref<Node>> CompressBrackets(const Vector<Ref<Node>> &nodes) const;
 
         void ParseOperations(const Vector<Ref<Node>> &sourceNodes,
-                             Vector<Ref<Node>> &outNodes,
-                             b8 &hasAnyChange,
-                             const std::set<String> &operators);
+                             Vector<Ref<Node>> &outNodes);
 
         void ParseStatements(const Vector<Ref<Node>> &sourceNodes,
                              Vector<Ref<Node>> &outNodes);
@@ -60,7 +86,26 @@ namespace ntt
 
     private:
         NodeType m_type = NodeType::INVALID;
+
+        /**
+         * The blocks created from the text content create the arena of the whole tree,
+         *      the blocks created while parsing share it so that they can still be parsed
+         *      once the root is gone. The blocks which are built by hand have no arena and
+         *      their nodes are normal shared nodes.
+         */
+        Ref<AstArena> m_arenaOwner;
+        AstArena *m_arena = NTT_NULL;
+
         String m_content;
         Vector<Ref<Node>> m_children;
+
+        /**
+         * Only set for the blocks which are created from the text content, it keeps the
+         *      text alive for the tokens (of all descendant atomics) which view into it.
+         */
+        Ref<SourceFile> m_source;
+
+        const Atomic *m_firstAtomic = NTT_NULL;
+        const Atomic *m_lastAtomic = NTT_NULL;
     };
 } // namespace ntt
@@ -8,6 +8,8 @@ namespace ntt
         REDUNDANT_DELIMITER,
 
         MISSING_VARIABLE_NAME,
+        MISSING_DEFAULT_VALUE,
+        INVALID_DEFAULT_VALUE,
 
         MISSING_CONDITION,
         MISSING_BLOCK,
@@ -18,6 +20,8 @@ namespace ntt
         MISSING_LEFT_OPERAND,
         MISSING_RIGHT_OPERAND,
 
+        NUMBER_OUT_OF_RANGE,
+
         NO_ERROR,
         COUNT,
     };
@@ -0,0 +1,89 @@
+#pragma once
+#include "pch.h"
+#include "node.h"
+#include "tokenizer/token_buffer.h"
+
+namespace ntt
+{
+    /**
+     * Compact copy of a node tree stored as parallel arrays. The nodes are kept in
+     *      post-order (every child comes before its parent, the root is the last node),
+     *      so a whole tree pass is a single forward scan over contiguous memory.
+     *
+     * The children of a node are in the same order as in the pointer tree:
+     *      - blocks: their children.
+     *      - OPERATION: operator, left operand, right operand.
+     *      - UNARY_OPERATION: operator, operand.
+     *      - IF_STATEMENT: condition, block, else block.
+     *      - FUNCTION_CALL: function, arguments...
+     *      - VARIABLE_DEFINITION_STATEMENT: define type, name, type and the default value
+     *          when there is one.
+     */
+    class FlatAst
+    {
+    public:
+        static constexpr u32 NO_INDEX = 0xFFFFFFFF;
+
+        FlatAst(const Node &root);
+        ~FlatAst();
+
+        inline u32 GetNodeCount() const { return u32(m_kinds.size()); }
+        inline u32 GetRoot() const { return GetNodeCount() - 1; }
+
+        inline NodeType GetKind(u32 node) const { return m_kinds[node]; }
+
+        inline u32 GetChildCount(u32 node) const { return m_childCounts[node]; }
+        inline u32 GetChild(u32 node, u32 childIndex) const
+        {
+            return m_childIndices[m_childStarts[node] + childIndex];
+        }
+
+        /**
+         * Only valid for the ATOMIC nodes.
+         */
+        inline Token GetToken(u32 node) const { return m_tokens.GetToken(m_payloads[node]); }
+
+        inline u32 GetErrorCount(u32 node) const { return m_errorCounts[node]; }
+        inline ErrorType GetError(u32 node, u32 errorIndex) const
+        {
+            return m_errors[m_errorStarts[node] + errorIndex];
+        }
+
+        /**
+         * @return The nodes which carry at least one error, in post-order.
+         */
+        Vector<u32> CollectNodesWithErrors() const;
+
+        /**
+         * Same output as `ToJSON` of the node tree which was flattened.
+         */
+        JSON ToJSON() const;
+
+    private:
+        u32 AddNode(const Node &node, u32 numberOfChildren, Vector<u32> &pendingNodes);
+
+    private:
+        Vector<NodeType> m_kinds;
+
+        /**
+         * Index into `m_tokens` for the ATOMIC nodes, into `m_invalidContents` for the
+         *      INVALID nodes, `NO_INDEX` for the others.
+         */
+        Vector<u32> m_payloads;
+
+        Vector<u32> m_childStarts;
+        Vector<u32> m_childCounts;
+        Vector<u32> m_childIndices;
+
+        Vector<u32> m_errorStarts;
+        Vector<u32> m_errorCounts;
+        Vector<ErrorType> m_errors;
+
+        /**
+         * Keeps the source file of the root when it is a block created from text content,
+         *      the texts of the other tokens are copied into the buffer.
+         */
+        TokenBuffer m_tokens;
+        Vector<String> m_invalidContents;
+    };
+} // namespace ntt
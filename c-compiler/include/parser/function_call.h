@@ -12,13 +12,17 @@ namespace ntt
 
         inline NodeType GetType() const override { return NodeType::FUNCTION_CALL; }
 
+        static inline b8 IsTypeOf(NodeType type) { return type == NodeType::FUNCTION_CALL; }
+
         JSON ToJSON() override;
         void Compress() override;
         void Parse() override;
+        void Accept(NodeVisitor &visitor) override;
 
     public:
         const Ref<Node> &GetFunction() const { return m_function; }
         const Vector<Ref<Node>> &GetArguments() const { return m_arguments; }
+        Vector<Ref<Node>> &GetArguments() { return m_arguments; }
 
     private:
         Ref<Node> m_function;
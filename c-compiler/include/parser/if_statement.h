@@ -12,9 +12,12 @@ namespace ntt
 
         inline NodeType GetType() const override { return NodeType::IF_STATEMENT; }
 
+        static inline b8 IsTypeOf(NodeType type) { return type == NodeType::IF_STATEMENT; }
+
         JSON ToJSON() override;
         void Compress() override;
         void Parse() override;
+        void Accept(NodeVisitor &visitor) override;
 
     public:
         inline const Ref<Node> &GetCondition() const { return m_conditionNode; }
@@ -0,0 +1,99 @@
+#pragma once
+#include "pch.h"
+#include "blockNode.h"
+#include "atomic.h"
+#include "tokenizer/tokenizer.h"
+
+namespace ntt
+{
+    /**
+     * Keeps the parsed program of a text which is edited many times. After an edit only
+     *      the smallest `{}` block or statement which contains it is parsed again (in
+     *      place, so the node keeps its identity), all the other nodes of the tree are
+     *      kept as they are. When the edit can change the structure around it (a bracket
+     *      or a semicolon is edited, an `if` appears, ...) the enclosing block is tried,
+     *      up to the whole program.
+     *
+     * The result is always the same tree as the one of a `BlockNode` created from the
+     *      edited text, compressed then parsed.
+     */
+    class IncrementalParser
+    {
+    public:
+        IncrementalParser(const String &content);
+        ~IncrementalParser();
+
+        /**
+         * Replaces `removedLength` characters at `offset` with `insertedText` and updates the
+         *      tree.
+         */
+        void ApplyEdit(u32 offset, u32 removedLength, const String &insertedText);
+
+        inline const Ref<BlockNode> &GetProgram() const { return m_program; }
+        inline const Ref<SourceFile> &GetSource() const { return m_tokenizer.GetSource(); }
+
+        /**
+         * @return The block or statement which was parsed again by the last edit, the
+         *      program itself when everything was parsed again.
+         */
+        inline const BlockNode *GetLastReparsedNode() const { return m_lastReparsedNode; }
+
+    private:
+        /**
+         * A block or statement which contains the edit, with the indices of its first and
+         *      last tokens before the edit.
+         *
+         * Parsing a node a second time can still change it, the full parse parses some
+         *      nodes once and the others many times (the result is the same from the second
+         *      time), the reparsed node must be parsed the same way.
+         */
+        struct ReparseCandidate
+        {
+            BlockNode *block;
+            u32 firstToken;
+            u32 lastToken;
+            b8 isParsedOnce;
+        };
+
+        void ParseAll();
+
+        void CollectCandidates(BlockNode *block, b8 isParsedOnce, u32 editStart, u32 editEnd,
+                               Vector<ReparseCandidate> &outCandidates) const;
+
+        /**
+         * Adds `node` (and the blocks inside it) when it is a block and the edit is strictly
+         *      between its braces, the blocks of an if statement are looked into.
+         */
+        void CollectBlockCandidates(const Ref<Node> &node, b8 isParsedOnce, u32 editStart, u32 editEnd,
+                                    Vector<ReparseCandidate> &outCandidates) const;
+
+        /**
+         * @return The index of `atomic` in `m_atomics`, found from the start of its token.
+         */
+        u32 FindAtomicIndex(const Atomic *atomic) const;
+
+        /**
+         * @param lastToken The index of the last token of the candidate after the edit.
+         */
+        b8 ReparseBlock(const ReparseCandidate &candidate, u32 lastToken);
+        b8 ReparseStatement(const ReparseCandidate &candidate, u32 lastToken);
+
+    private:
+        Tokenizer m_tokenizer;
+        Ref<BlockNode> m_program;
+
+        /**
+         * One atomic per token (also the brackets and semicolons which are not in the
+         *      tree), allocated from the arena of the program.
+         */
+        Vector<Ref<Atomic>> m_atomics;
+
+        /**
+         * Number of objects in the arena right after the last full parse, the replaced
+         *      nodes stay in the arena so everything is parsed again once it doubled.
+         */
+        u32 m_numberOfParsedObjects = 0;
+
+        const BlockNode *m_lastReparsedNode = NTT_NULL;
+    };
+} // namespace ntt
@@ -12,10 +12,16 @@ namespace ntt
 
         inline NodeType GetType() const override { return NodeType::INVALID; }
 
+        static inline b8 IsTypeOf(NodeType type) { return type == NodeType::INVALID; }
+
         JSON ToJSON() override;
 
         void Compress() override;
         void Parse() override;
+        void Accept(NodeVisitor &visitor) override;
+
+    public:
+        inline const String &GetContent() const { return m_content; }
 
     private:
         String m_content;
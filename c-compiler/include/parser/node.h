@@ -2,6 +2,7 @@
 #include "pch.h"
 #include "nodeType.h"
 #include "error.h"
+#include "node_visitor.h"
 
 namespace ntt
 {
@@ -36,6 +37,11 @@ namespace ntt
          */
         virtual void Parse() = 0;
 
+        /**
+         * Calls the `Visit` overload of the visitor which matches the concrete class.
+         */
+        virtual void Accept(NodeVisitor &visitor) = 0;
+
         const Vector<ErrorType> &GetErrors() const { return m_errors; }
         void AddError(ErrorType error);
         void ClearErrors() { m_errors.clear(); }
@@ -46,4 +52,28 @@ namespace ntt
     private:
         Vector<ErrorType> m_errors;
     };
+
+    /**
+     * Checked downcast which does not need RTTI, every node class tells the node types
+     *      it stands for through its static `IsTypeOf`.
+     *
+     * @return The node as `T` or null when the node is not a `T`.
+     */
+    template <typename T>
+    inline T *NodeCast(Node *node)
+    {
+        return node != NTT_NULL && T::IsTypeOf(node->GetType()) ? static_cast<T *>(node) : NTT_NULL;
+    }
+
+    template <typename T>
+    inline const T *NodeCast(const Node *node)
+    {
+        return node != NTT_NULL && T::IsTypeOf(node->GetType()) ? static_cast<const T *>(node) : NTT_NULL;
+    }
+
+    template <typename T>
+    inline Ref<T> NodeCast(const Ref<Node> &node)
+    {
+        return node != NTT_NULL && T::IsTypeOf(node->GetType()) ? std::static_pointer_cast<T>(node) : NTT_NULL;
+    }
 } // namespace ntt
@@ -0,0 +1,34 @@
+#pragma once
+#include "pch.h"
+
+namespace ntt
+{
+    class Atomic;
+    class BlockNode;
+    class InvalidNode;
+    class OperationNode;
+    class UnaryOperationNode;
+    class IfStatementNode;
+    class FunctionCallNode;
+    class VariableDefinitionNode;
+
+    /**
+     * Double dispatch over the concrete node classes, `Node::Accept` calls the overload
+     *      which matches the node. A pass only overrides the overloads it cares about,
+     *      the others do nothing.
+     */
+    class NodeVisitor
+    {
+    public:
+        virtual ~NodeVisitor() = default;
+
+        virtual void Visit(Atomic &node) { NTT_UNUSED(node); }
+        virtual void Visit(BlockNode &node) { NTT_UNUSED(node); }
+        virtual void Visit(InvalidNode &node) { NTT_UNUSED(node); }
+        virtual void Visit(OperationNode &node) { NTT_UNUSED(node); }
+        virtual void Visit(UnaryOperationNode &node) { NTT_UNUSED(node); }
+        virtual void Visit(IfStatementNode &node) { NTT_UNUSED(node); }
+        virtual void Visit(FunctionCallNode &node) { NTT_UNUSED(node); }
+        virtual void Visit(VariableDefinitionNode &node) { NTT_UNUSED(node); }
+    };
+} // namespace ntt
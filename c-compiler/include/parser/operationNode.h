@@ -13,16 +13,22 @@ namespace ntt
         ~OperationNode() override;
 
         inline NodeType GetType() const override { return NodeType::OPERATION; }
+        static inline b8 IsTypeOf(NodeType type) { return type == NodeType::OPERATION; }
+
         JSON ToJSON() override;
 
         void Compress() override;
         void Parse() override;
+        void Accept(NodeVisitor &visitor) override;
 
     public:
         inline const Ref<Node> &GetOperator() const { return m_operatorNode; }
         inline const Ref<Node> &GetLeftOperand() const { return m_leftOperand; }
         inline const Ref<Node> &GetRightOperand() const { return m_rightOperand; }
 
+        inline Ref<Node> &GetLeftOperand() { return m_leftOperand; }
+        inline Ref<Node> &GetRightOperand() { return m_rightOperand; }
+
     private:
         Ref<Node> m_operatorNode;
         Ref<Node> m_leftOperand;
@@ -1,4 +1,5 @@
 #include "node.h"
 #include "atomic.h"
 #include "blockNode.h"
-#include "unaryOperationNode.h"
\ No newline at end of file
+#include "unaryOperationNode.h"
+#include "incremental_parser.h"
\ No newline at end of file
@@ -12,14 +12,19 @@ namespace ntt
 
         inline NodeType GetType() const override { return NodeType::UNARY_OPERATION; }
 
+        static inline b8 IsTypeOf(NodeType type) { return type == NodeType::UNARY_OPERATION; }
+
         JSON ToJSON() override;
         void Compress() override;
         void Parse() override;
+        void Accept(NodeVisitor &visitor) override;
 
     public:
         inline const Ref<Node> &GetOperand() const { return m_operand; }
         inline const Ref<Node> &GetOperator() const { return m_operator; }
 
+        inline Ref<Node> &GetOperand() { return m_operand; }
+
     private:
         Ref<Node> m_operand;
         Ref<Node> m_operator;
@@ -11,15 +11,19 @@ namespace ntt
         ~VariableDefinitionNode() override;
 
         NodeType GetType() const override { return NodeType::VARIABLE_DEFINITION_STATEMENT; }
+        static inline b8 IsTypeOf(NodeType type) { return type == NodeType::VARIABLE_DEFINITION_STATEMENT; }
+
         JSON ToJSON() override;
         void Compress() override;
         void Parse() override;
+        void Accept(NodeVisitor &visitor) override;
 
     public:
         inline Ref<Node> GetDefineType() const { return m_defineType; }
         inline Ref<Node> GetName() const { return m_name; }
         inline Ref<Node> GetTypeNode() const { return m_type; }
         inline Ref<Node> GetDefaultValue() const { return m_defaultValue; }
+        inline Ref<Node> &GetDefaultValue() { return m_defaultValue; }
 
     private:
         Ref<Node> m_defineType;
@@ -0,0 +1,288 @@
+#pragma once
+#include "pch.h"
+#include "tokenType.h"
+#include "symbol_table.h"
+#include <array>
+#include <string_view>
+
+namespace ntt
+{
+    /**
+     * A reserved word, `true` and `false` are here too since they are lexed as
+     *      identifiers before being turned into booleans.
+     */
+    struct KeywordEntry
+    {
+        std::string_view text;
+        TokenType type;
+        Symbol symbol;
+        b8 boolValue;
+    };
+
+    /**
+     * @return The entry of a keyword, its text is the spelling of its symbol.
+     */
+    constexpr KeywordEntry MakeKeywordEntry(Symbol symbol)
+    {
+        return {fixedSymbolTexts[u32(symbol)], TokenType::KEYWORD, symbol, NTT_FALSE};
+    }
+
+    constexpr KeywordEntry keywordEntries[] = {
+        // types
+        MakeKeywordEntry(Symbol::NUMBER),
+        MakeKeywordEntry(Symbol::STRING),
+        MakeKeywordEntry(Symbol::BOOLEAN),
+        MakeKeywordEntry(Symbol::NULL_VALUE),
+        MakeKeywordEntry(Symbol::ANY),
+
+        // control flow
+        MakeKeywordEntry(Symbol::IF),
+        MakeKeywordEntry(Symbol::ELSE),
+        MakeKeywordEntry(Symbol::WHILE),
+        MakeKeywordEntry(Symbol::FOR),
+
+        // declaration
+        MakeKeywordEntry(Symbol::CONST),
+        MakeKeywordEntry(Symbol::LET),
+        MakeKeywordEntry(Symbol::FUNCTION),
+        MakeKeywordEntry(Symbol::CLASS),
+
+        // literals
+        {"true", TokenType::BOOLEAN, Symbol::NONE, NTT_TRUE},
+        {"false", TokenType::BOOLEAN, Symbol::NONE, NTT_FALSE},
+    };
+
+    constexpr u32 KEYWORD_SLOT_COUNT = 32;
+    constexpr u8 EMPTY_KEYWORD_SLOT = 0xFF;
+
+    /**
+     * Perfect hash of the keyword entries, the constants are chosen so that no two
+     *      entries share a slot (checked below at compile time).
+     */
+    constexpr u32 HashKeyword(std::string_view text)
+    {
+        return (u32(u8(text[0])) * 2 + u32(u8(text[text.length() - 1])) * 9 + u32(text.length())) &
+               (KEYWORD_SLOT_COUNT - 1);
+    }
+
+    constexpr std::array<u8, KEYWORD_SLOT_COUNT> BuildKeywordSlots()
+    {
+        std::array<u8, KEYWORD_SLOT_COUNT> slots{};
+        for (u32 slotIndex = 0; slotIndex < KEYWORD_SLOT_COUNT; slotIndex++)
+        {
+            slots[slotIndex] = EMPTY_KEYWORD_SLOT;
+        }
+
+        for (u32 entryIndex = 0; entryIndex < u32(std::size(keywordEntries)); entryIndex++)
+        {
+            slots[HashKeyword(keywordEntries[entryIndex].text)] = u8(entryIndex);
+        }
+
+        return slots;
+    }
+
+    constexpr std::array<u8, KEYWORD_SLOT_COUNT> keywordSlots = BuildKeywordSlots();
+
+    constexpr b8 IsKeywordHashPerfect()
+    {
+        for (u32 entryIndex = 0; entryIndex < u32(std::size(keywordEntries)); entryIndex++)
+        {
+            if (keywordSlots[HashKeyword(keywordEntries[entryIndex].text)] != entryIndex)
+            {
+                return NTT_FALSE;
+            }
+        }
+
+        return NTT_TRUE;
+    }
+
+    static_assert(IsKeywordHashPerfect(), "Two keywords share the same hash slot.");
+
+    /**
+     * @return The keyword entry of the text or `NTT_NULL` if the text is a plain identifier.
+     */
+    constexpr const KeywordEntry *FindKeyword(std::string_view text)
+    {
+        if (text.empty())
+        {
+            return NTT_NULL;
+        }
+
+        u8 entryIndex = keywordSlots[HashKeyword(text)];
+        if (entryIndex == EMPTY_KEYWORD_SLOT || keywordEntries[entryIndex].text != text)
+        {
+            return NTT_NULL;
+        }
+
+        return &keywordEntries[entryIndex];
+    }
+
+    /**
+     * Longest match of the operator table at the start of the input. It gives the same
+     *      result as the operator patterns of the tokenizer: the `<op>=` forms first, then
+     *      the doubled forms, where `+` is special since any run of it is a single token.
+     *
+     * @param input Pointer to the first character.
+     * @param length Number of characters which are available from `input`.
+     * @param outSymbol The fixed symbol of the operator, `Symbol::NONE` for the runs of
+     *      three or more `+` which have no fixed id.
+     * @return The length of the operator, 0 if the input does not start with one.
+     */
+    constexpr u32 MatchOperator(const char *input, u32 length, Symbol &outSymbol)
+    {
+        if (length == 0)
+        {
+            return 0;
+        }
+
+        char next = length > 1 ? input[1] : '\0';
+
+        switch (input[0])
+        {
+        case '+':
+        {
+            if (next == '=')
+            {
+                outSymbol = Symbol::PLUS_ASSIGN;
+                return 2;
+            }
+
+            u32 runLength = 1;
+            while (runLength < length && input[runLength] == '+')
+            {
+                runLength++;
+            }
+
+            outSymbol = runLength == 1   ? Symbol::PLUS
+                        : runLength == 2 ? Symbol::INCREMENT
+                                         : Symbol::NONE;
+            return runLength;
+        }
+        case '-':
+            outSymbol = next == '='   ? Symbol::MINUS_ASSIGN
+                        : next == '-' ? Symbol::DECREMENT
+                                      : Symbol::MINUS;
+            return outSymbol == Symbol::MINUS ? 1 : 2;
+        case '&':
+            outSymbol = next == '='   ? Symbol::AND_ASSIGN
+                        : next == '&' ? Symbol::LOGICAL_AND
+                                      : Symbol::AMPERSAND;
+            return outSymbol == Symbol::AMPERSAND ? 1 : 2;
+        case '|':
+            outSymbol = next == '='   ? Symbol::OR_ASSIGN
+                        : next == '|' ? Symbol::LOGICAL_OR
+                                      : Symbol::PIPE;
+            return outSymbol == Symbol::PIPE ? 1 : 2;
+        case '*':
+            outSymbol = next == '=' ? Symbol::MULTIPLY_ASSIGN : Symbol::MULTIPLY;
+            return next == '=' ? 2 : 1;
+        case '/':
+            outSymbol = next == '=' ? Symbol::DIVIDE_ASSIGN : Symbol::DIVIDE;
+            return next == '=' ? 2 : 1;
+        case '%':
+            outSymbol = next == '=' ? Symbol::MODULO_ASSIGN : Symbol::MODULO;
+            return next == '=' ? 2 : 1;
+        case '^':
+            outSymbol = next == '=' ? Symbol::XOR_ASSIGN : Symbol::CARET;
+            return next == '=' ? 2 : 1;
+        case '@':
+            outSymbol = next == '=' ? Symbol::AT_ASSIGN : Symbol::AT;
+            return next == '=' ? 2 : 1;
+        case '=':
+            outSymbol = next == '=' ? Symbol::EQUAL : Symbol::ASSIGN;
+            return next == '=' ? 2 : 1;
+        case '!':
+            outSymbol = next == '=' ? Symbol::NOT_EQUAL : Symbol::NOT;
+            return next == '=' ? 2 : 1;
+        case '>':
+            outSymbol = next == '=' ? Symbol::GREATER_EQUAL : Symbol::GREATER;
+            return next == '=' ? 2 : 1;
+        case '<':
+            outSymbol = next == '=' ? Symbol::LESS_EQUAL : Symbol::LESS;
+            return next == '=' ? 2 : 1;
+        default:
+            return 0;
+        }
+    }
+
+    /**
+     * @return The token type of the single character brackets, delimiters and type hint
+     *      with its symbol, `TokenType::NONE` for any other character.
+     */
+    constexpr TokenType MatchPunctuation(char character, Symbol &outSymbol)
+    {
+        switch (character)
+        {
+        case '(':
+            outSymbol = Symbol::OPEN_PARENTHESIS;
+            return TokenType::BRACKET;
+        case ')':
+            outSymbol = Symbol::CLOSE_PARENTHESIS;
+            return TokenType::BRACKET;
+        case '{':
+            outSymbol = Symbol::OPEN_BRACE;
+            return TokenType::BRACKET;
+        case '}':
+            outSymbol = Symbol::CLOSE_BRACE;
+            return TokenType::BRACKET;
+        case '[':
+            outSymbol = Symbol::OPEN_SQUARE_BRACKET;
+            return TokenType::BRACKET;
+        case ']':
+            outSymbol = Symbol::CLOSE_SQUARE_BRACKET;
+            return TokenType::BRACKET;
+        case ';':
+            outSymbol = Symbol::SEMICOLON;
+            return TokenType::DELIMITER;
+        case ',':
+            outSymbol = Symbol::COMMA;
+            return TokenType::DELIMITER;
+        case ':':
+            outSymbol = Symbol::COLON;
+            return TokenType::TYPE_HINT;
+        default:
+            return TokenType::NONE;
+        }
+    }
+
+    /**
+     * @return Whether every keyword has its entry and every other fixed symbol is matched
+     *      from its spelling by `MatchOperator` or `MatchPunctuation`, so these tables
+     *      cannot drift from `fixedSymbolTexts`.
+     */
+    constexpr b8 DoLexemeTablesMatchSymbols()
+    {
+        for (u32 symbolIndex = u32(Symbol::NONE) + 1; symbolIndex < u32(Symbol::COUNT); symbolIndex++)
+        {
+            Symbol symbol = Symbol(symbolIndex);
+            std::string_view text = fixedSymbolTexts[symbolIndex];
+            Symbol matchedSymbol = Symbol::NONE;
+
+            if (SymbolTable::IsKeyword(symbol))
+            {
+                const KeywordEntry *keyword = FindKeyword(text);
+                matchedSymbol = keyword != NTT_NULL ? keyword->symbol : Symbol::NONE;
+            }
+            else if (symbol < Symbol::OPEN_PARENTHESIS)
+            {
+                if (MatchOperator(text.data(), u32(text.length()), matchedSymbol) != text.length())
+                {
+                    return NTT_FALSE;
+                }
+            }
+            else if (text.length() != 1 || MatchPunctuation(text[0], matchedSymbol) == TokenType::NONE)
+            {
+                return NTT_FALSE;
+            }
+
+            if (matchedSymbol != symbol)
+            {
+                return NTT_FALSE;
+            }
+        }
+
+        return NTT_TRUE;
+    }
+
+    static_assert(DoLexemeTablesMatchSymbols(), "The lexeme tables disagree with the symbol spellings.");
+} // namespace ntt
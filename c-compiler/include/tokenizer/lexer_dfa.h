@@ -0,0 +1,78 @@
+#pragma once
+#include "pch.h"
+#include "tokenType.h"
+
+namespace ntt
+{
+    /**
+     * A single entry of the lexer specification: the regex which describes the
+     *      lexeme and the token type produced when this entry wins.
+     */
+    struct LexerRule
+    {
+        TokenType type;
+
+        /**
+         * ECMAScript style pattern. Only the subset used by the tokenizer is supported:
+         *      literals, escapes, `.`, bracket classes (with ranges and negation), groups
+         *      (capturing or `(?:...)`), alternation and the `*`, `+`, `?` quantifiers.
+         *      A leading `^` is accepted and ignored since every rule is anchored.
+         */
+        String pattern;
+    };
+
+    /**
+     * Table driven automaton compiled once from an ordered list of lexer rules.
+     *
+     * The matching semantic is the one the tokenizer had with `std::regex`: at a given
+     *      position the first rule (in declaration order) which matches wins and it
+     *      consumes its longest match. All rules are run simultaneously in a single
+     *      forward scan, so no backtracking is needed.
+     */
+    class LexerDfa
+    {
+    public:
+        LexerDfa(const Vector<LexerRule> &rules);
+        ~LexerDfa();
+
+        /**
+         * Runs the automaton from the first character of the input.
+         *
+         * @param input Pointer to the first character which should be matched.
+         * @param length Number of characters which are available from `input`.
+         * @param outRuleIndex The index (in the constructor list) of the winning rule.
+         * @param outLength The number of characters consumed by the winning rule.
+         * @return Whether any rule matches at this position.
+         */
+        b8 Match(const char *input, u32 length, u32 &outRuleIndex, u32 &outLength) const;
+
+        /**
+         * @return The token type of the rule at the given index.
+         */
+        inline TokenType GetRuleType(u32 ruleIndex) const { return m_ruleTypes[ruleIndex]; }
+
+        inline u32 GetStateCount() const { return m_stateCount; }
+        inline u32 GetClassCount() const { return m_classCount; }
+
+    private:
+        /**
+         * Each input byte is mapped into an equivalence class, all bytes in the same
+         *      class have the same transitions in every state.
+         */
+        u8 m_byteClasses[256];
+        u32 m_classCount = 0;
+        u32 m_stateCount = 0;
+
+        /**
+         * `m_transitions[state * m_classCount + class]` is the next state. The state
+         *      0 is the dead state and the state 1 is the start state.
+         */
+        Vector<u16> m_transitions;
+
+        /**
+         * The lowest rule index accepted in each state (or `NO_RULE`).
+         */
+        Vector<u32> m_acceptedRules;
+        Vector<TokenType> m_ruleTypes;
+    };
+} // namespace ntt
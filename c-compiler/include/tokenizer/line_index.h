@@ -0,0 +1,52 @@
+#pragma once
+#include "pch.h"
+#include <string_view>
+
+namespace ntt
+{
+    /**
+     * Line and column of a character, both start from 1 and the column counts bytes.
+     */
+    struct SourceLocation
+    {
+        u32 line;
+        u32 column;
+    };
+
+    /**
+     * Offsets of the first character of every line of a text, so an offset is turned into
+     *      its line and column with a binary search instead of scanning the text again.
+     */
+    class LineIndex
+    {
+    public:
+        LineIndex();
+        LineIndex(const char *text, u32 length);
+        ~LineIndex();
+
+        inline u32 GetLineCount() const { return u32(m_lineStarts.size()); }
+
+        /**
+         * @param line The line, starting from 1.
+         * @return The offset of the first character of the line.
+         */
+        inline u32 GetLineStart(u32 line) const { return m_lineStarts[line - 1]; }
+
+        SourceLocation GetLocation(u32 offset) const;
+
+        /**
+         * Updates the index after `removedLength` characters at `offset` were replaced with
+         *      `insertedText`, only the lines after the edit are moved.
+         */
+        void ApplyEdit(u32 offset, u32 removedLength, std::string_view insertedText);
+
+    private:
+        /**
+         * Adds the start of the line after every new line of `text`, which is at `offset`.
+         */
+        static void FindLineStarts(const char *text, u32 length, u32 offset, Vector<u32> &outLineStarts);
+
+    private:
+        Vector<u32> m_lineStarts;
+    };
+} // namespace ntt
@@ -0,0 +1,46 @@
+#pragma once
+#include "pch.h"
+
+namespace ntt
+{
+    /**
+     * The instruction sets the scanning kernels can use, the best one supported by the
+     *      processor is picked the first time a kernel is called.
+     */
+    enum class ScanKernelLevel
+    {
+        SCALAR,
+        SSE2,
+        AVX2,
+    };
+
+    /**
+     * @return The number of spaces and new lines at the start of `text`.
+     */
+    u32 CountLeadingSpaces(const char *text, u32 length);
+
+    /**
+     * @return The number of `[A-Za-z0-9_]` characters at the start of `text`.
+     */
+    u32 CountLeadingIdentifierCharacters(const char *text, u32 length);
+
+    /**
+     * @return The number of `[0-9]` characters at the start of `text`.
+     */
+    u32 CountLeadingDigits(const char *text, u32 length);
+
+    /**
+     * @return The index of the first new line of `text`, `length` when there is none.
+     */
+    u32 FindNewLine(const char *text, u32 length);
+
+    ScanKernelLevel GetScanKernelLevel();
+
+    /**
+     * Forces the kernels to use `level` (at most the one the processor supports), used to
+     *      compare the implementations.
+     *
+     * @return The level which is actually used.
+     */
+    ScanKernelLevel SetScanKernelLevel(ScanKernelLevel level);
+} // namespace ntt
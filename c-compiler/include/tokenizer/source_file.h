@@ -0,0 +1,63 @@
+#pragma once
+#include "pch.h"
+#include <string_view>
+
+namespace ntt
+{
+    /**
+     * Owns the text of one compilation input. Tokens produced from it do not copy their
+     *      lexemes, they keep views into this buffer instead, so the source file must be
+     *      kept alive (it is shared through `Ref`) as long as those tokens are used.
+     *
+     * The text is either a string owned by the source file, a read only mapping of a file
+     *      or characters owned by the caller. The new lines are kept as they are in all
+     *      cases, the tokenizer skips them like spaces.
+     */
+    class SourceFile
+    {
+    public:
+        SourceFile(const String &content);
+        SourceFile(String &&content);
+
+        /**
+         * Views the `length` characters at `data` without copying them, the caller must keep
+         *      them alive as long as the source file.
+         */
+        SourceFile(const char *data, u32 length);
+
+        SourceFile(const SourceFile &) = delete;
+        SourceFile &operator=(const SourceFile &) = delete;
+        ~SourceFile();
+
+        /**
+         * Maps the file at `path` read only, its content is never copied.
+         *
+         * @return The source file or null when the file can not be opened or mapped.
+         */
+        static Ref<SourceFile> MapFile(const String &path);
+
+        inline const char *GetData() const { return m_data; }
+        inline u32 GetLength() const { return m_length; }
+
+        /**
+         * @return The view of the characters in `[startIndex, startIndex + length)`.
+         */
+        inline std::string_view GetView(u32 startIndex, u32 length) const
+        {
+            return std::string_view(m_data + startIndex, length);
+        }
+
+    private:
+        SourceFile();
+
+    private:
+        String m_content;
+        const char *m_data = "";
+        u32 m_length = 0;
+
+        /**
+         * Only set for the mapped files, the mapping is released with the source file.
+         */
+        void *m_mapping = NTT_NULL;
+    };
+} // namespace ntt
@@ -0,0 +1,229 @@
+#pragma once
+#include "pch.h"
+#include <deque>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace ntt
+{
+    /**
+     * Interned text of the name-like tokens (keywords, identifiers, operators, brackets,
+     *      delimiters and type hints). All the spellings which the language reserves have
+     *      an id known at compile time, every other text gets an id starting from `COUNT`
+     *      the first time it is interned.
+     */
+    enum class Symbol : u32
+    {
+        NONE,
+
+        // keywords - types
+        NUMBER,
+        STRING,
+        BOOLEAN,
+        NULL_VALUE,
+        ANY,
+
+        // keywords - control flow
+        IF,
+        ELSE,
+        WHILE,
+        FOR,
+
+        // keywords - declaration
+        CONST,
+        LET,
+        FUNCTION,
+        CLASS,
+
+        // operators
+        PLUS_ASSIGN,
+        MINUS_ASSIGN,
+        MULTIPLY_ASSIGN,
+        DIVIDE_ASSIGN,
+        MODULO_ASSIGN,
+        AND_ASSIGN,
+        OR_ASSIGN,
+        XOR_ASSIGN,
+        AT_ASSIGN,
+
+        EQUAL,
+        NOT_EQUAL,
+        GREATER_EQUAL,
+        LESS_EQUAL,
+        GREATER,
+        LESS,
+
+        LOGICAL_AND,
+        LOGICAL_OR,
+
+        INCREMENT,
+        DECREMENT,
+
+        PLUS,
+        MINUS,
+        MULTIPLY,
+        DIVIDE,
+        MODULO,
+        CARET,
+        AT,
+        NOT,
+        PIPE,
+        AMPERSAND,
+
+        ASSIGN,
+
+        // brackets
+        OPEN_PARENTHESIS,
+        CLOSE_PARENTHESIS,
+        OPEN_BRACE,
+        CLOSE_BRACE,
+        OPEN_SQUARE_BRACKET,
+        CLOSE_SQUARE_BRACKET,
+
+        // delimiters
+        SEMICOLON,
+        COMMA,
+
+        // type hint
+        COLON,
+
+        COUNT,
+    };
+
+    /**
+     * Spelling of every fixed symbol, in the same order as the `Symbol` enum. The keyword
+     *      entries, the operator and punctuation matchers (see `lexeme_tables.h`) and the
+     *      lexer rules of the operators and punctuation are built from it or checked
+     *      against it.
+     */
+    constexpr std::string_view fixedSymbolTexts[] = {
+        "",
+
+        "number",
+        "string",
+        "boolean",
+        "null",
+        "any",
+
+        "if",
+        "else",
+        "while",
+        "for",
+
+        "const",
+        "let",
+        "function",
+        "class",
+
+        "+=",
+        "-=",
+        "*=",
+        "/=",
+        "%=",
+        "&=",
+        "|=",
+        "^=",
+        "@=",
+
+        "==",
+        "!=",
+        ">=",
+        "<=",
+        ">",
+        "<",
+
+        "&&",
+        "||",
+
+        "++",
+        "--",
+
+        "+",
+        "-",
+        "*",
+        "/",
+        "%",
+        "^",
+        "@",
+        "!",
+        "|",
+        "&",
+
+        "=",
+
+        "(",
+        ")",
+        "{",
+        "}",
+        "[",
+        "]",
+
+        ";",
+        ",",
+
+        ":",
+    };
+
+    static_assert(sizeof(fixedSymbolTexts) / sizeof(fixedSymbolTexts[0]) == u32(Symbol::COUNT),
+                  "Every fixed symbol must have its spelling.");
+
+    /**
+     * The global interning table, the tokenizer is the one which fills it while lexing.
+     *
+     * All the methods may be called from several threads at once: the lookups share a
+     *      lock and only the interning of a new text takes it exclusively. The ids and the
+     *      texts returned stay valid for the lifetime of the process, the dynamic ids are
+     *      never released, so the table grows with the number of distinct names which are
+     *      ever lexed (every partial name typed in an editor session included).
+     */
+    class SymbolTable
+    {
+    public:
+        ~SymbolTable();
+
+        /**
+         * @return The process wide table.
+         */
+        static SymbolTable &Get();
+
+        /**
+         * Finds the id of the text, a new id is created if the text was never interned.
+         */
+        Symbol Intern(std::string_view text);
+
+        /**
+         * @return The id of the text or `Symbol::NONE` if it was never interned.
+         */
+        Symbol Find(std::string_view text) const;
+
+        /**
+         * @return The text which the id stands for.
+         */
+        std::string_view GetText(Symbol symbol) const;
+
+        u32 GetCount() const;
+
+        /**
+         * @return Whether the symbol is one of the reserved words of the language.
+         */
+        static constexpr b8 IsKeyword(Symbol symbol)
+        {
+            return symbol >= Symbol::NUMBER && symbol <= Symbol::CLASS;
+        }
+
+    private:
+        SymbolTable();
+
+    private:
+        mutable std::shared_mutex m_mutex;
+        std::unordered_map<std::string_view, Symbol> m_ids;
+        Vector<std::string_view> m_texts;
+
+        /**
+         * Storage of the dynamically interned texts, a deque never moves its elements so
+         *      the views in `m_ids` and `m_texts` stay valid.
+         */
+        std::deque<String> m_storage;
+    };
+} // namespace ntt
@@ -1,6 +1,10 @@
 #pragma once
 #include "tokenType.h"
+#include "symbol_table.h"
+#include "source_file.h"
+#include "line_index.h"
 #include "pch.h"
+#include <string_view>
 
 namespace ntt
 {
@@ -13,12 +17,28 @@ namespace ntt
         union Number
         {
             b8 boolValue;
-            u32 intValue;
-            f32 floatValue;
+            u64 intValue;
+            f64 floatValue;
         };
 
-        Number numberValue;
+        /**
+         * Also the cache of the value decoded from the literal of a lexed number, so it
+         *      can be written by the const getters.
+         */
+        mutable Number numberValue;
+
+        /**
+         * Owned text, used by the tokens which are created by hand (not lexed).
+         */
         std::string stringValue;
+
+        /**
+         * Borrowed text, used by the lexed tokens. It points into the `SourceFile` the
+         *      token comes from, so no allocation is needed per token. When it is set
+         *      `stringValue` is not used, and the number tokens decode their value from
+         *      it instead of `numberValue`.
+         */
+        std::string_view viewValue;
     };
 
     class Token
@@ -26,8 +46,12 @@ namespace ntt
     public:
         Token(TokenType type, u32 startIndex);
         Token(const Token &other);
+        Token(Token &&other) noexcept = default;
         ~Token();
 
+        Token &operator=(const Token &other) = default;
+        Token &operator=(Token &&other) noexcept = default;
+
         /**
          * @return The type of the token.
          */
@@ -41,15 +65,89 @@ namespace ntt
         template <typename T>
         void SetValue(T value);
 
+        /**
+         * Supported types are `u32`, `u64`, `f32`, `f64`, `b8`, `std::string` and
+         *      `std::string_view`. For string-like tokens `GetValue<std::string>` always
+         *      materializes a copy while `GetValue<std::string_view>` returns the text
+         *      without copying, the view is valid as long as the token (and its source
+         *      file) is alive.
+         *
+         * The lexed numbers are decoded from their text the first time they are read,
+         *      the value is then kept in the token (so the first read of a token must not
+         *      happen on several threads at once). An integer which does not fit the
+         *      requested type gives its largest value, see `IsValueOutOfRange`.
+         *      `GetValue<std::string_view>` gives their literal, empty for the numbers
+         *      created from a value.
+         */
         template <typename T>
         T GetValue() const;
 
-        JSON ToJSON() const;
+        /**
+         * @return Whether the text of this token is borrowed from a source file.
+         */
+        inline b8 IsView() const { return m_value.viewValue.data() != NTT_NULL; }
+
+        /**
+         * @return The interned id of the text for the keyword, identifier, operator, bracket,
+         *      delimiter, type hint and none tokens, `Symbol::NONE` for the others. It is
+         *      assigned whenever the text of such token is set.
+         */
+        inline Symbol GetSymbol() const { return m_symbol; }
+
+        /**
+         * Same as `SetValue<std::string_view>` but with the symbol which was already interned
+         *      by the caller, so the text is not looked up again.
+         */
+        void SetText(std::string_view text, Symbol symbol);
+
+        /**
+         * Sets the text of an integer or float token, its value is only decoded when it
+         *      is read.
+         */
+        void SetLiteral(std::string_view text);
+
+        /**
+         * @tparam T The type the value is read as, `u64`, `u32` or `f64`.
+         * @return Whether the value of this integer or float token is too large for `T`
+         *      (the literals too large for `u64` or `f64` whatever `T` is).
+         */
+        template <typename T = u64>
+        b8 IsValueOutOfRange() const;
+
+        /**
+         * Moves the token to `startIndex`, the borrowed text is pointed at the same position
+         *      of `source`, which must contain the same characters there.
+         */
+        void Rebase(u32 startIndex, const SourceFile &source);
+
+        /**
+         * @param lineIndex When given, the line and column of the start of the token are
+         *      added (see `Tokenizer::GetLineIndex`).
+         */
+        JSON ToJSON(const LineIndex *lineIndex = NTT_NULL) const;
 
     private:
+        void UpdateSymbol();
+
+        /**
+         * Decodes the literal of a lexed number into `m_value.numberValue` when it is not
+         *      decoded yet.
+         */
+        void DecodeLiteral() const;
+
+    private:
+        enum class DecodeState : u8
+        {
+            NOT_DECODED,
+            DECODED,
+            OUT_OF_RANGE,
+        };
+
         TokenType m_type;
         TokenValue m_value;
+        Symbol m_symbol;
         u32 m_startIndex;
         u32 m_length;
+        mutable DecodeState m_decodeState;
     };
 } // namespace ntt
@@ -0,0 +1,157 @@
+#pragma once
+#include "pch.h"
+#include "token.h"
+#include <string_view>
+
+namespace ntt
+{
+    /**
+     * 16 bytes form of a `Token`. The text is not stored in the token, it is either the
+     *      characters `[startIndex, startIndex + length)` of the source file of the buffer
+     *      (all the lexed tokens) or a span of the text arena of the buffer (the tokens
+     *      created by hand).
+     *
+     * The numbers keep their literal as text (their value is decoded when it is read),
+     *      only the numbers created by hand from a value have it in the value table.
+     *
+     * The payload depends on the type:
+     *      - BOOLEAN: 0 or 1.
+     *      - text in the source file: the symbol of the text.
+     *      - text in the arena: the index of its span.
+     *      - value in the table: the index of the value.
+     */
+    struct PackedToken
+    {
+        enum Flag : u8
+        {
+            TEXT_IN_SOURCE = 1 << 0,
+            TEXT_IN_ARENA = 1 << 1,
+            VALUE_IN_TABLE = 1 << 2,
+        };
+
+        u32 startIndex;
+        u32 length;
+        u32 payload;
+        u8 type;
+        u8 flags;
+
+        inline TokenType GetType() const { return TokenType(type); }
+        inline b8 HasFlag(Flag flag) const { return (flags & flag) != 0; }
+    };
+
+    static_assert(sizeof(PackedToken) == 16, "PackedToken must stay 16 bytes.");
+
+    /**
+     * Array of `PackedToken` with the texts which are not in the source file kept in a
+     *      single arena next to it. The tokens are only turned back into `Token` when they
+     *      are read with `GetToken`.
+     */
+    class TokenBuffer
+    {
+    public:
+        /**
+         * @param source The source file which the lexed texts are viewed from, the texts of
+         *      the tokens pushed later which do not view into it are copied to the arena.
+         */
+        TokenBuffer(const Ref<SourceFile> &source = NTT_NULL);
+        ~TokenBuffer();
+
+        inline u32 GetSize() const { return u32(m_tokens.size()); }
+        inline const PackedToken &operator[](u32 index) const { return m_tokens[index]; }
+        inline PackedToken &operator[](u32 index) { return m_tokens[index]; }
+
+        inline const Ref<SourceFile> &GetSource() const { return m_source; }
+
+        /**
+         * Points the tokens whose text is in the source file to `source`, it must contain
+         *      their texts at their start indices.
+         */
+        inline void SetSource(const Ref<SourceFile> &source) { m_source = source; }
+
+        inline void Reserve(u32 numberOfTokens) { m_tokens.reserve(numberOfTokens); }
+        inline void Push(const PackedToken &token) { m_tokens.push_back(token); }
+
+        /**
+         * Packs `token`, its text is copied to the arena when it is not the text of the
+         *      source file at the position of the token.
+         */
+        void Push(const Token &token);
+
+        /**
+         * Moves all the tokens of `other` (which has the same source file) at the end.
+         */
+        void Append(TokenBuffer &&other);
+
+        /**
+         * Replaces the `numberOfRemovedTokens` tokens at `firstToken` with the tokens of
+         *      `insertedTokens` (which has the same source file). The arena and the value
+         *      table are compacted once most of their entries belong to replaced tokens, so
+         *      repeated replacements do not grow them without bound.
+         */
+        void Replace(u32 firstToken, u32 numberOfRemovedTokens, const TokenBuffer &insertedTokens);
+
+        /**
+         * @return The text of the token at `index`, empty for the booleans and the numbers
+         *      created from a value.
+         */
+        std::string_view GetText(u32 index) const;
+
+        /**
+         * @return The symbol of the token at `index`, see `Token::GetSymbol`.
+         */
+        Symbol GetSymbol(u32 index) const;
+
+        /**
+         * @return The token at `index` unpacked, its text is a view into the source file or
+         *      the arena of this buffer.
+         */
+        Token GetToken(u32 index) const;
+
+        /**
+         * @return `token` unpacked, it must have no text or a text in `source` (like the
+         *      tokens returned by the lexer).
+         */
+        static Token Unpack(const PackedToken &token, const SourceFile &source);
+
+        /**
+         * @return All the tokens unpacked.
+         */
+        Vector<Token> GetTokens() const;
+
+        /**
+         * @return The number of bytes used by the tokens and the arena.
+         */
+        u64 GetMemoryUsage() const;
+
+    private:
+        /**
+         * Rebuilds the arena and the value table with only the entries of the current
+         *      tokens.
+         */
+        void Compact();
+
+    private:
+        struct TextSpan
+        {
+            u32 offset;
+            u32 length;
+            Symbol symbol;
+        };
+
+        Vector<PackedToken> m_tokens;
+        Vector<TextSpan> m_textSpans;
+        String m_textArena;
+
+        /**
+         * The `u64` or the bits of the `f64` of the numbers created by hand.
+         */
+        Vector<u64> m_numberValues;
+        Ref<SourceFile> m_source;
+
+        /**
+         * The spans and values which no token uses anymore, see `Replace`.
+         */
+        u32 m_numberOfUnusedSpans = 0;
+        u32 m_numberOfUnusedValues = 0;
+    };
+} // namespace ntt
@@ -0,0 +1,65 @@
+#pragma once
+#include "pch.h"
+#include "token_buffer.h"
+#include "source_file.h"
+#include <array>
+
+namespace ntt
+{
+    /**
+     * Lexes the tokens of a source file only when they are asked for, the tokens which
+     *      were read ahead by `Peek` wait in a small ring buffer, so the memory used does
+     *      not depend on the length of the input, apart from the distinct names which are
+     *      interned into the `SymbolTable`. The tokens are the same as the ones of
+     *      `Tokenizer`.
+     */
+    class TokenStream
+    {
+    public:
+        /**
+         * Number of tokens `Peek` can look ahead.
+         */
+        static constexpr u32 LOOKAHEAD_CAPACITY = 8;
+
+        TokenStream(const String &input);
+        TokenStream(const Ref<SourceFile> &source);
+        ~TokenStream();
+
+        /**
+         * @return Whether all the tokens were returned by `Next`.
+         */
+        b8 IsAtEnd();
+
+        /**
+         * @return The next token, which is consumed. After the last token it is an empty
+         *      NONE token at the end of the input.
+         */
+        Token Next();
+
+        /**
+         * @param distance The number of tokens skipped, `Peek(0)` is the token which `Next`
+         *      returns. It must be smaller than `LOOKAHEAD_CAPACITY`.
+         * @return The token without consuming it, see `Next`.
+         */
+        Token Peek(u32 distance = 0);
+
+        inline const Ref<SourceFile> &GetSource() const { return m_source; }
+
+    private:
+        /**
+         * Lexes tokens into the ring buffer until it holds at least `numberOfTokens` or the
+         *      input ends.
+         */
+        void Fill(u32 numberOfTokens);
+
+        Token GetEndToken() const;
+
+    private:
+        Ref<SourceFile> m_source;
+        u32 m_cursor = 0;
+
+        std::array<PackedToken, LOOKAHEAD_CAPACITY> m_lookahead;
+        u32 m_lookaheadStart = 0;
+        u32 m_lookaheadCount = 0;
+    };
+} // namespace ntt
@@ -2,9 +2,24 @@
 #include <string>
 #include <vector>
 #include "token.h"
+#include "token_buffer.h"
+#include "line_index.h"
+#include "source_file.h"
 
 namespace ntt
 {
+    /**
+     * The tokens which were replaced by `Tokenizer::ApplyEdit`, every token before
+     *      `firstToken` and after the inserted ones is the same as before the edit (only
+     *      moved by the length difference of the edit).
+     */
+    struct TokenEdit
+    {
+        u32 firstToken;
+        u32 numberOfRemovedTokens;
+        u32 numberOfInsertedTokens;
+    };
+
     /**
      * Simple interface for converting the input string into predefined tokens.
      */
@@ -13,29 +28,112 @@ namespace ntt
     public:
         Tokenizer(const char *input);
         Tokenizer(const std::string &input);
+
+        /**
+         * Lexes the `length` characters at `input` in place, the caller must keep them alive
+         *      as long as the tokens (see `SourceFile(const char *, u32)`).
+         */
+        Tokenizer(const char *input, u32 length);
+
+        /**
+         * Lexes the given source file in place, for example a file mapped with
+         *      `SourceFile::MapFile`.
+         */
+        Tokenizer(const Ref<SourceFile> &source);
+
+        /**
+         * Lexes the given source file in `numberOfThreads` chunks (one per core when 0),
+         *      the tokens (and the interned symbols) are exactly the ones of the serial
+         *      tokenizer. The input is split at new lines which are guessed to be outside
+         *      the strings, a chunk which still starts inside a token of the previous one
+         *      is fixed when the chunks are merged.
+         *
+         * The chunks are lexed on the threads of `WorkerPool::Get`.
+         */
+        Tokenizer(const Ref<SourceFile> &source, u32 numberOfThreads);
         ~Tokenizer();
 
         /**
-         * Get the tokens parsed from the input string.
+         * Get the tokens parsed from the input string, they are unpacked from the token
+         *      buffer at the first call and kept until the next `ApplyEdit`, which
+         *      invalidates the returned reference.
          * @return A vector of tokens parsed from the input string.
          */
-        inline const std::vector<Token> &GetTokens() const { return m_tokens; }
+        const std::vector<Token> &GetTokens() const;
+
+        /**
+         * The tokens as they are stored, 16 bytes each.
+         */
+        inline const TokenBuffer &GetTokenBuffer() const { return m_tokens; }
+
+        /**
+         * The textual values of the tokens are views into this source file, whoever keeps
+         *      the tokens longer than the tokenizer must also keep this reference.
+         */
+        inline const Ref<SourceFile> &GetSource() const { return m_tokens.GetSource(); }
+
+        /**
+         * The starts of the lines of the source file, built with the tokens and kept up to
+         *      date by `ApplyEdit`.
+         */
+        inline const LineIndex &GetLineIndex() const { return m_lineIndex; }
 
-    private:
         /**
-         * Used for converting all `\r\n` or `\n` to `` in the input string.
-         * This is called inside the constructor before tokenization.
+         * Replaces `removedLength` characters at `offset` with `insertedText` and updates the
+         *      tokens without lexing the whole input again. Only the tokens around the edit
+         *      are lexed, until the lexer reaches the start of a token which was after the
+         *      edited range, from there the old tokens are kept.
+         *
+         * The edited text is stored in a new source file, the one which was returned by
+         *      `GetSource` before is not modified so the tokens copied from it stay valid.
+         *
+         * @return The range of the tokens which changed.
          */
-        void PreProcessContent();
+        TokenEdit ApplyEdit(u32 offset, u32 removedLength, const std::string &insertedText);
 
+    private:
         /**
          * Actually perform the tokenization of the input string. This is called
          *      inside the constructor. The `m_tokens` will be populated after this call.
+         *      The new lines are skipped like the spaces.
          */
         void TokenizeInput();
 
+        void TokenizeInputInParallel(u32 numberOfThreads);
+
+        /**
+         * Lexes the tokens which start in `[startIndex, endIndex)`, the last one may end
+         *      after `endIndex`.
+         *
+         * @param isInterning Whether the new texts are interned, when not (on the worker
+         *      threads) their tokens get `Symbol::NONE`.
+         */
+        void LexRange(u32 startIndex, u32 endIndex, b8 isInterning, TokenBuffer &outTokens) const;
+
+        /**
+         * Reads the token which starts at the given position of `source`, also used by
+         *      `TokenStream`.
+         *
+         * @param cursor The index of the first (non space) character of the token, it
+         *      will be moved to the first character after the token.
+         * @param isInterning See `LexRange`.
+         * @return The token which is found at the cursor.
+         */
+        static PackedToken ReadToken(const SourceFile &source, u32 &cursor, b8 isInterning);
+
+        friend class TokenStream;
+
     private:
-        std::vector<Token> m_tokens;
-        std::string m_input;
+        /**
+         * Also keeps the source file which the texts of the tokens are viewed from.
+         */
+        TokenBuffer m_tokens;
+        LineIndex m_lineIndex;
+
+        /**
+         * The tokens returned by `GetTokens`, empty until it is called.
+         */
+        mutable std::vector<Token> m_unpackedTokens;
+        mutable b8 m_isUnpacked = NTT_FALSE;
     };
 } // namespace ntt
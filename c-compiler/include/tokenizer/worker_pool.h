@@ -0,0 +1,70 @@
+#pragma once
+#include "pch.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ntt
+{
+    /**
+     * Threads which are started once and kept for the whole process, so the parallel
+     *      tokenizations do not pay the creation of their threads at each call.
+     */
+    class WorkerPool
+    {
+    public:
+        ~WorkerPool();
+
+        /**
+         * @return The process wide pool, its threads are started at the first call.
+         */
+        static WorkerPool &Get();
+
+        /**
+         * Calls `task` with every index of `[0, numberOfTasks)` on the threads of the pool
+         *      and the calling thread, and returns once all the calls are done. The calls
+         *      from several threads are run one after the other, a task must not call
+         *      `Run` itself.
+         */
+        void Run(u32 numberOfTasks, const std::function<void(u32)> &task);
+
+        /**
+         * @return The number of tasks which can run at once, the calling thread included.
+         */
+        inline u32 GetConcurrency() const { return u32(m_threads.size()) + 1; }
+
+    private:
+        WorkerPool(u32 numberOfThreads);
+
+        void Work();
+
+        /**
+         * Runs the tasks which are not taken yet, `lock` holds `m_mutex`.
+         */
+        void RunTasks(std::unique_lock<std::mutex> &lock);
+
+    private:
+        Vector<std::thread> m_threads;
+
+        /**
+         * Taken for the whole `Run`, only one batch of tasks is in the pool at a time.
+         */
+        std::mutex m_runMutex;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wakeUp;
+        std::condition_variable m_done;
+
+        const std::function<void(u32)> *m_task = NTT_NULL;
+        u32 m_numberOfTasks = 0;
+        u32 m_nextTask = 0;
+        u32 m_numberOfFinishedTasks = 0;
+
+        /**
+         * Incremented by every `Run`, the threads wake up when it changes.
+         */
+        u64 m_generation = 0;
+        b8 m_isStopping = NTT_FALSE;
+    };
+} // namespace ntt
@@ -0,0 +1,189 @@
+#include "bench_common.h"
+#include "compiler.h"
+#include "parser/flat_ast.h"
+
+using namespace ntt;
+
+/**
+ * Synthetic inputs which each stress one shape of code, every one of them is tokenized,
+ *      compressed and parsed by the benchmarks below.
+ */
+// the parsing time doubles with each level of nested blocks, a deeper corpus does not
+//      finish in a reasonable time.
+static constexpr u32 DEEP_NESTING_DEPTH = 8;
+
+static String CreateDeepNestingCorpus()
+{
+    String content;
+    for (u32 repeatIndex = 0; repeatIndex < 400; repeatIndex++)
+    {
+        for (u32 depth = 0; depth < DEEP_NESTING_DEPTH; depth++)
+        {
+            content += "if (((a + b) * (c - d))) {\n";
+        }
+        content += "value = [[1, 2], [3, 4]];\n";
+        for (u32 depth = 0; depth < DEEP_NESTING_DEPTH; depth++)
+        {
+            content += "}\n";
+        }
+    }
+    return content;
+}
+
+static String CreateLongExpressionCorpus()
+{
+    String content;
+    for (u32 statementIndex = 0; statementIndex < 40; statementIndex++)
+    {
+        content += "value = first";
+        for (u32 operandIndex = 0; operandIndex < 500; operandIndex++)
+        {
+            content += operandIndex % 3 == 0   ? " + (count * 2)"
+                       : operandIndex % 3 == 1 ? " - !flag"
+                                               : " / 1.5";
+        }
+        content += ";\n";
+    }
+    return content;
+}
+
+static String CreateManyStatementsCorpus()
+{
+    String content;
+    for (u32 statementIndex = 0; statementIndex < 4000; statementIndex++)
+    {
+        content += "let counter : number = 1;\n";
+        content += "counter = counter + 1;\n";
+        content += "print(counter);\n";
+    }
+    return content;
+}
+
+static String CreateStringHeavyCorpus()
+{
+    String content;
+    for (u32 statementIndex = 0; statementIndex < 4000; statementIndex++)
+    {
+        content += "print(\"a fairly long message with \\\"quotes\\\" and spaces\", \"second\");\n";
+        content += "let message : string = \"another string literal which is quite long\";\n";
+    }
+    return content;
+}
+
+static void BenchmarkTokenize(BenchmarkState &state, const String &content)
+{
+    u64 numberOfTokens = 0;
+
+    while (state.KeepRunning())
+    {
+        Tokenizer tokenizer(content);
+        numberOfTokens = tokenizer.GetTokenBuffer().GetSize();
+    }
+
+    state.SetBytesPerIteration(content.size());
+    state.SetItemsPerIteration(numberOfTokens, "tokens");
+}
+
+/**
+ * Only `Compress` is timed, the program is tokenized while the timer is paused.
+ */
+static void BenchmarkCompress(BenchmarkState &state, const String &content)
+{
+    Ref<BlockNode> program;
+
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        program = NTT_NULL;
+        program = CreateRef<BlockNode>(NodeType::PROGRAM, content);
+        state.ResumeTiming();
+
+        program->Compress();
+    }
+
+    state.SetBytesPerIteration(content.size());
+    state.SetItemsPerIteration(FlatAst(*program).GetNodeCount(), "nodes");
+}
+
+/**
+ * Only `Parse` is timed, the program is tokenized and compressed while the timer is
+ *      paused.
+ */
+static void BenchmarkParse(BenchmarkState &state, const String &content)
+{
+    Ref<BlockNode> program;
+
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        program = NTT_NULL;
+        program = CreateRef<BlockNode>(NodeType::PROGRAM, content);
+        program->Compress();
+        state.ResumeTiming();
+
+        program->Parse();
+    }
+
+    state.SetBytesPerIteration(content.size());
+    state.SetItemsPerIteration(FlatAst(*program).GetNodeCount(), "nodes");
+}
+
+NTT_BENCHMARK(TokenizeDeepNesting)
+{
+    BenchmarkTokenize(state, CreateDeepNestingCorpus());
+}
+
+NTT_BENCHMARK(CompressDeepNesting)
+{
+    BenchmarkCompress(state, CreateDeepNestingCorpus());
+}
+
+NTT_BENCHMARK(ParseDeepNesting)
+{
+    BenchmarkParse(state, CreateDeepNestingCorpus());
+}
+
+NTT_BENCHMARK(TokenizeLongExpressions)
+{
+    BenchmarkTokenize(state, CreateLongExpressionCorpus());
+}
+
+NTT_BENCHMARK(CompressLongExpressions)
+{
+    BenchmarkCompress(state, CreateLongExpressionCorpus());
+}
+
+NTT_BENCHMARK(ParseLongExpressions)
+{
+    BenchmarkParse(state, CreateLongExpressionCorpus());
+}
+
+NTT_BENCHMARK(TokenizeManyStatements)
+{
+    BenchmarkTokenize(state, CreateManyStatementsCorpus());
+}
+
+NTT_BENCHMARK(CompressManyStatements)
+{
+    BenchmarkCompress(state, CreateManyStatementsCorpus());
+}
+
+NTT_BENCHMARK(ParseManyStatements)
+{
+    BenchmarkParse(state, CreateManyStatementsCorpus());
+}
+
+NTT_BENCHMARK(TokenizeStringHeavy)
+{
+    BenchmarkTokenize(state, CreateStringHeavyCorpus());
+}
+
+NTT_BENCHMARK(CompressStringHeavy)
+{
+    BenchmarkCompress(state, CreateStringHeavyCorpus());
+}
+
+NTT_BENCHMARK(ParseStringHeavy)
+{
+    BenchmarkParse(state, CreateStringHeavyCorpus());
+}
@@ -0,0 +1,86 @@
+#include "bench_common.h"
+#include "compiler.h"
+
+using namespace ntt;
+
+static String CreateParseInput()
+{
+    String content;
+    for (u32 statementIndex = 0; statementIndex < 500; statementIndex++)
+    {
+        content += "let value : number = 3 + 4 * (2 - 1) / 5;\n";
+        content += "if (value >= 2) { value = value ^ 2; } else { print(value, !done); }\n";
+    }
+    return content;
+}
+
+NTT_BENCHMARK(ParseProgramInArena)
+{
+    String content = CreateParseInput();
+    u64 numberOfNodes = 0;
+
+    while (state.KeepRunning())
+    {
+        BlockNode program(NodeType::PROGRAM, content);
+        program.Compress();
+        program.Parse();
+        numberOfNodes = program.GetChildren().size();
+    }
+
+    state.SetBytesPerIteration(content.size());
+    state.SetItemsPerIteration(numberOfNodes, "top-level nodes");
+}
+
+/**
+ * Same work but the tree is built from hand made atomics, so every node is a normal
+ *      shared node. Kept to compare against the arena.
+ */
+NTT_BENCHMARK(ParseProgramShared)
+{
+    String content = CreateParseInput();
+    u64 numberOfNodes = 0;
+
+    while (state.KeepRunning())
+    {
+        Tokenizer tokenizer(content);
+        Vector<Ref<Node>> atomics;
+        for (const auto &token : tokenizer.GetTokens())
+        {
+            atomics.push_back(CreateRef<Atomic>(NodeType::ATOMIC, token));
+        }
+
+        BlockNode program(NodeType::PROGRAM, atomics);
+        program.Compress();
+        program.Parse();
+        numberOfNodes = program.GetChildren().size();
+    }
+
+    state.SetBytesPerIteration(content.size());
+    state.SetItemsPerIteration(numberOfNodes, "top-level nodes");
+}
+
+/**
+ * One keystroke inside a statement in the middle of the program, typed then erased, only
+ *      that statement is parsed again. Compare with ParseProgramInArena.
+ */
+NTT_BENCHMARK(IncrementalParseEdit)
+{
+    String content = CreateParseInput();
+    IncrementalParser parser(content);
+    u32 offset = u32(content.find("3 + 4", content.size() / 2));
+    u32 iteration = 0;
+
+    while (state.KeepRunning())
+    {
+        if (iteration++ % 2 == 0)
+        {
+            parser.ApplyEdit(offset, 0, "1");
+        }
+        else
+        {
+            parser.ApplyEdit(offset, 1, "");
+        }
+    }
+
+    state.SetItemsPerIteration(1, "edits");
+}
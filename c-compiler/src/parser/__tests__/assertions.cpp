@@ -28,7 +28,7 @@ void BlockAssertion::_Assert(Ref<Node> node)
 
     EXPECT_THAT(node->GetType(), m_blockType);
 
-    BlockNode *blockNode = dynamic_cast<BlockNode *>(node.get());
+    BlockNode *blockNode = NodeCast<BlockNode>(node.get());
 
     EXPECT_THAT(blockNode->GetChildren().size(), m_assertions.size()) << errorBuffer;
     u32 numberOfAssertions = u32(m_assertions.size());
@@ -45,7 +45,7 @@ void AtomicAssertion::_Assert(Ref<Node> node)
 
     EXPECT_THAT(node->GetType(), NodeType::ATOMIC) << errorBuffer;
 
-    Atomic *atomicNode = dynamic_cast<Atomic *>(node.get());
+    Atomic *atomicNode = NodeCast<Atomic>(node.get());
     EXPECT_THAT(atomicNode != nullptr, true) << errorBuffer;
 
     const Token &token = atomicNode->GetToken();
@@ -54,7 +54,7 @@ void AtomicAssertion::_Assert(Ref<Node> node)
     switch (m_expectType)
     {
     case TokenType::INTEGER:
-        EXPECT_THAT(token.GetValue<u32>(), m_expectValue.numberValue.intValue) << errorBuffer;
+        EXPECT_THAT(token.GetValue<u64>(), m_expectValue.numberValue.intValue) << errorBuffer;
         break;
     case TokenType::FLOAT:
         EXPECT_THAT(token.GetValue<f32>(), m_expectValue.numberValue.floatValue) << errorBuffer;
@@ -98,7 +98,7 @@ void UnaryOperationAssertion::_Assert(Ref<Node> node)
 
     EXPECT_THAT(node->GetType(), NodeType::UNARY_OPERATION) << errorBuffer;
 
-    UnaryOperationNode *unaryNode = dynamic_cast<UnaryOperationNode *>(node.get());
+    UnaryOperationNode *unaryNode = NodeCast<UnaryOperationNode>(node.get());
     EXPECT_THAT(unaryNode != nullptr, true) << errorBuffer;
 
     m_operand->Assert(unaryNode->GetOperand());
@@ -111,7 +111,7 @@ void OperationAssertion::_Assert(Ref<Node> node)
 
     EXPECT_THAT(node->GetType(), NodeType::OPERATION) << errorBuffer;
 
-    OperationNode *expressionNode = dynamic_cast<OperationNode *>(node.get());
+    OperationNode *expressionNode = NodeCast<OperationNode>(node.get());
     EXPECT_THAT(expressionNode != nullptr, true) << errorBuffer;
 
     m_leftOperand->Assert(expressionNode->GetLeftOperand());
@@ -125,7 +125,7 @@ void IfStatementAssertion::_Assert(Ref<Node> node)
 
     EXPECT_THAT(node->GetType(), NodeType::IF_STATEMENT) << errorBuffer;
 
-    IfStatementNode *ifNode = dynamic_cast<IfStatementNode *>(node.get());
+    IfStatementNode *ifNode = NodeCast<IfStatementNode>(node.get());
     EXPECT_THAT(ifNode != nullptr, true) << errorBuffer;
 
     m_condition->Assert(ifNode->GetCondition());
@@ -139,7 +139,7 @@ void FunctionCallAssertion::_Assert(Ref<Node> node)
 
     EXPECT_THAT(node->GetType(), NodeType::FUNCTION_CALL) << errorBuffer;
 
-    FunctionCallNode *funcCallNode = dynamic_cast<FunctionCallNode *>(node.get());
+    FunctionCallNode *funcCallNode = NodeCast<FunctionCallNode>(node.get());
     EXPECT_THAT(funcCallNode != nullptr, true) << errorBuffer;
 
     m_function->Assert(funcCallNode->GetFunction());
@@ -161,5 +161,5 @@ void VariableDefinitionAssertion::_Assert(Ref<Node> node)
 
     EXPECT_THAT(node->GetType(), NodeType::VARIABLE_DEFINITION_STATEMENT) << errorBuffer;
 
-    VariableDefinitionNode *varDefNode = dynamic_cast<VariableDefinitionNode *>(node.get());
+    VariableDefinitionNode *varDefNode = NodeCast<VariableDefinitionNode>(node.get());
 }
\ No newline at end of file
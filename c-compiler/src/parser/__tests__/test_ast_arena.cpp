@@ -0,0 +1,103 @@
+#include "test_common.h"
+#include "parser/ast_arena.h"
+#include "parser/blockNode.h"
+#include "parser/atomic.h"
+
+using namespace ntt;
+
+namespace
+{
+    struct DestructorCounter
+    {
+        DestructorCounter(u32 &counter) : counter(counter) {}
+        ~DestructorCounter() { counter++; }
+
+        u32 &counter;
+    };
+
+    struct alignas(64) AlignedObject
+    {
+        u8 data[3];
+    };
+} // namespace anonymous
+
+TEST(AstArenaTest, RefsOwnTheObjects)
+{
+    AstArena arena;
+    Token token(TokenType::IDENTIFIER, 0);
+    token.SetValue<String>("name");
+
+    Ref<Atomic> atomic = arena.Create<Atomic>(NodeType::ATOMIC, token);
+    Ref<Node> copy = atomic;
+
+    EXPECT_NE(atomic, NTT_NULL);
+    EXPECT_EQ(atomic.use_count(), 2);
+    EXPECT_EQ(copy->GetType(), NodeType::ATOMIC);
+    EXPECT_EQ(atomic->GetToken().GetValue<String>(), "name");
+    EXPECT_EQ(arena.GetObjectCount(), 1);
+}
+
+TEST(AstArenaTest, DestroysObjectsWithTheirLastRef)
+{
+    u32 numberOfDestroyed = 0;
+    Ref<DestructorCounter> kept;
+
+    {
+        AstArena arena(128);
+        for (u32 objectIndex = 0; objectIndex < 100; objectIndex++)
+        {
+            Ref<DestructorCounter> counter = arena.Create<DestructorCounter>(numberOfDestroyed);
+            if (objectIndex == 0)
+            {
+                kept = counter;
+            }
+        }
+
+        EXPECT_EQ(numberOfDestroyed, 99);
+        EXPECT_GT(arena.GetBlockCount(), 1);
+    }
+
+    // the blocks stay alive as long as one of their objects.
+    EXPECT_EQ(numberOfDestroyed, 99);
+    kept = NTT_NULL;
+    EXPECT_EQ(numberOfDestroyed, 100);
+}
+
+TEST(AstArenaTest, NodesOutliveTheirTree)
+{
+    Ref<Node> statement;
+
+    {
+        BlockNode blockNode(NodeType::PROGRAM, "let a : number = 1 + 2;");
+        blockNode.Compress();
+        blockNode.Parse();
+        statement = blockNode.GetChildren()[0];
+    }
+
+    EXPECT_EQ(statement->GetType(), NodeType::STATEMENT);
+    EXPECT_FALSE(statement->ToJSON().dump().empty());
+}
+
+TEST(AstArenaTest, KeepsAlignmentAndBigObjects)
+{
+    AstArena arena(16);
+
+    arena.Create<u8>(u8(1));
+    Ref<AlignedObject> aligned = arena.Create<AlignedObject>();
+    EXPECT_EQ(uintptr_t(aligned.get()) % 64, 0);
+
+    Ref<Vector<u32>> vector = arena.Create<Vector<u32>>(1000, 7);
+    EXPECT_EQ(vector->size(), 1000);
+}
+
+TEST(AstArenaTest, HandMadeTreeUsesSharedNodes)
+{
+    BlockNode blockNode(NodeType::PROGRAM, Vector<Ref<Node>>{});
+    blockNode.Compress();
+    blockNode.Parse();
+
+    Token token(TokenType::INTEGER, 0);
+    token.SetValue<u32>(3);
+    Ref<Node> node = CreateNode<Atomic>(NTT_NULL, NodeType::ATOMIC, token);
+    EXPECT_EQ(node.use_count(), 1);
+}
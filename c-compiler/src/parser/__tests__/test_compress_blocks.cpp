@@ -139,4 +139,35 @@ TEST(BlockNodeCompressTest, NestedMissingBrackets)
                 ErrorType::MISSING_END_BRACKET,
                 ATOMIC_ASSERTION(TokenType::STRING, "\"Testing\""))),
         ATOMIC_ASSERTION(TokenType::BRACKET, ")"));
-}
\ No newline at end of file
+}
+
+TEST(BlockNodeCompressTest, InterleavedBrackets)
+{
+    COMPRESS_ONLY_DEFINE("( [ a ) ]");
+
+    PROGRAM_ASSERTION(
+        EXPRESSION_ASSERTION(
+            INDEX_ASSERTION_ERR(
+                ErrorType::MISSING_END_BRACKET,
+                ATOMIC_ASSERTION(TokenType::IDENTIFIER, "a"))),
+        ATOMIC_ASSERTION(TokenType::BRACKET, "]"));
+}
+
+TEST(BlockNodeCompressTest, DeepNesting)
+{
+    const u32 depth = 100000;
+    COMPRESS_ONLY_DEFINE(String(depth, '(') + "a" + String(depth, ')'));
+
+    const BlockNode *currentBlock = &blockNode;
+    for (u32 level = 0; level < depth; level++)
+    {
+        ASSERT_EQ(currentBlock->GetChildren().size(), 1);
+        currentBlock = NodeCast<BlockNode>(currentBlock->GetChildren()[0].get());
+        ASSERT_NE(currentBlock, NTT_NULL);
+        ASSERT_EQ(currentBlock->GetType(), NodeType::EXPRESSION);
+        ASSERT_FALSE(currentBlock->HasErrors());
+    }
+
+    ASSERT_EQ(currentBlock->GetChildren().size(), 1);
+    EXPECT_EQ(currentBlock->GetChildren()[0]->GetType(), NodeType::ATOMIC);
+}
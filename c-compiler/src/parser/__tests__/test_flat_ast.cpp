@@ -0,0 +1,76 @@
+#include "test_common.h"
+#include "parser/blockNode.h"
+#include "parser/flat_ast.h"
+#include "assertions.h"
+
+#define FLAT_AST_JSON_TESTING(content)                                            \
+    {                                                                             \
+        PARSE_DEFINE(content);                                                    \
+        FlatAst flatAst(blockNode);                                               \
+        EXPECT_EQ(flatAst.ToJSON(), blockNode.ToJSON()) << "Input = " << content; \
+    }
+
+TEST(FlatAstTest, SameJSONAsTheNodeTree)
+{
+    FLAT_AST_JSON_TESTING("");
+    FLAT_AST_JSON_TESTING("3 + 4 * (2 - 1)");
+    FLAT_AST_JSON_TESTING("!a; !!b; ! ;");
+    FLAT_AST_JSON_TESTING("let x : number = 3; const y : string; let z;");
+    FLAT_AST_JSON_TESTING("if (a) { b = 1; } else if (c) { d; } else { print(a, b + 1, !c); }");
+    FLAT_AST_JSON_TESTING("a[1] = { 2 + ; } + (3");
+    FLAT_AST_JSON_TESTING("+ 4 * ; test(,);");
+}
+
+TEST(FlatAstTest, PostOrderLayout)
+{
+    PARSE_DEFINE("a + 1;");
+    FlatAst flatAst(blockNode);
+
+    // a, +, 1 are flattened as the operator, left and right children.
+    ASSERT_EQ(flatAst.GetNodeCount(), 6);
+    EXPECT_EQ(flatAst.GetKind(flatAst.GetRoot()), NodeType::PROGRAM);
+
+    u32 statement = flatAst.GetChild(flatAst.GetRoot(), 0);
+    EXPECT_EQ(flatAst.GetKind(statement), NodeType::STATEMENT);
+    ASSERT_EQ(flatAst.GetChildCount(statement), 1);
+
+    u32 operation = flatAst.GetChild(statement, 0);
+    EXPECT_EQ(flatAst.GetKind(operation), NodeType::OPERATION);
+    ASSERT_EQ(flatAst.GetChildCount(operation), 3);
+    EXPECT_EQ(flatAst.GetToken(flatAst.GetChild(operation, 0)).GetSymbol(), Symbol::PLUS);
+    EXPECT_EQ(flatAst.GetToken(flatAst.GetChild(operation, 1)).GetValue<String>(), "a");
+    EXPECT_EQ(flatAst.GetToken(flatAst.GetChild(operation, 2)).GetValue<u32>(), 1);
+
+    for (u32 node = 0; node < flatAst.GetNodeCount(); node++)
+    {
+        for (u32 childIndex = 0; childIndex < flatAst.GetChildCount(node); childIndex++)
+        {
+            EXPECT_LT(flatAst.GetChild(node, childIndex), node);
+        }
+    }
+}
+
+TEST(FlatAstTest, CollectErrors)
+{
+    PARSE_DEFINE("3 + ;");
+    FlatAst flatAst(blockNode);
+
+    Vector<u32> nodesWithErrors = flatAst.CollectNodesWithErrors();
+    ASSERT_EQ(nodesWithErrors.size(), 1);
+    EXPECT_EQ(flatAst.GetKind(nodesWithErrors[0]), NodeType::OPERATION);
+    ASSERT_EQ(flatAst.GetErrorCount(nodesWithErrors[0]), 1);
+    EXPECT_EQ(flatAst.GetError(nodesWithErrors[0], 0), ErrorType::MISSING_RIGHT_OPERAND);
+}
+
+TEST(FlatAstTest, NumberOutOfRangeIsAnError)
+{
+    PARSE_DEFINE("a = 99999999999999999999 + 1;");
+    FlatAst flatAst(blockNode);
+
+    Vector<u32> nodesWithErrors = flatAst.CollectNodesWithErrors();
+    ASSERT_EQ(nodesWithErrors.size(), 1);
+    EXPECT_EQ(flatAst.GetKind(nodesWithErrors[0]), NodeType::ATOMIC);
+    EXPECT_EQ(flatAst.GetToken(nodesWithErrors[0]).GetValue<std::string_view>(), "99999999999999999999");
+    ASSERT_EQ(flatAst.GetErrorCount(nodesWithErrors[0]), 1);
+    EXPECT_EQ(flatAst.GetError(nodesWithErrors[0], 0), ErrorType::NUMBER_OUT_OF_RANGE);
+}
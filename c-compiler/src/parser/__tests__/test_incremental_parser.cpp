@@ -0,0 +1,68 @@
+#include "test_common.h"
+#include "parser/incremental_parser.h"
+
+using namespace ntt;
+
+/**
+ * Applies the edit then compares the tree with the one of a full parse of the edited
+ *      text.
+ */
+#define INCREMENTAL_EDIT_TESTING(parser, offset, removedLength, insertedText) \
+    {                                                                         \
+        parser.ApplyEdit(offset, removedLength, insertedText);                \
+        const Ref<SourceFile> &source = parser.GetSource();                   \
+        String editedContent(source->GetData(), source->GetLength());         \
+        BlockNode fullProgram(NodeType::PROGRAM, editedContent);              \
+        fullProgram.Compress();                                               \
+        fullProgram.Parse();                                                  \
+        EXPECT_EQ(parser.GetProgram()->ToJSON(), fullProgram.ToJSON())        \
+            << "Input = " << editedContent;                                   \
+    }
+
+TEST(IncrementalParserTest, SameTreeAsFullParse)
+{
+    IncrementalParser parser("a = 1;\nif (a) { b = 2; c; } else { d(a, 3); }\ne = [1];\n");
+
+    INCREMENTAL_EDIT_TESTING(parser, 4, 1, "42 + x");
+    INCREMENTAL_EDIT_TESTING(parser, 20, 0, " let f : number = 5;");
+    INCREMENTAL_EDIT_TESTING(parser, 20, 0, " }");
+    INCREMENTAL_EDIT_TESTING(parser, 20, 2, "");
+    INCREMENTAL_EDIT_TESTING(parser, 0, 0, "if (z) ");
+    INCREMENTAL_EDIT_TESTING(parser, 0, 7, "");
+    INCREMENTAL_EDIT_TESTING(parser, 10, 1, "");
+    INCREMENTAL_EDIT_TESTING(parser, 10, 0, ";");
+    INCREMENTAL_EDIT_TESTING(parser, 0, 0, "   ");
+    INCREMENTAL_EDIT_TESTING(parser, 0, 0, "\"");
+    INCREMENTAL_EDIT_TESTING(parser, 0, 1, "");
+}
+
+TEST(IncrementalParserTest, OnlyReparseTheEditedStatement)
+{
+    IncrementalParser parser("let a : number = 1;\nb = a + 2;\nif (a) { c = 3; d; }\n");
+    Vector<Ref<Node>> children = parser.GetProgram()->GetChildren();
+    ASSERT_EQ(children.size(), 3);
+
+    // inside the second statement.
+    parser.ApplyEdit(24, 1, "a * 4");
+    ASSERT_EQ(parser.GetProgram()->GetChildren().size(), 3);
+    EXPECT_EQ(parser.GetLastReparsedNode(), children[1].get());
+    EXPECT_EQ(parser.GetProgram()->GetChildren()[0], children[0]);
+    EXPECT_EQ(parser.GetProgram()->GetChildren()[1], children[1]);
+    EXPECT_EQ(parser.GetProgram()->GetChildren()[2], children[2]);
+
+    // a new statement inside the block of the if statement.
+    u32 braceIndex = u32(String(parser.GetSource()->GetData()).find('{'));
+    parser.ApplyEdit(braceIndex + 1, 0, " e;");
+    EXPECT_EQ(parser.GetProgram()->GetChildren()[2], children[2]);
+    ASSERT_NE(parser.GetLastReparsedNode(), NTT_NULL);
+    EXPECT_EQ(parser.GetLastReparsedNode()->GetType(), NodeType::BLOCK);
+
+    // only spaces, nothing is parsed.
+    parser.ApplyEdit(0, 0, "  ");
+    EXPECT_EQ(parser.GetLastReparsedNode(), NTT_NULL);
+
+    // the semicolon is removed, the statements are merged.
+    parser.ApplyEdit(20, 1, "");
+    EXPECT_EQ(parser.GetLastReparsedNode(), parser.GetProgram().get());
+    EXPECT_EQ(parser.GetProgram()->GetChildren().size(), 2);
+}
@@ -0,0 +1,65 @@
+#include "test_common.h"
+#include "parser/blockNode.h"
+#include "parser/atomic.h"
+#include "parser/operationNode.h"
+#include "assertions.h"
+
+using namespace ntt;
+
+namespace
+{
+    class CountingVisitor : public NodeVisitor
+    {
+    public:
+        void Visit(Atomic &node) override
+        {
+            NTT_UNUSED(node);
+            numberOfAtomics++;
+        }
+        void Visit(BlockNode &node) override
+        {
+            numberOfBlocks++;
+            for (const auto &child : node.GetChildren())
+            {
+                child->Accept(*this);
+            }
+        }
+        void Visit(OperationNode &node) override
+        {
+            numberOfOperations++;
+            node.GetOperator()->Accept(*this);
+            node.GetLeftOperand()->Accept(*this);
+            node.GetRightOperand()->Accept(*this);
+        }
+
+        u32 numberOfAtomics = 0;
+        u32 numberOfBlocks = 0;
+        u32 numberOfOperations = 0;
+    };
+} // namespace anonymous
+
+TEST(NodeCastTest, CastsOnlyToTheMatchingClass)
+{
+    PARSE_DEFINE("a + 1;");
+
+    Ref<Node> statement = blockNode.GetChildren()[0];
+    EXPECT_NE(NodeCast<BlockNode>(statement), NTT_NULL);
+    EXPECT_EQ(NodeCast<Atomic>(statement), NTT_NULL);
+
+    Node *operation = NodeCast<BlockNode>(statement)->GetChildren()[0].get();
+    EXPECT_NE(NodeCast<OperationNode>(operation), NTT_NULL);
+    EXPECT_EQ(NodeCast<BlockNode>(operation), NTT_NULL);
+    EXPECT_EQ(NodeCast<Atomic>(static_cast<Node *>(NTT_NULL)), NTT_NULL);
+}
+
+TEST(NodeCastTest, VisitorDispatchesOnTheConcreteClass)
+{
+    PARSE_DEFINE("a + 1; b;");
+
+    CountingVisitor visitor;
+    blockNode.Accept(visitor);
+
+    EXPECT_EQ(visitor.numberOfBlocks, 3);
+    EXPECT_EQ(visitor.numberOfOperations, 1);
+    EXPECT_EQ(visitor.numberOfAtomics, 4);
+}
@@ -1,5 +1,6 @@
 #include "test_common.h"
 #include "parser/blockNode.h"
+#include "parser/operationNode.h"
 #include "assertions.h"
 
 TEST(OperationTest, SimpleAddition)
@@ -210,4 +211,49 @@ TEST(OperationTest, ComparingOperation)
                     ATOMIC_ASSERTION(TokenType::INTEGER, u32(3))),
                 "*",
                 ATOMIC_ASSERTION(TokenType::INTEGER, u32(4)))));
-}
\ No newline at end of file
+}
+
+TEST(OperationTest, UnaryOperand)
+{
+    PARSE_DEFINE("!a * b");
+
+    PROGRAM_ASSERTION(
+        STATEMENT_ASSERTION(
+            OPERATION_ASSERTION(
+                UNARY_ASSERTION(
+                    "!",
+                    ATOMIC_ASSERTION(TokenType::IDENTIFIER, "a")),
+                "*",
+                ATOMIC_ASSERTION(TokenType::IDENTIFIER, "b"))));
+}
+
+TEST(OperationTest, LongChainIsLeftAssociative)
+{
+    const u32 numberOfOperands = 500;
+    String content = "0";
+    for (u32 operandIndex = 1; operandIndex < numberOfOperands; operandIndex++)
+    {
+        content += operandIndex % 2 == 0 ? " + " : " * ";
+        content += std::to_string(operandIndex);
+    }
+
+    PARSE_DEFINE(content);
+
+    const Ref<Node> &statement = blockNode.GetChildren()[0];
+    ASSERT_EQ(statement->GetType(), NodeType::STATEMENT);
+    const Vector<Ref<Node>> &statementChildren = static_cast<BlockNode *>(statement.get())->GetChildren();
+    ASSERT_EQ(statementChildren.size(), 1);
+
+    // `*` binds tighter, so the left spine is the chain of `+` ending with `0 * 1`.
+    u32 spineLength = 0;
+    Ref<Node> current = statementChildren[0];
+    while (current->GetType() == NodeType::OPERATION)
+    {
+        OperationNode *operation = static_cast<OperationNode *>(current.get());
+        EXPECT_TRUE(operation->GetErrors().empty());
+        current = operation->GetLeftOperand();
+        spineLength++;
+    }
+
+    EXPECT_EQ(spineLength, numberOfOperands / 2);
+}
@@ -1,6 +1,8 @@
 #include "test_common.h"
 #include "assertions.h"
 #include "parser/blockNode.h"
+#include "parser/operationNode.h"
+#include "parser/variable_definition_node.h"
 
 using namespace ntt;
 
@@ -65,4 +67,46 @@ TEST(VariableDefinitionTest, DISABLED_MissingVariableName)
                 "let", "", "any", ATOMIC_ASSERTION(TokenType::NONE, "null")),
             ATOMIC_ASSERTION(TokenType::TYPE_HINT, ":"),
             ATOMIC_ASSERTION(TokenType::IDENTIFIER, "number")));
-}
\ No newline at end of file
+}
+
+TEST(VariableDefinitionTest, DefaultValueIsTheWholeInitializer)
+{
+    PARSE_DEFINE("let f: number = 1 + 2 * x;");
+
+    const BlockNode *statement = NodeCast<BlockNode>(blockNode.GetChildren()[0].get());
+    ASSERT_NE(statement, nullptr);
+    ASSERT_EQ(statement->GetChildren().size(), 1);
+
+    const VariableDefinitionNode *definition = NodeCast<VariableDefinitionNode>(statement->GetChildren()[0].get());
+    ASSERT_NE(definition, nullptr);
+
+    const OperationNode *initializer = NodeCast<OperationNode>(definition->GetDefaultValue().get());
+    ASSERT_NE(initializer, nullptr);
+    EXPECT_EQ(NodeCast<Atomic>(initializer->GetOperator().get())->GetToken().GetSymbol(), Symbol::PLUS);
+    EXPECT_EQ(initializer->GetRightOperand()->GetType(), NodeType::OPERATION);
+}
+
+TEST(VariableDefinitionTest, InitializerMustBeASingleExpression)
+{
+    struct Case
+    {
+        const char *content;
+        ErrorType error;
+    };
+
+    const Case cases[] = {
+        {"let v1 : number = 1, print(5);", ErrorType::INVALID_DEFAULT_VALUE},
+        {"let v1 : number = 1 2 3;", ErrorType::INVALID_DEFAULT_VALUE},
+        {"let v1 : number =;", ErrorType::MISSING_DEFAULT_VALUE},
+    };
+
+    for (const Case &testCase : cases)
+    {
+        PARSE_DEFINE(testCase.content);
+
+        const BlockNode *statement = NodeCast<BlockNode>(blockNode.GetChildren()[0].get());
+        ASSERT_NE(statement, nullptr) << testCase.content;
+        ASSERT_EQ(statement->GetErrors().size(), 1) << testCase.content;
+        EXPECT_EQ(statement->GetErrors()[0], testCase.error) << testCase.content;
+    }
+}
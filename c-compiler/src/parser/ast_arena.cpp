@@ -0,0 +1,45 @@
+#include "parser/ast_arena.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace ntt
+{
+    AstArena::AstArena(u32 blockSize)
+        : m_blocks(new Blocks()), m_objectCount(0)
+    {
+        m_blocks->blockSize = blockSize;
+        m_blocks->cursor = NTT_NULL;
+        m_blocks->end = NTT_NULL;
+        m_blocks->numberOfUsers = 1;
+    }
+
+    AstArena::~AstArena()
+    {
+        m_blocks->Release();
+    }
+
+    void AstArena::Blocks::Release()
+    {
+        if (--numberOfUsers == 0)
+        {
+            delete this;
+        }
+    }
+
+    void *AstArena::Blocks::Allocate(u32 size, u32 alignment)
+    {
+        uintptr_t address = (uintptr_t(cursor) + alignment - 1) & ~uintptr_t(alignment - 1);
+
+        if (cursor == NTT_NULL || address + size > uintptr_t(end))
+        {
+            u32 newBlockSize = std::max(blockSize, size + alignment);
+            blocks.push_back(Scope<u8[]>(new u8[newBlockSize]));
+            cursor = blocks.back().get();
+            end = cursor + newBlockSize;
+            address = (uintptr_t(cursor) + alignment - 1) & ~uintptr_t(alignment - 1);
+        }
+
+        cursor = reinterpret_cast<u8 *>(address + size);
+        return reinterpret_cast<void *>(address);
+    }
+} // namespace ntt
@@ -5,6 +5,10 @@ namespace ntt
     Atomic::Atomic(NodeType type, const Token &token)
         : m_token(token)
     {
+        if (m_token.IsValueOutOfRange())
+        {
+            AddError(ErrorType::NUMBER_OUT_OF_RANGE);
+        }
     }
 
     Atomic::~Atomic()
@@ -28,4 +32,9 @@ namespace ntt
     {
         // Parsing logic for atomic nodes can be implemented here
     }
+
+    void Atomic::Accept(NodeVisitor &visitor)
+    {
+        visitor.Visit(*this);
+    }
 }
\ No newline at end of file
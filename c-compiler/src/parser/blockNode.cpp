@@ -7,12 +7,15 @@
 #include "parser/if_statement.h"
 #include "parser/function_call.h"
 #include "parser/variable_definition_node.h"
+#include <algorithm>
+#include <iterator>
 
 namespace ntt
 {
     BlockNode::BlockNode(NodeType type, const String &content)
-        : m_type(type), m_content(content)
+        : m_type(type), m_arenaOwner(CreateRef<AstArena>()), m_content(content)
     {
+        m_arena = m_arenaOwner.get();
         TokenizeContent();
     }
 
@@ -23,6 +26,39 @@ namespace ntt
 
     BlockNode::~BlockNode()
     {
+        // the nested blocks which are only owned by their parent are emptied one at a
+        //      time, destroying a deep nesting recursively would overflow the stack.
+        Vector<Ref<Node>> nodes = std::move(m_children);
+        while (!nodes.empty())
+        {
+            Ref<Node> node = std::move(nodes.back());
+            nodes.pop_back();
+
+            BlockNode *blockNode = NodeCast<BlockNode>(node.get());
+            if (blockNode != NTT_NULL && node.use_count() == 1)
+            {
+                std::move(blockNode->m_children.begin(), blockNode->m_children.end(), std::back_inserter(nodes));
+                blockNode->m_children.clear();
+            }
+        }
+    }
+
+    b8 BlockNode::IsTypeOf(NodeType type)
+    {
+        switch (type)
+        {
+        case NodeType::ATOMIC:
+        case NodeType::INVALID:
+        case NodeType::OPERATION:
+        case NodeType::UNARY_OPERATION:
+        case NodeType::IF_STATEMENT:
+        case NodeType::FUNCTION_CALL:
+        case NodeType::VARIABLE_DEFINITION_STATEMENT:
+        case NodeType::COUNT:
+            return NTT_FALSE;
+        default:
+            return NTT_TRUE;
+        }
     }
 
     JSON BlockNode::ToJSON()
@@ -41,106 +77,251 @@ namespace ntt
 
     void BlockNode::Compress()
     {
-        m_children = CompressWithBrackets(m_children, NodeType::BLOCK, "{", "}");
-        m_children = CompressWithBrackets(m_children, NodeType::EXPRESSION, "(", ")");
-        m_children = CompressWithBrackets(m_children, NodeType::INDEX, "[", "]");
+        m_children = CompressBrackets(m_children);
     }
 
-    Vector<Ref<Node>> BlockNode::CompressWithBrackets(const Vector<Ref<Node>> &nodes,
-                                                      NodeType blockType,
-                                                      const String &bracketOpen,
-                                                      const String &bracketClose)
+    namespace
     {
-        Vector<Ref<Node>> compressedNodes;
-        u32 numberOfNodes = u32(nodes.size());
-        u32 nodeIndex = 0;
+        /**
+         * The bracket kinds in priority order, a bracket of a higher priority kind
+         *      (lower value) closes the unterminated groups of the lower priority kinds
+         *      inside it and hides their openings from its own content.
+         */
+        enum class BracketKind : u8
+        {
+            BRACE,
+            PARENTHESIS,
+            SQUARE_BRACKET,
+            NONE,
+        };
 
-        u8 bracketDepth = 0;
+        constexpr u32 NUMBER_OF_BRACKET_KINDS = u32(BracketKind::NONE);
+        constexpr u32 NO_GROUP = 0xFFFFFFFF;
 
-        Vector<Ref<Node>> temporaryCompressedNode;
-        temporaryCompressedNode.clear();
+        struct BracketEntry
+        {
+            BracketKind kind;
+            b8 isOpen;
+
+            /**
+             * Opening brackets only, the closing bracket matched this opening one,
+             *      otherwise the group is unterminated.
+             */
+            b8 isMatched;
+
+            /**
+             * Opening brackets: index of the node where the group ends (the matching closing
+             *      bracket, the bracket which closed an outer group or the number of nodes).
+             *      Closing brackets: index of the opening bracket they matched, `NO_GROUP`
+             *      for the unmatched ones which stay in the content as they are.
+             */
+            u32 pair;
+        };
+
+        BracketEntry ClassifyBracket(const Ref<Node> &node)
+        {
+            const Atomic *atomicNode = NodeCast<Atomic>(node.get());
+            if (atomicNode == NTT_NULL || atomicNode->GetToken().GetType() != TokenType::BRACKET)
+            {
+                return {BracketKind::NONE, NTT_FALSE, NTT_FALSE, NO_GROUP};
+            }
 
-        while (nodeIndex < numberOfNodes)
+            switch (atomicNode->GetToken().GetSymbol())
+            {
+            case Symbol::OPEN_BRACE:
+                return {BracketKind::BRACE, NTT_TRUE, NTT_FALSE, NO_GROUP};
+            case Symbol::CLOSE_BRACE:
+                return {BracketKind::BRACE, NTT_FALSE, NTT_FALSE, NO_GROUP};
+            case Symbol::OPEN_PARENTHESIS:
+                return {BracketKind::PARENTHESIS, NTT_TRUE, NTT_FALSE, NO_GROUP};
+            case Symbol::CLOSE_PARENTHESIS:
+                return {BracketKind::PARENTHESIS, NTT_FALSE, NTT_FALSE, NO_GROUP};
+            case Symbol::OPEN_SQUARE_BRACKET:
+                return {BracketKind::SQUARE_BRACKET, NTT_TRUE, NTT_FALSE, NO_GROUP};
+            case Symbol::CLOSE_SQUARE_BRACKET:
+                return {BracketKind::SQUARE_BRACKET, NTT_FALSE, NTT_FALSE, NO_GROUP};
+            default:
+                return {BracketKind::NONE, NTT_FALSE, NTT_FALSE, NO_GROUP};
+            }
+        }
+
+        NodeType BracketKindToNodeType(BracketKind kind)
         {
-            const Ref<Node> &currentNode = nodes[nodeIndex];
+            switch (kind)
+            {
+            case BracketKind::BRACE:
+                return NodeType::BLOCK;
+            case BracketKind::PARENTHESIS:
+                return NodeType::EXPRESSION;
+            default:
+                return NodeType::INDEX;
+            }
+        }
 
-            if (currentNode->GetType() != NodeType::ATOMIC)
+        /**
+         * Pairs the brackets of `nodes` with a single stack pass, the result has one entry
+         *      per node.
+         */
+        Vector<BracketEntry> BuildBracketTable(const Vector<Ref<Node>> &nodes)
+        {
+            u32 numberOfNodes = u32(nodes.size());
+            Vector<BracketEntry> table(numberOfNodes);
+
+            // the opening brackets which are not closed yet, plus for every kind the
+            //      positions in that stack of its openings so a closing bracket does not
+            //      need to search for its match.
+            Vector<u32> openings;
+            Vector<u32> kindOpenings[NUMBER_OF_BRACKET_KINDS];
+
+            for (u32 nodeIndex = 0; nodeIndex < numberOfNodes; nodeIndex++)
             {
-                if (bracketDepth == 0)
+                BracketEntry &entry = table[nodeIndex];
+                entry = ClassifyBracket(nodes[nodeIndex]);
+
+                if (entry.kind == BracketKind::NONE)
+                {
+                    continue;
+                }
+
+                u32 kind = u32(entry.kind);
+
+                if (entry.isOpen)
                 {
-                    compressedNodes.push_back(currentNode);
+                    kindOpenings[kind].push_back(u32(openings.size()));
+                    openings.push_back(nodeIndex);
+                    continue;
                 }
-                else
+
+                if (kindOpenings[kind].empty())
                 {
-                    temporaryCompressedNode.push_back(currentNode);
+                    continue;
                 }
-                nodeIndex++;
-                continue;
+
+                // an opening of a higher priority kind after the match hides it, the closing
+                //      bracket then stays in the content of that group.
+                u32 matchPosition = kindOpenings[kind].back();
+                b8 isHidden = NTT_FALSE;
+                for (u32 higherKind = 0; higherKind < kind; higherKind++)
+                {
+                    if (!kindOpenings[higherKind].empty() && kindOpenings[higherKind].back() > matchPosition)
+                    {
+                        isHidden = NTT_TRUE;
+                    }
+                }
+
+                if (isHidden)
+                {
+                    continue;
+                }
+
+                // the lower priority groups which are still open end with this one.
+                while (openings.size() > matchPosition + 1)
+                {
+                    u32 openingIndex = openings.back();
+                    openings.pop_back();
+                    kindOpenings[u32(table[openingIndex].kind)].pop_back();
+                    table[openingIndex].pair = nodeIndex;
+                }
+
+                u32 openingIndex = openings.back();
+                openings.pop_back();
+                kindOpenings[kind].pop_back();
+                table[openingIndex].pair = nodeIndex;
+                table[openingIndex].isMatched = NTT_TRUE;
+                entry.pair = openingIndex;
             }
 
-            Atomic *atomicNode = dynamic_cast<Atomic *>(currentNode.get());
-            const Token &currentNodeToken = atomicNode->GetToken();
+            for (u32 openingIndex : openings)
+            {
+                table[openingIndex].pair = numberOfNodes;
+            }
+
+            return table;
+        }
+
+        struct CompressFrame
+        {
+            u32 openingIndex;
+            Vector<Ref<Node>> children;
+
+            /**
+             * Whether anything came after the opening bracket, an unterminated group of a
+             *      higher priority kind which was dropped does not count.
+             */
+            b8 hasContent;
+        };
+    } // namespace anonymous
+
+    Vector<Ref<Node>> BlockNode::CompressBrackets(const Vector<Ref<Node>> &nodes) const
+    {
+        Vector<BracketEntry> table = BuildBracketTable(nodes);
+        u32 numberOfNodes = u32(nodes.size());
 
-            if (currentNodeToken.GetType() != TokenType::BRACKET ||
-                (currentNodeToken.GetValue<std::string>() != bracketOpen &&
-                 currentNodeToken.GetValue<std::string>() != bracketClose))
+        // the groups are built with an explicit stack, the nesting depth does not use
+        //      the call stack.
+        Vector<CompressFrame> frames;
+        Vector<Ref<Node>> compressedNodes;
+
+        for (u32 nodeIndex = 0; nodeIndex <= numberOfNodes; nodeIndex++)
+        {
+            while (!frames.empty() && table[frames.back().openingIndex].pair == nodeIndex)
             {
-                if (bracketDepth == 0)
+                CompressFrame frame = std::move(frames.back());
+                frames.pop_back();
+                Vector<Ref<Node>> &parentNodes = frames.empty() ? compressedNodes : frames.back().children;
+
+                const BracketEntry &opening = table[frame.openingIndex];
+                if (!opening.isMatched && !frame.hasContent)
+                {
+                    // an unterminated opening bracket with nothing after it is dropped.
+                    continue;
+                }
+
+                Ref<BlockNode> newBlockNode = CreateBlock(BracketKindToNodeType(opening.kind), frame.children);
+                newBlockNode->m_firstAtomic = NodeCast<Atomic>(nodes[frame.openingIndex].get());
+                if (opening.isMatched)
                 {
-                    compressedNodes.push_back(currentNode);
+                    newBlockNode->m_lastAtomic = NodeCast<Atomic>(nodes[nodeIndex].get());
                 }
                 else
                 {
-                    temporaryCompressedNode.push_back(currentNode);
+                    newBlockNode->AddError(ErrorType::MISSING_END_BRACKET);
+                }
+                parentNodes.push_back(newBlockNode);
+                if (!frames.empty())
+                {
+                    frames.back().hasContent = NTT_TRUE;
                 }
-                nodeIndex++;
-                continue;
             }
 
-            if (currentNodeToken.GetValue<std::string>() == bracketOpen)
+            if (nodeIndex == numberOfNodes)
             {
-                if (bracketDepth > 0)
-                {
-                    temporaryCompressedNode.push_back(currentNode);
-                }
-                bracketDepth++;
-                nodeIndex++;
-                continue;
+                break;
             }
-            else if (currentNodeToken.GetValue<std::string>() == bracketClose)
+
+            const BracketEntry &entry = table[nodeIndex];
+            if (entry.kind != BracketKind::NONE && entry.isOpen)
             {
-                if (bracketDepth == 0)
+                if (!frames.empty() && table[frames.back().openingIndex].kind <= entry.kind)
                 {
-                    // unmatched closing bracket, just push to the result
-                    compressedNodes.push_back(currentNode);
-                    nodeIndex++;
-                    continue;
+                    frames.back().hasContent = NTT_TRUE;
                 }
-                else if (bracketDepth == 1)
+                frames.push_back({nodeIndex, {}, NTT_FALSE});
+            }
+            else if (entry.kind == BracketKind::NONE || entry.pair == NO_GROUP)
+            {
+                if (frames.empty())
                 {
-                    Ref<BlockNode> newBlockNode = CreateRef<BlockNode>(blockType, temporaryCompressedNode);
-                    newBlockNode->Compress();
-                    compressedNodes.push_back(newBlockNode);
-                    nodeIndex++;
-                    temporaryCompressedNode.clear();
+                    compressedNodes.push_back(nodes[nodeIndex]);
                 }
                 else
                 {
-                    temporaryCompressedNode.push_back(currentNode);
-                    nodeIndex++;
+                    frames.back().children.push_back(nodes[nodeIndex]);
+                    frames.back().hasContent = NTT_TRUE;
                 }
-                bracketDepth--;
             }
         }
 
-        if (temporaryCompressedNode.size() > 0)
-        {
-            Ref<BlockNode> newBlockNode = CreateRef<BlockNode>(blockType, temporaryCompressedNode);
-            newBlockNode->Compress();
-            newBlockNode->AddError(ErrorType::MISSING_END_BRACKET);
-            compressedNodes.push_back(newBlockNode);
-        }
-
         return compressedNodes;
     }
 
@@ -168,7 +349,7 @@ namespace ntt
                     newParsedNodes,
                     hasAnyModified);
 
-                parsedNodes = newParsedNodes;
+                parsedNodes = std::move(newParsedNodes);
             }
 
             hasAnyModified = NTT_TRUE;
@@ -177,7 +358,7 @@ namespace ntt
                 parsedNodes,
                 newParsedNodes);
 
-            m_children = newParsedNodes;
+            m_children = std::move(newParsedNodes);
 
             for (auto &node : m_children)
             {
@@ -197,92 +378,16 @@ namespace ntt
 
             if (contain)
             {
-                parsedNodes = newerParsedNodes;
+                parsedNodes = std::move(newerParsedNodes);
             }
         }
 
-        hasAnyModified = NTT_TRUE;
-
-        while (hasAnyModified)
         {
-            hasAnyModified = NTT_FALSE;
-            Vector<Ref<Node>> newParsedNodes;
-            ParseUnaryOperations(
-                parsedNodes,
-                newParsedNodes,
-                hasAnyModified,
-                std::set<String>{"!"});
-            parsedNodes = newParsedNodes;
-        }
-
-        hasAnyModified = NTT_TRUE;
-
-        while (hasAnyModified)
-        {
-            hasAnyModified = NTT_FALSE;
             Vector<Ref<Node>> newParsedNodes;
             ParseOperations(
                 parsedNodes,
-                newParsedNodes,
-                hasAnyModified,
-                std::set<String>{"==", "!=", "<", "<=", ">", ">="});
-            parsedNodes = newParsedNodes;
-        }
-
-        hasAnyModified = NTT_TRUE;
-
-        while (hasAnyModified)
-        {
-            hasAnyModified = NTT_FALSE;
-            Vector<Ref<Node>> newParsedNodes;
-            ParseOperations(
-                parsedNodes,
-                newParsedNodes,
-                hasAnyModified,
-                std::set<String>{"^"});
-            parsedNodes = newParsedNodes;
-        }
-
-        hasAnyModified = NTT_TRUE;
-
-        while (hasAnyModified)
-        {
-            hasAnyModified = NTT_FALSE;
-            Vector<Ref<Node>> newParsedNodes;
-            ParseOperations(
-                parsedNodes,
-                newParsedNodes,
-                hasAnyModified,
-                std::set<String>{"*", "/"});
-            parsedNodes = newParsedNodes;
-        }
-
-        hasAnyModified = NTT_TRUE;
-
-        while (hasAnyModified)
-        {
-            hasAnyModified = NTT_FALSE;
-            Vector<Ref<Node>> newParsedNodes;
-            ParseOperations(
-                parsedNodes,
-                newParsedNodes,
-                hasAnyModified,
-                std::set<String>{"+", "-"});
-            parsedNodes = newParsedNodes;
-        }
-
-        hasAnyModified = NTT_TRUE;
-
-        while (hasAnyModified)
-        {
-            hasAnyModified = NTT_FALSE;
-            Vector<Ref<Node>> newParsedNodes;
-            ParseOperations(
-                parsedNodes,
-                newParsedNodes,
-                hasAnyModified,
-                std::set<String>{"="});
-            parsedNodes = newParsedNodes;
+                newParsedNodes);
+            parsedNodes = std::move(newParsedNodes);
         }
 
         hasAnyModified = NTT_TRUE;
@@ -295,7 +400,7 @@ namespace ntt
                 newerParsedNodes,
                 hasAnyModified);
 
-            parsedNodes = newerParsedNodes;
+            parsedNodes = std::move(newerParsedNodes);
         }
 
         hasAnyModified = NTT_TRUE;
@@ -311,11 +416,16 @@ namespace ntt
 
             if (containsComma)
             {
-                parsedNodes = newParsedNodes;
+                parsedNodes = std::move(newParsedNodes);
             }
         }
 
-        m_children = parsedNodes;
+        m_children = std::move(parsedNodes);
+    }
+
+    void BlockNode::Accept(NodeVisitor &visitor)
+    {
+        visitor.Visit(*this);
     }
 
     static b8 IsOperandValidNode(const Ref<Node> &node)
@@ -348,161 +458,323 @@ namespace ntt
         return NTT_TRUE;
     }
 
-    void BlockNode::ParseUnaryOperations(const Vector<Ref<Node>> &sourceNodes,
-                                         Vector<Ref<Node>> &outNodes,
-                                         b8 &hasAnyChange,
-                                         const std::set<String> &operators)
+    namespace
     {
-        NTT_ASSERT(outNodes.empty());
-        u32 numberOfSourceNodes = u32(sourceNodes.size());
-        u32 sourceNodeIndex = 0;
-
-        while (sourceNodeIndex < numberOfSourceNodes)
+        constexpr u32 OPERATOR_LEVEL_COUNT = 5;
+        constexpr u32 OPERATOR_LEVEL_NONE = OPERATOR_LEVEL_COUNT;
+
+        /**
+         * Binding level of the binary operators, the lower level binds tighter and every
+         *      level is left associative.
+         */
+        u32 GetOperatorLevel(const Ref<Node> &node)
         {
-            const Ref<Node> &currentNode = sourceNodes[sourceNodeIndex];
-
-            if (currentNode->GetType() != NodeType::ATOMIC)
+            if (node->GetType() != NodeType::ATOMIC)
             {
-                outNodes.push_back(currentNode);
-                sourceNodeIndex++;
-                continue;
+                return OPERATOR_LEVEL_NONE;
             }
 
-            Atomic *atomicNode = dynamic_cast<Atomic *>(currentNode.get());
-            const Token &currentNodeToken = atomicNode->GetToken();
-
-            if (currentNodeToken.GetType() != TokenType::OPERATOR ||
-                operators.find(currentNodeToken.GetValue<String>()) == operators.end())
+            const Token &token = static_cast<Atomic *>(node.get())->GetToken();
+            if (token.GetType() != TokenType::OPERATOR)
             {
-                outNodes.push_back(currentNode);
-                sourceNodeIndex++;
-                continue;
+                return OPERATOR_LEVEL_NONE;
             }
 
-            if (sourceNodeIndex + 1 >= numberOfSourceNodes)
+            switch (token.GetSymbol())
             {
-                Ref<Node> newUnaryNode = CreateRef<UnaryOperationNode>(
-                    currentNode, CreateRef<InvalidNode>());
-                newUnaryNode->AddError(ErrorType::MISSING_RIGHT_OPERAND);
-                outNodes.push_back(newUnaryNode);
-                sourceNodeIndex++;
-                continue;
+            case Symbol::EQUAL:
+            case Symbol::NOT_EQUAL:
+            case Symbol::LESS:
+            case Symbol::LESS_EQUAL:
+            case Symbol::GREATER:
+            case Symbol::GREATER_EQUAL:
+                return 0;
+            case Symbol::CARET:
+                return 1;
+            case Symbol::MULTIPLY:
+            case Symbol::DIVIDE:
+                return 2;
+            case Symbol::PLUS:
+            case Symbol::MINUS:
+                return 3;
+            case Symbol::ASSIGN:
+                return 4;
+            default:
+                return OPERATOR_LEVEL_NONE;
             }
+        }
 
-            const Ref<Node> &operandNode = sourceNodes[sourceNodeIndex + 1];
+        b8 IsOperatorAtomic(const Ref<Node> &node)
+        {
+            return node->GetType() == NodeType::ATOMIC &&
+                   static_cast<Atomic *>(node.get())->GetToken().GetType() == TokenType::OPERATOR;
+        }
 
-            if (operandNode->GetType() == NodeType::ATOMIC)
-            {
-                const Token &operandToken = static_cast<Atomic *>(operandNode.get())->GetToken();
+        b8 IsNotOperator(const Ref<Node> &node)
+        {
+            return IsOperatorAtomic(node) &&
+                   static_cast<Atomic *>(node.get())->GetToken().GetSymbol() == Symbol::NOT;
+        }
 
-                if (operandToken.GetType() == TokenType::OPERATOR &&
-                    operators.find(currentNodeToken.GetValue<String>()) != operators.end())
-                {
-                    outNodes.push_back(currentNode);
-                    sourceNodeIndex++;
-                    continue;
-                }
-            }
-            else if (operandNode->GetType() == NodeType::EXPRESSION)
-            {
-            }
-            else if (operandNode->GetType() == NodeType::UNARY_OPERATION)
+        b8 IsAssignAtomic(const Ref<Node> &node)
+        {
+            return IsOperatorAtomic(node) &&
+                   static_cast<Atomic *>(node.get())->GetToken().GetSymbol() == Symbol::ASSIGN;
+        }
+
+        /**
+         * Whether a `!` directly followed by this node takes it as its operand.
+         */
+        b8 IsUnaryOperandNode(const Ref<Node> &node)
+        {
+            if (node->GetType() == NodeType::ATOMIC)
             {
+                return !IsOperatorAtomic(node);
             }
-            else if (operandNode->GetType() == NodeType::BLOCK)
+
+            return node->GetType() == NodeType::EXPRESSION ||
+                   node->GetType() == NodeType::UNARY_OPERATION;
+        }
+
+        /**
+         * Builds the unary and the binary operations of a node list in a single pass.
+         *
+         * The nodes go through the `!` stage and then through one stage per binary level,
+         *      from the tightest to the loosest. A stage keeps only the last node it has
+         *      produced (a following operator of its level may take it as the left operand)
+         *      and the operator which is waiting for its right operand, everything else
+         *      is forwarded to the next stage right away.
+         */
+        class OperationParser
+        {
+        public:
+            OperationParser(AstArena *arena, Vector<Ref<Node>> &outNodes)
+                : m_arena(arena), m_outNodes(outNodes), m_nestUnterminatedNots(NTT_FALSE)
             {
-                Ref<Node> newUnaryNode = CreateRef<UnaryOperationNode>(
-                    currentNode, CreateRef<InvalidNode>());
-                newUnaryNode->AddError(ErrorType::MISSING_RIGHT_OPERAND);
-                outNodes.push_back(newUnaryNode);
-                sourceNodeIndex++;
-                continue;
             }
-            else
+
+            void Parse(const Vector<Ref<Node>> &sourceNodes)
             {
-                outNodes.push_back(currentNode);
-                sourceNodeIndex++;
-                continue;
-            }
+                // a `!` without operand only takes the `!` before it as the parent if any
+                //      other `!` of the list has found its operand.
+                for (u32 nodeIndex = 0; nodeIndex + 1 < u32(sourceNodes.size()); nodeIndex++)
+                {
+                    if (IsNotOperator(sourceNodes[nodeIndex]) &&
+                        IsUnaryOperandNode(sourceNodes[nodeIndex + 1]))
+                    {
+                        m_nestUnterminatedNots = NTT_TRUE;
+                        break;
+                    }
+                }
 
-            Ref<Node> newUnaryNode = CreateRef<UnaryOperationNode>(currentNode, operandNode);
-            outNodes.push_back(newUnaryNode);
-            hasAnyChange = NTT_TRUE;
-            sourceNodeIndex += 2;
-        }
-    }
+                for (const auto &node : sourceNodes)
+                {
+                    PushUnary(node);
+                }
 
-    void BlockNode::ParseOperations(const Vector<Ref<Node>> &sourceNodes,
-                                    Vector<Ref<Node>> &outNodes,
-                                    b8 &hasAnyChange,
-                                    const std::set<String> &operators)
-    {
-        NTT_ASSERT(outNodes.empty());
-        u32 numberOfSourceNodes = u32(sourceNodes.size());
-        u32 sourceNodeIndex = 0;
+                FlushNotOperators(NTT_NULL);
 
-        while (sourceNodeIndex < numberOfSourceNodes)
-        {
-            const Ref<Node> &currentNode = sourceNodes[sourceNodeIndex];
+                for (u32 level = 0; level < OPERATOR_LEVEL_COUNT; level++)
+                {
+                    LevelState &state = m_levels[level];
+                    if (state.pendingOperator != NTT_NULL)
+                    {
+                        state.lastNode = CreateOperation(state, NTT_NULL);
+                    }
 
-            if (currentNode->GetType() != NodeType::ATOMIC)
-            {
-                outNodes.push_back(currentNode);
-                sourceNodeIndex++;
-                continue;
+                    if (state.lastNode != NTT_NULL)
+                    {
+                        PushBinary(level + 1, state.lastNode);
+                        state.lastNode = NTT_NULL;
+                    }
+                }
             }
 
-            Atomic *atomicNode = dynamic_cast<Atomic *>(currentNode.get());
-            const Token &currentNodeToken = atomicNode->GetToken();
+        private:
+            struct LevelState
+            {
+                Ref<Node> lastNode;
+                Ref<Node> pendingOperator;
+                Ref<Node> pendingLeftOperand;
+            };
 
-            if (currentNodeToken.GetType() != TokenType::OPERATOR ||
-                operators.find(currentNodeToken.GetValue<String>()) == operators.end())
+            void PushUnary(const Ref<Node> &node)
             {
-                outNodes.push_back(currentNode);
-                sourceNodeIndex++;
-                continue;
-            }
+                if (IsNotOperator(node))
+                {
+                    m_notOperators.push_back(node);
+                    return;
+                }
 
-            Ref<Node> leftOperandNode = NTT_NULL;
-            Ref<Node> rightOperandNode = NTT_NULL;
-            u8 moveIndexSteps = 0;
-            Vector<ErrorType> errors;
+                if (m_notOperators.empty())
+                {
+                    PushBinary(0, node);
+                    return;
+                }
 
-            if (outNodes.size() > 0)
-            {
-                leftOperandNode = outNodes.back();
-                outNodes.pop_back();
+                if (IsUnaryOperandNode(node))
+                {
+                    Ref<Node> operandNode = node;
+                    for (auto it = m_notOperators.rbegin(); it != m_notOperators.rend(); it++)
+                    {
+                        operandNode = CreateNode<UnaryOperationNode>(m_arena, *it, operandNode);
+                    }
+
+                    m_notOperators.clear();
+                    PushBinary(0, operandNode);
+                    return;
+                }
+
+                FlushNotOperators(node);
+                PushBinary(0, node);
             }
-            else
+
+            /**
+             * Outputs the `!` operators which have not found their operand, `nextNode` is
+             *      the node which stops them (null at the end of the list).
+             */
+            void FlushNotOperators(const Ref<Node> &nextNode)
             {
-                leftOperandNode = CreateRef<InvalidNode>();
-                errors.push_back(ErrorType::MISSING_LEFT_OPERAND);
+                if (m_notOperators.empty())
+                {
+                    return;
+                }
+
+                if (nextNode != NTT_NULL && nextNode->GetType() != NodeType::BLOCK)
+                {
+                    for (const auto &notOperator : m_notOperators)
+                    {
+                        PushBinary(0, notOperator);
+                    }
+
+                    m_notOperators.clear();
+                    return;
+                }
+
+                Ref<Node> operandNode = CreateNode<UnaryOperationNode>(
+                    m_arena, m_notOperators.back(), CreateNode<InvalidNode>(m_arena));
+                operandNode->AddError(ErrorType::MISSING_RIGHT_OPERAND);
+                m_notOperators.pop_back();
+
+                if (m_nestUnterminatedNots)
+                {
+                    for (auto it = m_notOperators.rbegin(); it != m_notOperators.rend(); it++)
+                    {
+                        operandNode = CreateNode<UnaryOperationNode>(m_arena, *it, operandNode);
+                    }
+                }
+                else
+                {
+                    for (const auto &notOperator : m_notOperators)
+                    {
+                        PushBinary(0, notOperator);
+                    }
+                }
+
+                m_notOperators.clear();
+                PushBinary(0, operandNode);
             }
 
-            if (sourceNodeIndex + 1 < numberOfSourceNodes &&
-                IsOperandValidNode(sourceNodes[sourceNodeIndex + 1]))
+            void PushBinary(u32 level, const Ref<Node> &node)
             {
-                rightOperandNode = sourceNodes[sourceNodeIndex + 1];
-                moveIndexSteps += 2;
+                if (level == OPERATOR_LEVEL_COUNT)
+                {
+                    m_outNodes.push_back(node);
+                    return;
+                }
+
+                LevelState &state = m_levels[level];
+
+                if (state.pendingOperator != NTT_NULL)
+                {
+                    if (IsOperandValidNode(node))
+                    {
+                        state.lastNode = CreateOperation(state, node);
+                        return;
+                    }
+
+                    // the node is not consumed, it is handled below as any other node.
+                    state.lastNode = CreateOperation(state, NTT_NULL);
+                }
+
+                if (GetOperatorLevel(node) == level)
+                {
+                    state.pendingOperator = node;
+                    state.pendingLeftOperand = state.lastNode;
+                    state.lastNode = NTT_NULL;
+                    return;
+                }
+
+                if (state.lastNode != NTT_NULL)
+                {
+                    PushBinary(level + 1, state.lastNode);
+                }
+
+                state.lastNode = node;
             }
-            else
+
+            Ref<Node> CreateOperation(LevelState &state, const Ref<Node> &rightOperandNode)
             {
-                rightOperandNode = CreateRef<InvalidNode>();
-                errors.push_back(ErrorType::MISSING_RIGHT_OPERAND);
-                moveIndexSteps += 1;
-            }
+                Vector<ErrorType> errors;
+                Ref<Node> leftOperandNode = state.pendingLeftOperand;
+                Ref<Node> rightNode = rightOperandNode;
 
-            Ref<Node> newOperation = CreateRef<OperationNode>(currentNode, leftOperandNode, rightOperandNode);
+                if (leftOperandNode == NTT_NULL)
+                {
+                    leftOperandNode = CreateNode<InvalidNode>(m_arena);
+                    errors.push_back(ErrorType::MISSING_LEFT_OPERAND);
+                }
 
-            for (const auto &error : errors)
-            {
-                newOperation->AddError(error);
+                if (rightNode == NTT_NULL)
+                {
+                    rightNode = CreateNode<InvalidNode>(m_arena);
+                    errors.push_back(ErrorType::MISSING_RIGHT_OPERAND);
+                }
+
+                Ref<Node> newOperation = CreateNode<OperationNode>(
+                    m_arena, state.pendingOperator, leftOperandNode, rightNode);
+
+                for (const auto &error : errors)
+                {
+                    newOperation->AddError(error);
+                }
+
+                state.pendingOperator = NTT_NULL;
+                state.pendingLeftOperand = NTT_NULL;
+                return newOperation;
             }
 
-            outNodes.push_back(newOperation);
-            hasAnyChange = NTT_TRUE;
-            sourceNodeIndex += moveIndexSteps;
+        private:
+            AstArena *m_arena;
+            Vector<Ref<Node>> &m_outNodes;
+            Vector<Ref<Node>> m_notOperators;
+            LevelState m_levels[OPERATOR_LEVEL_COUNT];
+            b8 m_nestUnterminatedNots;
+        };
+    } // namespace anonymous
+
+    void BlockNode::ParseOperations(const Vector<Ref<Node>> &sourceNodes,
+                                    Vector<Ref<Node>> &outNodes)
+    {
+        NTT_ASSERT(outNodes.empty());
+        outNodes.reserve(sourceNodes.size());
+
+        OperationParser parser(m_arena, outNodes);
+        parser.Parse(sourceNodes);
+    }
+
+    /**
+     * @return The first token of an atomic or of a block built from tokens.
+     */
+    static const Atomic *GetFirstAtomicOf(const Node *node)
+    {
+        if (const Atomic *atomicNode = NodeCast<Atomic>(node))
+        {
+            return atomicNode;
         }
+
+        const BlockNode *blockNode = NodeCast<BlockNode>(node);
+        return blockNode != NTT_NULL ? blockNode->GetFirstAtomic() : NTT_NULL;
     }
 
     void BlockNode::ParseStatements(const Vector<Ref<Node>> &sourceNodes,
@@ -525,7 +797,8 @@ namespace ntt
             {
                 if (currentStatementNodes.size() != 0)
                 {
-                    Ref<Node> newTemporaryBlock = CreateRef<BlockNode>(NodeType::STATEMENT, currentStatementNodes);
+                    Ref<BlockNode> newTemporaryBlock = CreateBlock(NodeType::STATEMENT, currentStatementNodes);
+                    newTemporaryBlock->m_firstAtomic = GetFirstAtomicOf(currentStatementNodes[0].get());
                     outNodes.push_back(newTemporaryBlock);
                     currentStatementNodes.clear();
                 }
@@ -544,11 +817,11 @@ namespace ntt
                 continue;
             }
 
-            Atomic *atomicNode = dynamic_cast<Atomic *>(currentNode.get());
+            Atomic *atomicNode = NodeCast<Atomic>(currentNode.get());
             const Token &currentNodeToken = atomicNode->GetToken();
 
             if (currentNodeToken.GetType() != TokenType::DELIMITER ||
-                currentNodeToken.GetValue<String>() != ";")
+                currentNodeToken.GetSymbol() != Symbol::SEMICOLON)
             {
                 currentStatementNodes.push_back(currentNode);
             }
@@ -556,7 +829,9 @@ namespace ntt
             {
                 if (currentStatementNodes.size() != 0)
                 {
-                    Ref<Node> newTemporaryBlock = CreateRef<BlockNode>(NodeType::STATEMENT, currentStatementNodes);
+                    Ref<BlockNode> newTemporaryBlock = CreateBlock(NodeType::STATEMENT, currentStatementNodes);
+                    newTemporaryBlock->m_firstAtomic = GetFirstAtomicOf(currentStatementNodes[0].get());
+                    newTemporaryBlock->m_lastAtomic = atomicNode;
                     outNodes.push_back(newTemporaryBlock);
                     currentStatementNodes.clear();
                 }
@@ -567,7 +842,8 @@ namespace ntt
 
         if (currentStatementNodes.size() != 0)
         {
-            Ref<Node> newTemporaryBlock = CreateRef<BlockNode>(NodeType::STATEMENT, currentStatementNodes);
+            Ref<BlockNode> newTemporaryBlock = CreateBlock(NodeType::STATEMENT, currentStatementNodes);
+            newTemporaryBlock->m_firstAtomic = GetFirstAtomicOf(currentStatementNodes[0].get());
             newTemporaryBlock->AddError(ErrorType::MISSING_SEMICOLON);
             outNodes.push_back(newTemporaryBlock);
             currentStatementNodes.clear();
@@ -592,11 +868,11 @@ namespace ntt
                 continue;
             }
 
-            Atomic *atomicNode = dynamic_cast<Atomic *>(currentNode.get());
+            Atomic *atomicNode = NodeCast<Atomic>(currentNode.get());
             const Token &currentNodeToken = atomicNode->GetToken();
 
             if (currentNodeToken.GetType() != TokenType::KEYWORD ||
-                currentNodeToken.GetValue<String>() != "if")
+                currentNodeToken.GetSymbol() != Symbol::IF)
             {
                 outNodes.push_back(currentNode);
                 sourceNodeIndex++;
@@ -604,9 +880,9 @@ namespace ntt
             }
 
             Ref<Node> conditionNode = NTT_NULL;
-            Ref<Node> blockNode = CreateRef<BlockNode>(NodeType::BLOCK, Vector<Ref<Node>>{});
+            Ref<Node> blockNode = CreateBlock(NodeType::BLOCK, Vector<Ref<Node>>{});
             Ref<Node> elseNode = NTT_NULL;
-            Ref<Node> elseBlockNode = CreateRef<BlockNode>(NodeType::BLOCK, Vector<Ref<Node>>{});
+            Ref<Node> elseBlockNode = CreateBlock(NodeType::BLOCK, Vector<Ref<Node>>{});
             Vector<ErrorType> errors;
 
             u32 tempIndex = sourceNodeIndex + 1;
@@ -619,7 +895,7 @@ namespace ntt
             }
             else
             {
-                conditionNode = CreateRef<InvalidNode>();
+                conditionNode = CreateNode<InvalidNode>(m_arena);
                 errors.push_back(ErrorType::MISSING_CONDITION);
             }
 
@@ -637,11 +913,11 @@ namespace ntt
             if (tempIndex < numberOfSourceNodes &&
                 sourceNodes[tempIndex]->GetType() == NodeType::ATOMIC)
             {
-                Atomic *elseAtomicNode = dynamic_cast<Atomic *>(sourceNodes[tempIndex].get());
+                Atomic *elseAtomicNode = NodeCast<Atomic>(sourceNodes[tempIndex].get());
                 const Token &elseToken = elseAtomicNode->GetToken();
 
                 if (elseToken.GetType() == TokenType::KEYWORD &&
-                    elseToken.GetValue<String>() == "else")
+                    elseToken.GetSymbol() == Symbol::ELSE)
                 {
                     tempIndex++;
                     elseNode = sourceNodes[tempIndex];
@@ -655,8 +931,8 @@ namespace ntt
                             tempIndex++;
                         }
                         else if (sourceNodes[tempIndex]->GetType() == NodeType::ATOMIC &&
-                                 dynamic_cast<Atomic *>(sourceNodes[tempIndex].get())->GetToken().GetType() == TokenType::KEYWORD &&
-                                 dynamic_cast<Atomic *>(sourceNodes[tempIndex].get())->GetToken().GetValue<String>() == "if")
+                                 NodeCast<Atomic>(sourceNodes[tempIndex].get())->GetToken().GetType() == TokenType::KEYWORD &&
+                                 NodeCast<Atomic>(sourceNodes[tempIndex].get())->GetToken().GetSymbol() == Symbol::IF)
                         {
                             for (u32 i = sourceNodeIndex; i < tempIndex; i++)
                             {
@@ -670,7 +946,7 @@ namespace ntt
                 }
             }
 
-            Ref<Node> newIfNode = CreateRef<IfStatementNode>(conditionNode, blockNode, elseBlockNode);
+            Ref<Node> newIfNode = CreateNode<IfStatementNode>(m_arena, conditionNode, blockNode, elseBlockNode);
             for (const auto &error : errors)
             {
                 newIfNode->AddError(error);
@@ -701,7 +977,7 @@ namespace ntt
                 continue;
             }
 
-            Atomic *atomicNode = dynamic_cast<Atomic *>(currentNode.get());
+            Atomic *atomicNode = NodeCast<Atomic>(currentNode.get());
             const Token &currentNodeToken = atomicNode->GetToken();
 
             if (currentNodeToken.GetType() != TokenType::IDENTIFIER)
@@ -728,9 +1004,9 @@ namespace ntt
                 continue;
             }
 
-            Ref<BlockNode> argumentsBlockNode = std::dynamic_pointer_cast<BlockNode>(argumentsNode);
+            Ref<BlockNode> argumentsBlockNode = NodeCast<BlockNode>(argumentsNode);
 
-            Ref<Node> functionCallNode = CreateRef<FunctionCallNode>(currentNode, argumentsBlockNode->GetChildren());
+            Ref<Node> functionCallNode = CreateNode<FunctionCallNode>(m_arena, currentNode, argumentsBlockNode->GetChildren());
             if (argumentsBlockNode->HasErrors())
             {
                 for (const auto &error : argumentsBlockNode->GetErrors())
@@ -773,12 +1049,12 @@ namespace ntt
                 continue;
             }
 
-            Atomic *atomicNode = dynamic_cast<Atomic *>(currentNode.get());
+            Atomic *atomicNode = NodeCast<Atomic>(currentNode.get());
             const Token &currentNodeToken = atomicNode->GetToken();
             Vector<ErrorType> errors;
 
             if (currentNodeToken.GetType() != TokenType::DELIMITER ||
-                currentNodeToken.GetValue<String>() != ",")
+                currentNodeToken.GetSymbol() != Symbol::COMMA)
             {
                 temporaryNodes.push_back(currentNode);
                 sourceNodeIndex++;
@@ -802,7 +1078,7 @@ namespace ntt
                 continue;
             }
 
-            Ref<Node> newExpressionNode = CreateRef<BlockNode>(NodeType::EXPRESSION, temporaryNodes);
+            Ref<Node> newExpressionNode = CreateBlock(NodeType::EXPRESSION, temporaryNodes);
             for (const auto &error : errors)
             {
                 this->AddError(error);
@@ -819,13 +1095,13 @@ namespace ntt
         }
         else if (temporaryNodes.size() > 1)
         {
-            Ref<Node> newExpressionNode = CreateRef<BlockNode>(NodeType::EXPRESSION, temporaryNodes);
+            Ref<Node> newExpressionNode = CreateBlock(NodeType::EXPRESSION, temporaryNodes);
             outNodes.push_back(newExpressionNode);
             temporaryNodes.clear();
         }
     }
 
-    static Ref<Node> CreateDefaultNodeForType(const String &type);
+    static Ref<Node> CreateDefaultNodeForType(AstArena *arena, Symbol type);
 
     void BlockNode::ParseVariableDeifinition(const Vector<Ref<Node>> &sourceNodes,
                                              Vector<Ref<Node>> &outNodes, b8 &contain)
@@ -848,7 +1124,7 @@ namespace ntt
             return;
         }
 
-        Atomic *atomicNode = dynamic_cast<Atomic *>(defintTypeNode.get());
+        Atomic *atomicNode = NodeCast<Atomic>(defintTypeNode.get());
         const Token &currentNodeToken = atomicNode->GetToken();
 
         if (currentNodeToken.GetType() != TokenType::KEYWORD)
@@ -857,8 +1133,8 @@ namespace ntt
             return;
         }
 
-        if (currentNodeToken.GetValue<String>() != "let" &&
-            currentNodeToken.GetValue<String>() != "const")
+        if (currentNodeToken.GetSymbol() != Symbol::LET &&
+            currentNodeToken.GetSymbol() != Symbol::CONST)
         {
             contain = NTT_FALSE;
             return;
@@ -889,66 +1165,111 @@ namespace ntt
         {
             Token token(TokenType::NONE, 0);
             token.SetValue<String>("any");
-            typeNode = CreateRef<Atomic>(NodeType::ATOMIC, token);
+            typeNode = CreateNode<Atomic>(m_arena, NodeType::ATOMIC, token);
         }
 
         Ref<Node> defaultValueNode = NTT_NULL;
 
-        if (sourceNodeIndex < numberOfSourceNodes)
+        if (sourceNodeIndex < numberOfSourceNodes && IsAssignAtomic(sourceNodes[sourceNodeIndex]))
+        {
+            // the initializer is everything after the `=`, it goes through the same stages
+            //      as the rest of a statement and must end as a single node.
+            Vector<Ref<Node>> initializerNodes(sourceNodes.begin() + sourceNodeIndex + 1, sourceNodes.end());
+            Vector<Ref<Node>> parsedInitializerNodes;
+            if (!initializerNodes.empty())
+            {
+                ParseOperations(initializerNodes, parsedInitializerNodes);
+            }
+
+            b8 hasAnyModified = !parsedInitializerNodes.empty();
+            while (hasAnyModified)
+            {
+                hasAnyModified = NTT_FALSE;
+                Vector<Ref<Node>> newerParsedNodes;
+                ParseFunctionCall(parsedInitializerNodes, newerParsedNodes, hasAnyModified);
+                parsedInitializerNodes = std::move(newerParsedNodes);
+            }
+
+            if (parsedInitializerNodes.size() == 1)
+            {
+                defaultValueNode = parsedInitializerNodes[0];
+            }
+            else
+            {
+                this->AddError(parsedInitializerNodes.empty() ? ErrorType::MISSING_DEFAULT_VALUE
+                                                              : ErrorType::INVALID_DEFAULT_VALUE);
+                defaultValueNode = CreateDefaultNodeForType(m_arena, Symbol::ANY);
+            }
+
+            sourceNodeIndex = numberOfSourceNodes;
+        }
+        else if (sourceNodeIndex < numberOfSourceNodes)
         {
             defaultValueNode = sourceNodes[sourceNodeIndex];
             sourceNodeIndex++;
         }
         else
         {
-            defaultValueNode = CreateDefaultNodeForType(dynamic_cast<Atomic *>(typeNode.get())->GetToken().GetValue<String>());
+            defaultValueNode = CreateDefaultNodeForType(m_arena, NodeCast<Atomic>(typeNode.get())->GetToken().GetSymbol());
         }
 
-        Ref<Node> variableDefinitionNode = CreateRef<VariableDefinitionNode>(defintTypeNode, variableNameNode, typeNode, defaultValueNode);
+        Ref<Node> variableDefinitionNode = CreateNode<VariableDefinitionNode>(m_arena, defintTypeNode, variableNameNode, typeNode, defaultValueNode);
         outNodes.push_back(variableDefinitionNode);
     }
 
-    static Ref<Node> CreateDefaultNodeForType(const String &type)
+    static Ref<Node> CreateDefaultNodeForType(AstArena *arena, Symbol type)
     {
-        if (type == "number")
+        switch (type)
+        {
+        case Symbol::NUMBER:
         {
             Token floatToken(TokenType::FLOAT, 0);
             floatToken.SetValue<float>(0.0f);
-            return CreateRef<Atomic>(NodeType::ATOMIC, floatToken);
+            return CreateNode<Atomic>(arena, NodeType::ATOMIC, floatToken);
         }
-        else if (type == "string")
+        case Symbol::STRING:
         {
             Token stringToken(TokenType::STRING, 0);
             stringToken.SetValue<String>("");
-            return CreateRef<Atomic>(NodeType::ATOMIC, stringToken);
+            return CreateNode<Atomic>(arena, NodeType::ATOMIC, stringToken);
         }
-        else if (type == "boolean")
+        case Symbol::BOOLEAN:
         {
             Token booleanToken(TokenType::BOOLEAN, NTT_FALSE);
             booleanToken.SetValue<b8>(NTT_FALSE);
-            return CreateRef<Atomic>(NodeType::ATOMIC, booleanToken);
+            return CreateNode<Atomic>(arena, NodeType::ATOMIC, booleanToken);
         }
-        else if (type == "any")
+        case Symbol::ANY:
         {
             Token noneToken(TokenType::NONE, 0);
             noneToken.SetValue<String>("any");
-            return CreateRef<Atomic>(NodeType::ATOMIC, noneToken);
+            return CreateNode<Atomic>(arena, NodeType::ATOMIC, noneToken);
         }
-        else
-        {
+        default:
             NTT_ASSERT_MSG(false, "No default node for type");
             return NTT_NULL;
         }
     }
 
+    Ref<BlockNode> BlockNode::CreateBlock(NodeType type, const Vector<Ref<Node>> &children) const
+    {
+        Ref<BlockNode> blockNode = CreateNode<BlockNode>(m_arena, type, children);
+        blockNode->m_arenaOwner = m_arenaOwner;
+        blockNode->m_arena = m_arena;
+        return blockNode;
+    }
+
     void BlockNode::TokenizeContent()
     {
         Tokenizer tokenizer(m_content);
-        Vector<Token> tokens = tokenizer.GetTokens();
+        const TokenBuffer &tokens = tokenizer.GetTokenBuffer();
+        m_source = tokenizer.GetSource();
+        m_arena->SetSource(m_source);
+        m_children.reserve(tokens.GetSize());
 
-        for (const auto &token : tokens)
+        for (u32 tokenIndex = 0; tokenIndex < tokens.GetSize(); tokenIndex++)
         {
-            m_children.push_back(CreateRef<Atomic>(NodeType::ATOMIC, token));
+            m_children.push_back(CreateNode<Atomic>(m_arena, NodeType::ATOMIC, tokens.GetToken(tokenIndex)));
         }
     }
 }
\ No newline at end of file
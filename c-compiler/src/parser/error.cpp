@@ -19,6 +19,10 @@ namespace ntt
 
         case ErrorType::MISSING_VARIABLE_NAME:
             return "Missing variable name";
+        case ErrorType::MISSING_DEFAULT_VALUE:
+            return "Missing default value";
+        case ErrorType::INVALID_DEFAULT_VALUE:
+            return "Invalid default value";
 
         case ErrorType::MISSING_CONDITION:
             return "Missing condition";
@@ -26,6 +30,9 @@ namespace ntt
         case ErrorType::REDUNDANT_DELIMITER:
             return "Redundant delimiter";
 
+        case ErrorType::NUMBER_OUT_OF_RANGE:
+            return "Number out of range";
+
         case ErrorType::NO_ERROR:
             return "No error";
         default:
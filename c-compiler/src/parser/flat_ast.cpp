@@ -0,0 +1,257 @@
+#include "parser/flat_ast.h"
+#include "parser/atomic.h"
+#include "parser/blockNode.h"
+#include "parser/invalid.h"
+#include "parser/operationNode.h"
+#include "parser/unaryOperationNode.h"
+#include "parser/if_statement.h"
+#include "parser/function_call.h"
+#include "parser/variable_definition_node.h"
+
+namespace ntt
+{
+    namespace
+    {
+        void GetChildren(const Node &node, Vector<const Node *> &outChildren)
+        {
+            switch (node.GetType())
+            {
+            case NodeType::ATOMIC:
+            case NodeType::INVALID:
+                break;
+            case NodeType::OPERATION:
+            {
+                const OperationNode &operationNode = static_cast<const OperationNode &>(node);
+                outChildren.push_back(operationNode.GetOperator().get());
+                outChildren.push_back(operationNode.GetLeftOperand().get());
+                outChildren.push_back(operationNode.GetRightOperand().get());
+                break;
+            }
+            case NodeType::UNARY_OPERATION:
+            {
+                const UnaryOperationNode &unaryNode = static_cast<const UnaryOperationNode &>(node);
+                outChildren.push_back(unaryNode.GetOperator().get());
+                outChildren.push_back(unaryNode.GetOperand().get());
+                break;
+            }
+            case NodeType::IF_STATEMENT:
+            {
+                const IfStatementNode &ifNode = static_cast<const IfStatementNode &>(node);
+                outChildren.push_back(ifNode.GetCondition().get());
+                outChildren.push_back(ifNode.GetBlock().get());
+                outChildren.push_back(ifNode.GetElseBlock().get());
+                break;
+            }
+            case NodeType::FUNCTION_CALL:
+            {
+                const FunctionCallNode &functionCallNode = static_cast<const FunctionCallNode &>(node);
+                outChildren.push_back(functionCallNode.GetFunction().get());
+                for (const auto &argument : functionCallNode.GetArguments())
+                {
+                    outChildren.push_back(argument.get());
+                }
+                break;
+            }
+            case NodeType::VARIABLE_DEFINITION_STATEMENT:
+            {
+                const VariableDefinitionNode &definitionNode = static_cast<const VariableDefinitionNode &>(node);
+                outChildren.push_back(definitionNode.GetDefineType().get());
+                outChildren.push_back(definitionNode.GetName().get());
+                outChildren.push_back(definitionNode.GetTypeNode().get());
+                if (definitionNode.GetDefaultValue() != NTT_NULL)
+                {
+                    outChildren.push_back(definitionNode.GetDefaultValue().get());
+                }
+                break;
+            }
+            default:
+                for (const auto &child : static_cast<const BlockNode &>(node).GetChildren())
+                {
+                    outChildren.push_back(child.get());
+                }
+                break;
+            }
+        }
+
+        struct FlattenFrame
+        {
+            const Node *node;
+            u32 numberOfChildren;
+            b8 isExpanded;
+        };
+    } // namespace anonymous
+
+    FlatAst::FlatAst(const Node &root)
+    {
+        if (const BlockNode *rootBlock = NodeCast<BlockNode>(&root))
+        {
+            m_tokens.SetSource(rootBlock->GetSource());
+        }
+
+        // iterative post-order walk, the indices of the flattened nodes wait in
+        //      `pendingNodes` until their parent is added.
+        Vector<FlattenFrame> frames = {{&root, 0, NTT_FALSE}};
+        Vector<u32> pendingNodes;
+        Vector<const Node *> children;
+
+        while (!frames.empty())
+        {
+            if (frames.back().isExpanded)
+            {
+                FlattenFrame frame = frames.back();
+                frames.pop_back();
+                AddNode(*frame.node, frame.numberOfChildren, pendingNodes);
+                continue;
+            }
+
+            children.clear();
+            GetChildren(*frames.back().node, children);
+            frames.back().isExpanded = NTT_TRUE;
+            frames.back().numberOfChildren = u32(children.size());
+
+            for (auto it = children.rbegin(); it != children.rend(); it++)
+            {
+                frames.push_back({*it, 0, NTT_FALSE});
+            }
+        }
+
+        NTT_ASSERT(pendingNodes.size() == 1);
+    }
+
+    FlatAst::~FlatAst()
+    {
+    }
+
+    u32 FlatAst::AddNode(const Node &node, u32 numberOfChildren, Vector<u32> &pendingNodes)
+    {
+        u32 nodeIndex = GetNodeCount();
+        NodeType kind = node.GetType();
+        m_kinds.push_back(kind);
+
+        m_childStarts.push_back(u32(m_childIndices.size()));
+        m_childCounts.push_back(numberOfChildren);
+        m_childIndices.insert(m_childIndices.end(), pendingNodes.end() - numberOfChildren, pendingNodes.end());
+        pendingNodes.resize(pendingNodes.size() - numberOfChildren);
+        pendingNodes.push_back(nodeIndex);
+
+        const Vector<ErrorType> &errors = node.GetErrors();
+        m_errorStarts.push_back(u32(m_errors.size()));
+        m_errorCounts.push_back(u32(errors.size()));
+        m_errors.insert(m_errors.end(), errors.begin(), errors.end());
+
+        if (kind == NodeType::ATOMIC)
+        {
+            m_payloads.push_back(m_tokens.GetSize());
+            m_tokens.Push(static_cast<const Atomic &>(node).GetToken());
+        }
+        else if (kind == NodeType::INVALID)
+        {
+            m_payloads.push_back(u32(m_invalidContents.size()));
+            m_invalidContents.push_back(static_cast<const InvalidNode &>(node).GetContent());
+        }
+        else
+        {
+            m_payloads.push_back(NO_INDEX);
+        }
+
+        return nodeIndex;
+    }
+
+    Vector<u32> FlatAst::CollectNodesWithErrors() const
+    {
+        Vector<u32> nodes;
+        for (u32 nodeIndex = 0; nodeIndex < GetNodeCount(); nodeIndex++)
+        {
+            if (m_errorCounts[nodeIndex] > 0)
+            {
+                nodes.push_back(nodeIndex);
+            }
+        }
+        return nodes;
+    }
+
+    JSON FlatAst::ToJSON() const
+    {
+        // the JSON of the children are the last values of the stack when their parent
+        //      is reached.
+        Vector<JSON> values;
+
+        for (u32 nodeIndex = 0; nodeIndex < GetNodeCount(); nodeIndex++)
+        {
+            u32 numberOfChildren = m_childCounts[nodeIndex];
+            u32 firstChild = u32(values.size()) - numberOfChildren;
+            JSON *children = values.data() + firstChild;
+
+            JSON errors = JSON::array();
+            for (u32 errorIndex = 0; errorIndex < m_errorCounts[nodeIndex]; errorIndex++)
+            {
+                errors.push_back(ErrorTypeToString(GetError(nodeIndex, errorIndex)));
+            }
+
+            JSON json;
+            switch (m_kinds[nodeIndex])
+            {
+            case NodeType::ATOMIC:
+                json["type"] = "Atomic";
+                json["token"] = m_tokens.GetToken(m_payloads[nodeIndex]).ToJSON();
+                break;
+            case NodeType::INVALID:
+                json["type"] = "InvalidNode";
+                json["content"] = m_invalidContents[m_payloads[nodeIndex]];
+                break;
+            case NodeType::OPERATION:
+                json["type"] = "OperationNode";
+                json["operator"] = std::move(children[0]);
+                json["leftOperand"] = std::move(children[1]);
+                json["rightOperand"] = std::move(children[2]);
+                break;
+            case NodeType::UNARY_OPERATION:
+                json["type"] = "UnaryOperationNode";
+                json["operator"] = std::move(children[0]);
+                json["operand"] = std::move(children[1]);
+                break;
+            case NodeType::IF_STATEMENT:
+                json["type"] = "IfStatementNode";
+                json["condition"] = std::move(children[0]);
+                json["block"] = std::move(children[1]);
+                json["elseBlock"] = std::move(children[2]);
+                break;
+            case NodeType::FUNCTION_CALL:
+                json["type"] = "FunctionCall";
+                json["function"] = std::move(children[0]);
+                json["arguments"] = JSON::array();
+                for (u32 childIndex = 1; childIndex < numberOfChildren; childIndex++)
+                {
+                    json["arguments"].push_back(std::move(children[childIndex]));
+                }
+                json["errors"] = std::move(errors);
+                break;
+            case NodeType::VARIABLE_DEFINITION_STATEMENT:
+                json["type"] = "VariableDefinitionNode";
+                json["defineType"] = std::move(children[0]);
+                json["name"] = std::move(children[1]);
+                // the type node replaces the "type" entry, as in the node tree output.
+                json["type"] = std::move(children[2]);
+                if (numberOfChildren > 3)
+                {
+                    json["defaultValue"] = std::move(children[3]);
+                }
+                break;
+            default:
+                json["type"] = NodeTypeToString(m_kinds[nodeIndex]);
+                json["children"] = JSON::array();
+                for (u32 childIndex = 0; childIndex < numberOfChildren; childIndex++)
+                {
+                    json["children"].push_back(std::move(children[childIndex]));
+                }
+                json["errors"] = std::move(errors);
+                break;
+            }
+
+            values.resize(firstChild);
+            values.push_back(std::move(json));
+        }
+
+        return values.empty() ? JSON() : std::move(values.back());
+    }
+} // namespace ntt
@@ -19,6 +19,11 @@ namespace ntt
     {
     }
 
+    void FunctionCallNode::Accept(NodeVisitor &visitor)
+    {
+        visitor.Visit(*this);
+    }
+
     JSON FunctionCallNode::ToJSON()
     {
         JSON json;
@@ -47,4 +47,9 @@ namespace ntt
             m_blockNode->Parse();
         }
     }
+
+    void IfStatementNode::Accept(NodeVisitor &visitor)
+    {
+        visitor.Visit(*this);
+    }
 } // namespace ntt
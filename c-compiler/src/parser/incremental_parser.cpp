@@ -0,0 +1,365 @@
+#include "parser/incremental_parser.h"
+#include "parser/if_statement.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ntt
+{
+    namespace
+    {
+        b8 IsSameToken(const Token &oldToken, const SourceFile &oldSource,
+                       const PackedToken &newToken, const SourceFile &newSource)
+        {
+            // the value of a token only depends on its text.
+            return oldToken.GetType() == newToken.GetType() &&
+                   oldToken.GetLength() == newToken.length &&
+                   std::memcmp(oldSource.GetData() + oldToken.GetStartIndex(),
+                               newSource.GetData() + newToken.startIndex,
+                               oldToken.GetLength()) == 0;
+        }
+
+        b8 IsBracket(const Token &token, Symbol symbol)
+        {
+            return token.GetType() == TokenType::BRACKET && token.GetSymbol() == symbol;
+        }
+
+        b8 IsKeyword(const Token &token, Symbol symbol)
+        {
+            return token.GetType() == TokenType::KEYWORD && token.GetSymbol() == symbol;
+        }
+    } // namespace anonymous
+
+    IncrementalParser::IncrementalParser(const String &content)
+        : m_tokenizer(content)
+    {
+        ParseAll();
+    }
+
+    IncrementalParser::~IncrementalParser()
+    {
+    }
+
+    void IncrementalParser::ParseAll()
+    {
+        const TokenBuffer &tokens = m_tokenizer.GetTokenBuffer();
+        Ref<AstArena> arena = CreateRef<AstArena>();
+
+        m_atomics.clear();
+        m_atomics.reserve(tokens.GetSize());
+        for (u32 tokenIndex = 0; tokenIndex < tokens.GetSize(); tokenIndex++)
+        {
+            m_atomics.push_back(arena->Create<Atomic>(NodeType::ATOMIC, tokens.GetToken(tokenIndex)));
+        }
+
+        m_program = CreateRef<BlockNode>(NodeType::PROGRAM, Vector<Ref<Node>>(m_atomics.begin(), m_atomics.end()));
+        m_program->m_arenaOwner = arena;
+        m_program->m_arena = arena.get();
+        m_program->m_source = m_tokenizer.GetSource();
+        arena->SetSource(m_program->m_source);
+        m_program->Compress();
+        m_program->Parse();
+
+        m_numberOfParsedObjects = arena->GetObjectCount();
+        m_lastReparsedNode = m_program.get();
+    }
+
+    void IncrementalParser::ApplyEdit(u32 offset, u32 removedLength, const String &insertedText)
+    {
+        // the candidates are found with the positions from before the edit.
+        Vector<ReparseCandidate> candidates;
+        CollectCandidates(m_program.get(), NTT_TRUE, offset, offset + removedLength, candidates);
+
+        Ref<SourceFile> oldSource = m_tokenizer.GetSource();
+        TokenEdit edit = m_tokenizer.ApplyEdit(offset, removedLength, insertedText);
+        const TokenBuffer &tokens = m_tokenizer.GetTokenBuffer();
+        const SourceFile &source = *m_tokenizer.GetSource();
+
+        // the lexer also returns some unchanged tokens around the edit, they keep their
+        //      atomics.
+        u32 changedStart = edit.firstToken;
+        u32 oldChangedEnd = edit.firstToken + edit.numberOfRemovedTokens;
+        u32 newChangedEnd = edit.firstToken + edit.numberOfInsertedTokens;
+
+        while (changedStart < oldChangedEnd && changedStart < newChangedEnd &&
+               IsSameToken(m_atomics[changedStart]->GetToken(), *oldSource, tokens[changedStart], source))
+        {
+            changedStart++;
+        }
+
+        while (oldChangedEnd > changedStart && newChangedEnd > changedStart &&
+               IsSameToken(m_atomics[oldChangedEnd - 1]->GetToken(), *oldSource, tokens[newChangedEnd - 1], source))
+        {
+            oldChangedEnd--;
+            newChangedEnd--;
+        }
+
+        AstArena *arena = m_program->m_arena;
+        if (arena->GetObjectCount() > 2 * m_numberOfParsedObjects)
+        {
+            ParseAll();
+            return;
+        }
+
+        // a statement is only parsed alone when the brackets around it stay the same.
+        b8 isAnyBracketChanged = NTT_FALSE;
+        for (u32 tokenIndex = changedStart; tokenIndex < oldChangedEnd; tokenIndex++)
+        {
+            isAnyBracketChanged |= m_atomics[tokenIndex]->GetToken().GetType() == TokenType::BRACKET;
+        }
+        for (u32 tokenIndex = changedStart; tokenIndex < newChangedEnd; tokenIndex++)
+        {
+            isAnyBracketChanged |= tokens[tokenIndex].GetType() == TokenType::BRACKET;
+        }
+
+        u32 numberOfRemovedAtomics = oldChangedEnd - changedStart;
+        u32 numberOfInsertedAtomics = newChangedEnd - changedStart;
+        u32 numberOfReplacedAtomics = std::min(numberOfRemovedAtomics, numberOfInsertedAtomics);
+
+        for (u32 tokenIndex = changedStart; tokenIndex < changedStart + numberOfReplacedAtomics; tokenIndex++)
+        {
+            m_atomics[tokenIndex] = arena->Create<Atomic>(NodeType::ATOMIC, tokens.GetToken(tokenIndex));
+        }
+
+        if (numberOfRemovedAtomics > numberOfInsertedAtomics)
+        {
+            m_atomics.erase(m_atomics.begin() + changedStart + numberOfReplacedAtomics,
+                            m_atomics.begin() + oldChangedEnd);
+        }
+        else
+        {
+            Vector<Ref<Atomic>> insertedAtomics;
+            for (u32 tokenIndex = changedStart + numberOfReplacedAtomics; tokenIndex < newChangedEnd; tokenIndex++)
+            {
+                insertedAtomics.push_back(arena->Create<Atomic>(NodeType::ATOMIC, tokens.GetToken(tokenIndex)));
+            }
+            m_atomics.insert(m_atomics.begin() + oldChangedEnd, insertedAtomics.begin(), insertedAtomics.end());
+        }
+
+        for (u32 tokenIndex = 0; tokenIndex < u32(m_atomics.size()); tokenIndex++)
+        {
+            if (tokenIndex < changedStart || tokenIndex >= newChangedEnd)
+            {
+                m_atomics[tokenIndex]->Rebase(tokens[tokenIndex].startIndex, source);
+            }
+        }
+
+        m_program->m_source = m_tokenizer.GetSource();
+        arena->SetSource(m_program->m_source);
+
+        if (changedStart == oldChangedEnd && changedStart == newChangedEnd)
+        {
+            // only the spaces changed, the tree is the same.
+            m_lastReparsedNode = NTT_NULL;
+            return;
+        }
+
+        u32 tokenShift = newChangedEnd - oldChangedEnd;
+
+        for (auto it = candidates.rbegin(); it != candidates.rend(); it++)
+        {
+            b8 isStatement = it->block->GetType() == NodeType::STATEMENT;
+
+            // the first token of a statement may change, the brackets of a block may not and
+            //      neither may the semicolon of a statement.
+            if (changedStart < it->firstToken + (isStatement ? 0 : 1) || oldChangedEnd > it->lastToken ||
+                (isStatement && isAnyBracketChanged))
+            {
+                continue;
+            }
+
+            u32 lastToken = it->lastToken + tokenShift;
+            b8 isReparsed = isStatement
+                                ? ReparseStatement(*it, lastToken)
+                                : ReparseBlock(*it, lastToken);
+
+            if (isReparsed)
+            {
+                return;
+            }
+        }
+
+        ParseAll();
+    }
+
+    void IncrementalParser::CollectCandidates(BlockNode *block, b8 isParsedOnce, u32 editStart, u32 editEnd,
+                                              Vector<ReparseCandidate> &outCandidates) const
+    {
+        for (const auto &child : block->GetChildren())
+        {
+            BlockNode *statement = NodeCast<BlockNode>(child.get());
+
+            if (statement != NTT_NULL &&
+                statement->GetType() == NodeType::STATEMENT &&
+                statement->GetFirstAtomic() != NTT_NULL &&
+                statement->GetLastAtomic() != NTT_NULL)
+            {
+                if (editStart >= statement->GetFirstAtomic()->GetToken().GetStartIndex() &&
+                    editEnd <= statement->GetLastAtomic()->GetToken().GetStartIndex())
+                {
+                    // the statements are parsed again each time their block is parsed.
+                    outCandidates.push_back({statement,
+                                             FindAtomicIndex(statement->GetFirstAtomic()),
+                                             FindAtomicIndex(statement->GetLastAtomic()),
+                                             isParsedOnce});
+                    return;
+                }
+                continue;
+            }
+
+            u32 numberOfCandidates = u32(outCandidates.size());
+            CollectBlockCandidates(child, NTT_FALSE, editStart, editEnd, outCandidates);
+            if (outCandidates.size() > numberOfCandidates)
+            {
+                return;
+            }
+        }
+    }
+
+    void IncrementalParser::CollectBlockCandidates(const Ref<Node> &node, b8 isParsedOnce, u32 editStart, u32 editEnd,
+                                                   Vector<ReparseCandidate> &outCandidates) const
+    {
+        if (IfStatementNode *ifNode = NodeCast<IfStatementNode>(node.get()))
+        {
+            // an if statement does not parse its else block, which is then only parsed
+            //      once before the if statement is built.
+            CollectBlockCandidates(ifNode->GetBlock(), isParsedOnce, editStart, editEnd, outCandidates);
+            CollectBlockCandidates(ifNode->GetElseBlock(), NTT_TRUE, editStart, editEnd, outCandidates);
+            return;
+        }
+
+        BlockNode *block = NodeCast<BlockNode>(node.get());
+        if (block == NTT_NULL ||
+            block->GetType() != NodeType::BLOCK ||
+            block->GetFirstAtomic() == NTT_NULL ||
+            block->GetLastAtomic() == NTT_NULL)
+        {
+            return;
+        }
+
+        if (editStart > block->GetFirstAtomic()->GetToken().GetStartIndex() &&
+            editEnd <= block->GetLastAtomic()->GetToken().GetStartIndex())
+        {
+            outCandidates.push_back({block,
+                                     FindAtomicIndex(block->GetFirstAtomic()),
+                                     FindAtomicIndex(block->GetLastAtomic()),
+                                     isParsedOnce});
+            CollectCandidates(block, isParsedOnce, editStart, editEnd, outCandidates);
+        }
+    }
+
+    u32 IncrementalParser::FindAtomicIndex(const Atomic *atomic) const
+    {
+        auto it = std::lower_bound(m_atomics.begin(), m_atomics.end(), atomic->GetToken().GetStartIndex(),
+                                   [](const Ref<Atomic> &current, u32 startIndex)
+                                   {
+                                       return current->GetToken().GetStartIndex() < startIndex;
+                                   });
+
+        NTT_ASSERT(it != m_atomics.end() && it->get() == atomic);
+        return u32(it - m_atomics.begin());
+    }
+
+    b8 IncrementalParser::ReparseBlock(const ReparseCandidate &candidate, u32 lastToken)
+    {
+        BlockNode &block = *candidate.block;
+        u32 firstToken = candidate.firstToken;
+
+        // the braces stay paired when the tokens between them are balanced.
+        u32 braceDepth = 0;
+        for (u32 tokenIndex = firstToken + 1; tokenIndex < lastToken; tokenIndex++)
+        {
+            const Token &token = m_atomics[tokenIndex]->GetToken();
+            if (IsBracket(token, Symbol::OPEN_BRACE))
+            {
+                braceDepth++;
+            }
+            else if (IsBracket(token, Symbol::CLOSE_BRACE))
+            {
+                if (braceDepth == 0)
+                {
+                    return NTT_FALSE;
+                }
+                braceDepth--;
+            }
+        }
+
+        if (braceDepth != 0)
+        {
+            return NTT_FALSE;
+        }
+
+        block.m_children.assign(m_atomics.begin() + firstToken + 1, m_atomics.begin() + lastToken);
+        block.ClearErrors();
+        block.Compress();
+        block.Parse();
+        if (!candidate.isParsedOnce)
+        {
+            block.Parse();
+        }
+
+        m_lastReparsedNode = &block;
+        return NTT_TRUE;
+    }
+
+    b8 IncrementalParser::ReparseStatement(const ReparseCandidate &candidate, u32 lastToken)
+    {
+        BlockNode &statement = *candidate.block;
+        u32 firstToken = candidate.firstToken;
+
+        Ref<BlockNode> fragment = m_program->CreateBlock(
+            NodeType::BLOCK,
+            Vector<Ref<Node>>(m_atomics.begin() + firstToken, m_atomics.begin() + lastToken + 1));
+        fragment->Compress();
+
+        // an if statement before the statement looks at its first node, the statement can
+        //      only be parsed alone when the new first node is one the if statement did
+        //      not take before.
+        const Ref<Node> &firstNode = fragment->GetChildren()[0];
+        if (const Atomic *firstAtomic = NodeCast<Atomic>(firstNode.get()))
+        {
+            if (IsKeyword(firstAtomic->GetToken(), Symbol::IF) ||
+                IsKeyword(firstAtomic->GetToken(), Symbol::ELSE))
+            {
+                return NTT_FALSE;
+            }
+        }
+        else if (firstNode->GetType() != NodeType::EXPRESSION ||
+                 !IsBracket(statement.GetFirstAtomic()->GetToken(), Symbol::OPEN_PARENTHESIS))
+        {
+            return NTT_FALSE;
+        }
+
+        fragment->Parse();
+
+        if (fragment->GetChildren().size() != 1)
+        {
+            return NTT_FALSE;
+        }
+
+        BlockNode *newStatement = NodeCast<BlockNode>(fragment->GetChildren()[0].get());
+        if (newStatement == NTT_NULL ||
+            newStatement->GetType() != NodeType::STATEMENT ||
+            newStatement->GetLastAtomic() == NTT_NULL)
+        {
+            return NTT_FALSE;
+        }
+
+        if (!candidate.isParsedOnce)
+        {
+            newStatement->Parse();
+            newStatement->Parse();
+        }
+
+        statement.m_children = newStatement->m_children;
+        statement.m_firstAtomic = newStatement->m_firstAtomic;
+        statement.m_lastAtomic = newStatement->m_lastAtomic;
+        statement.ClearErrors();
+        for (const auto &error : newStatement->GetErrors())
+        {
+            statement.AddError(error);
+        }
+
+        m_lastReparsedNode = &statement;
+        return NTT_TRUE;
+    }
+} // namespace ntt
@@ -26,4 +26,9 @@ namespace ntt
     void InvalidNode::Parse()
     {
     }
+
+    void InvalidNode::Accept(NodeVisitor &visitor)
+    {
+        visitor.Visit(*this);
+    }
 } // namespace ntt
@@ -31,7 +31,7 @@ namespace ntt
             return NTT_TRUE;
         }
 
-        Ref<Atomic> atomicNode = std::dynamic_pointer_cast<Atomic>(currentNode);
+        Ref<Atomic> atomicNode = NodeCast<Atomic>(currentNode);
         const Token &token = atomicNode->GetToken();
 
         b8 isMatched = m_pair.values.empty();
@@ -46,7 +46,7 @@ namespace ntt
             switch (token.GetType())
             {
             case TokenType::INTEGER:
-                if (token.GetValue<u32>() == value.GetValue<u32>())
+                if (token.GetValue<u64>() == value.GetValue<u64>())
                 {
                     isMatched = NTT_TRUE;
                 }
@@ -58,13 +58,20 @@ namespace ntt
                 }
                 break;
             case TokenType::FLOAT:
-                if (token.GetValue<f32>() == value.GetValue<f32>())
+                if (token.GetValue<f64>() == value.GetValue<f64>())
+                {
+                    isMatched = NTT_TRUE;
+                }
+                break;
+            case TokenType::STRING:
+            case TokenType::INVALID:
+                if (token.GetValue<std::string_view>() == value.GetValue<std::string_view>())
                 {
                     isMatched = NTT_TRUE;
                 }
                 break;
             default:
-                if (token.GetValue<String>() == value.GetValue<String>())
+                if (token.GetSymbol() == value.GetSymbol())
                 {
                     isMatched = NTT_TRUE;
                 }
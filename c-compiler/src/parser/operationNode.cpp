@@ -58,4 +58,9 @@ namespace ntt
             m_rightOperand->Parse();
         }
     }
+
+    void OperationNode::Accept(NodeVisitor &visitor)
+    {
+        visitor.Visit(*this);
+    }
 } // namespace ntt
@@ -29,4 +29,9 @@ namespace ntt
     {
         m_operator->Parse();
     }
+
+    void UnaryOperationNode::Accept(NodeVisitor &visitor)
+    {
+        visitor.Visit(*this);
+    }
 } // namespace ntt
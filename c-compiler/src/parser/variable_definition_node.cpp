@@ -70,4 +70,9 @@ namespace ntt
             m_defaultValue->Parse();
         }
     }
+
+    void VariableDefinitionNode::Accept(NodeVisitor &visitor)
+    {
+        visitor.Visit(*this);
+    }
 } // namespace ntt
@@ -0,0 +1,181 @@
+#include "bench_common.h"
+#include "tokenizer/tokenizer.h"
+#include "tokenizer/scan_kernels.h"
+#include "tokenizer/token_stream.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace ntt;
+
+static String CreateTokenizerInput()
+{
+    String content;
+    for (u32 lineIndex = 0; lineIndex < 5000; lineIndex++)
+    {
+        content += "let value : number = 3 + 4 * (2 - 1) / 5;\n";
+        content += "if (value >= 2) { print(\"value\", 12.5); }\n";
+    }
+    return content;
+}
+
+NTT_BENCHMARK(TokenizeProgram)
+{
+    String content = CreateTokenizerInput();
+    u64 numberOfTokens = 0;
+
+    while (state.KeepRunning())
+    {
+        Tokenizer tokenizer(content);
+        numberOfTokens = tokenizer.GetTokenBuffer().GetSize();
+    }
+
+    state.SetBytesPerIteration(content.size());
+    state.SetItemsPerIteration(numberOfTokens, "tokens");
+}
+
+/**
+ * Deeply indented code with long names, where most of the characters are in space and
+ *      identifier runs.
+ */
+static String CreateIndentedInput()
+{
+    String content;
+    for (u32 lineIndex = 0; lineIndex < 5000; lineIndex++)
+    {
+        content += "                                if (current_parsing_state >= maximum_parsing_depth) {\n";
+        content += "                                    accumulated_statement_count = accumulated_statement_count + 1234567;\n";
+        content += "                                }\n";
+    }
+    return content;
+}
+
+static void TokenizeWithScanKernels(BenchmarkState &state, const String &content, ScanKernelLevel level)
+{
+    ScanKernelLevel defaultLevel = GetScanKernelLevel();
+    SetScanKernelLevel(level);
+    u64 numberOfTokens = 0;
+
+    while (state.KeepRunning())
+    {
+        Tokenizer tokenizer(content);
+        numberOfTokens = tokenizer.GetTokenBuffer().GetSize();
+    }
+
+    SetScanKernelLevel(defaultLevel);
+
+    state.SetBytesPerIteration(content.size());
+    state.SetItemsPerIteration(numberOfTokens, "tokens");
+}
+
+/**
+ * The scanning kernels forced to the scalar loops, compare with TokenizeProgram and
+ *      TokenizeIndentedProgram which use the best kernels of the processor.
+ */
+NTT_BENCHMARK(TokenizeProgramScalarScan)
+{
+    TokenizeWithScanKernels(state, CreateTokenizerInput(), ScanKernelLevel::SCALAR);
+}
+
+NTT_BENCHMARK(TokenizeIndentedProgram)
+{
+    TokenizeWithScanKernels(state, CreateIndentedInput(), ScanKernelLevel::AVX2);
+}
+
+NTT_BENCHMARK(TokenizeIndentedProgramScalarScan)
+{
+    TokenizeWithScanKernels(state, CreateIndentedInput(), ScanKernelLevel::SCALAR);
+}
+
+/**
+ * Same input lexed on all the cores, compare with TokenizeProgram.
+ */
+NTT_BENCHMARK(TokenizeProgramParallel)
+{
+    Ref<SourceFile> source = CreateRef<SourceFile>(CreateTokenizerInput());
+    u64 numberOfTokens = 0;
+
+    while (state.KeepRunning())
+    {
+        Tokenizer tokenizer(source, 0);
+        numberOfTokens = tokenizer.GetTokenBuffer().GetSize();
+    }
+
+    state.SetBytesPerIteration(source->GetLength());
+    state.SetItemsPerIteration(numberOfTokens, "tokens");
+}
+
+/**
+ * Same input read from a mapped file, the text is lexed in place without any copy.
+ */
+NTT_BENCHMARK(TokenizeMappedFile)
+{
+    String content = CreateTokenizerInput();
+    String path = (std::filesystem::temp_directory_path() / "ntt_bench_source.txt").string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+
+    u64 numberOfTokens = 0;
+
+    while (state.KeepRunning())
+    {
+        Tokenizer tokenizer(SourceFile::MapFile(path));
+        numberOfTokens = tokenizer.GetTokenBuffer().GetSize();
+    }
+
+    std::remove(path.c_str());
+
+    state.SetBytesPerIteration(content.size());
+    state.SetItemsPerIteration(numberOfTokens, "tokens");
+}
+
+/**
+ * One keystroke in the middle of the program, typed then erased so the input keeps its
+ *      size between the iterations.
+ */
+NTT_BENCHMARK(ApplyEditToProgram)
+{
+    String content = CreateTokenizerInput();
+    Tokenizer tokenizer(content);
+    u32 offset = u32(content.size() / 2);
+    u32 iteration = 0;
+
+    while (state.KeepRunning())
+    {
+        if (iteration++ % 2 == 0)
+        {
+            tokenizer.ApplyEdit(offset, 0, "x");
+        }
+        else
+        {
+            tokenizer.ApplyEdit(offset, 1, "");
+        }
+    }
+
+    state.SetItemsPerIteration(1, "edits");
+}
+
+/**
+ * Same input pulled one token at a time, nothing is stored besides the lookahead.
+ */
+NTT_BENCHMARK(StreamTokensProgram)
+{
+    Ref<SourceFile> source = CreateRef<SourceFile>(CreateTokenizerInput());
+    u64 numberOfTokens = 0;
+
+    while (state.KeepRunning())
+    {
+        TokenStream stream(source);
+        numberOfTokens = 0;
+        while (!stream.IsAtEnd())
+        {
+            stream.Next();
+            numberOfTokens++;
+        }
+    }
+
+    state.SetBytesPerIteration(source->GetLength());
+    state.SetItemsPerIteration(numberOfTokens, "tokens");
+}
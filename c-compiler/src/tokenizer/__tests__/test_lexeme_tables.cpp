@@ -0,0 +1,47 @@
+#include "test_common.h"
+#include "tokenizer/lexeme_tables.h"
+#include <cstring>
+
+using namespace ntt;
+
+#define OPERATOR_MATCH_TESTING(input, expectLength, expectSymbol)                         \
+    {                                                                                     \
+        Symbol symbol = Symbol::NONE;                                                     \
+        EXPECT_EQ(MatchOperator(input, u32(strlen(input)), symbol), u32(expectLength))    \
+            << "Input = " << input;                                                       \
+        EXPECT_EQ(symbol, expectSymbol) << "Input = " << input;                           \
+    }
+
+TEST(LexemeTablesTest, FindKeyword)
+{
+    for (const KeywordEntry &entry : keywordEntries)
+    {
+        EXPECT_EQ(FindKeyword(entry.text), &entry) << "Keyword = " << entry.text;
+    }
+
+    EXPECT_EQ(FindKeyword("lets"), NTT_NULL);
+    EXPECT_EQ(FindKeyword("Number"), NTT_NULL);
+    EXPECT_EQ(FindKeyword("fi"), NTT_NULL);
+    EXPECT_EQ(FindKeyword(""), NTT_NULL);
+
+    static_assert(FindKeyword("while")->symbol == Symbol::WHILE);
+    static_assert(FindKeyword("true")->type == TokenType::BOOLEAN);
+}
+
+TEST(LexemeTablesTest, MatchOperator)
+{
+    OPERATOR_MATCH_TESTING("+=1", 2, Symbol::PLUS_ASSIGN);
+    OPERATOR_MATCH_TESTING("+ 1", 1, Symbol::PLUS);
+    OPERATOR_MATCH_TESTING("++a", 2, Symbol::INCREMENT);
+    OPERATOR_MATCH_TESTING("+++=", 3, Symbol::NONE);
+    OPERATOR_MATCH_TESTING("---", 2, Symbol::DECREMENT);
+    OPERATOR_MATCH_TESTING("-=", 2, Symbol::MINUS_ASSIGN);
+    OPERATOR_MATCH_TESTING("&&=", 2, Symbol::LOGICAL_AND);
+    OPERATOR_MATCH_TESTING("&=&", 2, Symbol::AND_ASSIGN);
+    OPERATOR_MATCH_TESTING("||", 2, Symbol::LOGICAL_OR);
+    OPERATOR_MATCH_TESTING("===", 2, Symbol::EQUAL);
+    OPERATOR_MATCH_TESTING("!!", 1, Symbol::NOT);
+    OPERATOR_MATCH_TESTING("<=>", 2, Symbol::LESS_EQUAL);
+    OPERATOR_MATCH_TESTING("@", 1, Symbol::AT);
+    OPERATOR_MATCH_TESTING("a+", 0, Symbol::NONE);
+}
@@ -0,0 +1,60 @@
+#include "test_common.h"
+#include "tokenizer/lexer_dfa.h"
+#include <cstring>
+
+using namespace ntt;
+
+#define DFA_MATCH_TESTING(dfa, input, expectRule, expectLength)                   \
+    {                                                                             \
+        u32 ruleIndex = 0;                                                        \
+        u32 matchedLength = 0;                                                    \
+        EXPECT_TRUE(dfa.Match(input, u32(strlen(input)), ruleIndex, matchedLength)) \
+            << "Input = " << input;                                               \
+        EXPECT_EQ(ruleIndex, u32(expectRule)) << "Input = " << input;             \
+        EXPECT_EQ(matchedLength, u32(expectLength)) << "Input = " << input;       \
+    }
+
+TEST(LexerDfaTest, FirstRuleHasPriority)
+{
+    LexerDfa dfa({
+        {TokenType::OPERATOR, "^\\+="},
+        {TokenType::OPERATOR, "^\\++"},
+        {TokenType::OPERATOR, "^\\+"},
+    });
+
+    DFA_MATCH_TESTING(dfa, "+=", 0, 2);
+    DFA_MATCH_TESTING(dfa, "+++=", 1, 3);
+    DFA_MATCH_TESTING(dfa, "+ +", 1, 1);
+}
+
+TEST(LexerDfaTest, LaterRuleWinsWhenEarlierDoesNotMatch)
+{
+    LexerDfa dfa({
+        {TokenType::INVALID, "^[0-9]+[a-zA-Z][0-9a-zA-Z]*"},
+        {TokenType::FLOAT, "^[0-9]*\\.[0-9]+"},
+        {TokenType::FLOAT, "^[0-9]+\\."},
+        {TokenType::INTEGER, "^[0-9]+"},
+    });
+
+    DFA_MATCH_TESTING(dfa, "12ab3_", 0, 5);
+    DFA_MATCH_TESTING(dfa, "12.5.3", 1, 4);
+    DFA_MATCH_TESTING(dfa, "12.a", 2, 3);
+    DFA_MATCH_TESTING(dfa, "12;", 3, 2);
+
+    EXPECT_EQ(dfa.GetRuleType(2), TokenType::FLOAT);
+}
+
+TEST(LexerDfaTest, StringWithEscapes)
+{
+    LexerDfa dfa({
+        {TokenType::STRING, "^\"((?:[^\"\\\\]|\\\\.)*)\""},
+    });
+
+    DFA_MATCH_TESTING(dfa, R"("a\"b" c")", 0, 6);
+    DFA_MATCH_TESTING(dfa, R"("" "")", 0, 2);
+
+    u32 ruleIndex = 0;
+    u32 matchedLength = 0;
+    EXPECT_FALSE(dfa.Match("\"abc", 4, ruleIndex, matchedLength));
+    EXPECT_FALSE(dfa.Match("\"a\\\rb\"", 6, ruleIndex, matchedLength));
+}
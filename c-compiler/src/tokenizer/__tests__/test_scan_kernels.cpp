@@ -0,0 +1,89 @@
+#include "test_common.h"
+#include "tokenizer/scan_kernels.h"
+#include "tokenizer/tokenizer.h"
+#include <random>
+
+using namespace ntt;
+
+static String CreateScanInput()
+{
+    // mostly runs of the scanned classes, with their neighbours in the ascii table and
+    //      some bytes above 0x7F.
+    const char characters[] = " \n\t_09/:@AZ[`az{\x80\xFF";
+    std::mt19937 random(42);
+    String input;
+
+    while (input.length() < 4096)
+    {
+        char character = characters[random() % (sizeof(characters) - 1)];
+        input.append(random() % 48, character);
+    }
+
+    return input;
+}
+
+TEST(ScanKernelsTest, SameResultsAtEveryLevel)
+{
+    String input = CreateScanInput();
+    ScanKernelLevel defaultLevel = GetScanKernelLevel();
+
+    Vector<u32> expectedCounts;
+    SetScanKernelLevel(ScanKernelLevel::SCALAR);
+    for (u32 startIndex = 0; startIndex < input.length(); startIndex++)
+    {
+        u32 length = u32(input.length()) - startIndex;
+        expectedCounts.push_back(CountLeadingSpaces(input.data() + startIndex, length));
+        expectedCounts.push_back(CountLeadingIdentifierCharacters(input.data() + startIndex, length));
+        expectedCounts.push_back(CountLeadingDigits(input.data() + startIndex, length));
+        expectedCounts.push_back(FindNewLine(input.data() + startIndex, length));
+    }
+
+    for (ScanKernelLevel level : {ScanKernelLevel::SSE2, ScanKernelLevel::AVX2})
+    {
+        ScanKernelLevel usedLevel = SetScanKernelLevel(level);
+        for (u32 startIndex = 0; startIndex < input.length(); startIndex++)
+        {
+            u32 length = u32(input.length()) - startIndex;
+            ASSERT_EQ(CountLeadingSpaces(input.data() + startIndex, length), expectedCounts[startIndex * 4])
+                << "Level = " << u32(usedLevel) << ", start = " << startIndex;
+            ASSERT_EQ(CountLeadingIdentifierCharacters(input.data() + startIndex, length), expectedCounts[startIndex * 4 + 1])
+                << "Level = " << u32(usedLevel) << ", start = " << startIndex;
+            ASSERT_EQ(CountLeadingDigits(input.data() + startIndex, length), expectedCounts[startIndex * 4 + 2])
+                << "Level = " << u32(usedLevel) << ", start = " << startIndex;
+            ASSERT_EQ(FindNewLine(input.data() + startIndex, length), expectedCounts[startIndex * 4 + 3])
+                << "Level = " << u32(usedLevel) << ", start = " << startIndex;
+        }
+    }
+
+    SetScanKernelLevel(defaultLevel);
+}
+
+TEST(ScanKernelsTest, RunsEndAtTheLength)
+{
+    String input(100, 'a');
+    EXPECT_EQ(CountLeadingIdentifierCharacters(input.data(), 37), 37);
+    EXPECT_EQ(CountLeadingSpaces(input.data(), 37), 0);
+    EXPECT_EQ(FindNewLine(input.data(), 37), 37);
+    EXPECT_EQ(CountLeadingDigits("", 0), 0);
+}
+
+TEST(ScanKernelsTest, TokenizerUsesTheKernels)
+{
+    String content = "let identifier_with_a_long_name : number = 00000000000000000000000000000000000000000007;"
+                     "                                                                        \n"
+                     "12abc 12.5 12_ x9 _";
+    ScanKernelLevel defaultLevel = GetScanKernelLevel();
+
+    SetScanKernelLevel(ScanKernelLevel::SCALAR);
+    Tokenizer scalarTokenizer(content);
+    SetScanKernelLevel(defaultLevel);
+    Tokenizer tokenizer(content);
+
+    const auto &tokens = tokenizer.GetTokens();
+    const auto &expectedTokens = scalarTokenizer.GetTokens();
+    ASSERT_EQ(tokens.size(), expectedTokens.size());
+    for (u32 tokenIndex = 0; tokenIndex < tokens.size(); tokenIndex++)
+    {
+        EXPECT_EQ(tokens[tokenIndex].ToJSON(), expectedTokens[tokenIndex].ToJSON());
+    }
+}
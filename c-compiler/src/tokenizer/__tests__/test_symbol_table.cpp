@@ -0,0 +1,112 @@
+#include "test_common.h"
+#include "tokenizer/symbol_table.h"
+#include "tokenizer/tokenizer.h"
+#include <thread>
+
+using namespace ntt;
+
+TEST(SymbolTableTest, FixedSymbols)
+{
+    SymbolTable &table = SymbolTable::Get();
+
+    EXPECT_EQ(table.Find("let"), Symbol::LET);
+    EXPECT_EQ(table.Find("class"), Symbol::CLASS);
+    EXPECT_EQ(table.Find("<="), Symbol::LESS_EQUAL);
+    EXPECT_EQ(table.Find("="), Symbol::ASSIGN);
+    EXPECT_EQ(table.Find("}"), Symbol::CLOSE_BRACE);
+    EXPECT_EQ(table.Find(";"), Symbol::SEMICOLON);
+    EXPECT_EQ(table.Find(":"), Symbol::COLON);
+
+    EXPECT_EQ(table.GetText(Symbol::NOT_EQUAL), "!=");
+    EXPECT_EQ(table.GetText(Symbol::OPEN_SQUARE_BRACKET), "[");
+
+    EXPECT_TRUE(SymbolTable::IsKeyword(Symbol::NUMBER));
+    EXPECT_TRUE(SymbolTable::IsKeyword(Symbol::FUNCTION));
+    EXPECT_FALSE(SymbolTable::IsKeyword(Symbol::PLUS));
+    EXPECT_FALSE(SymbolTable::IsKeyword(Symbol::COUNT));
+}
+
+TEST(SymbolTableTest, InternIdentifiers)
+{
+    SymbolTable &table = SymbolTable::Get();
+
+    EXPECT_EQ(table.Find("symbolTableTestName"), Symbol::NONE);
+
+    Symbol symbol = table.Intern("symbolTableTestName");
+    EXPECT_GE(u32(symbol), u32(Symbol::COUNT));
+    EXPECT_EQ(table.Intern("symbolTableTestName"), symbol);
+    EXPECT_EQ(table.Find("symbolTableTestName"), symbol);
+    EXPECT_EQ(table.GetText(symbol), "symbolTableTestName");
+
+    EXPECT_NE(table.Intern("symbolTableTestOther"), symbol);
+    EXPECT_EQ(table.Intern("let"), Symbol::LET);
+}
+
+TEST(SymbolTableTest, InternFromSeveralThreads)
+{
+    Vector<Vector<Symbol>> symbols(4);
+    Vector<std::thread> threads;
+    for (u32 threadIndex = 0; threadIndex < u32(symbols.size()); threadIndex++)
+    {
+        threads.emplace_back(
+            [&symbols, threadIndex]()
+            {
+                for (u32 nameIndex = 0; nameIndex < 1000; nameIndex++)
+                {
+                    String name = "symbolTableThreadName" + std::to_string(nameIndex);
+                    symbols[threadIndex].push_back(SymbolTable::Get().Intern(name));
+                }
+            });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (u32 nameIndex = 0; nameIndex < 1000; nameIndex++)
+    {
+        String name = "symbolTableThreadName" + std::to_string(nameIndex);
+        for (const auto &threadSymbols : symbols)
+        {
+            EXPECT_EQ(threadSymbols[nameIndex], symbols[0][nameIndex]);
+        }
+        EXPECT_EQ(SymbolTable::Get().GetText(symbols[0][nameIndex]), name);
+    }
+}
+
+TEST(SymbolTableTest, TokensCarrySymbols)
+{
+    Tokenizer tokenizer("let count = count + 1; if (count >= 2) {}");
+    const Vector<Token> &tokens = tokenizer.GetTokens();
+
+    EXPECT_EQ(tokens[0].GetSymbol(), Symbol::LET);
+    EXPECT_EQ(tokens[1].GetSymbol(), tokens[3].GetSymbol());
+    EXPECT_EQ(tokens[2].GetSymbol(), Symbol::ASSIGN);
+    EXPECT_EQ(tokens[4].GetSymbol(), Symbol::PLUS);
+    EXPECT_EQ(tokens[5].GetSymbol(), Symbol::NONE);
+    EXPECT_EQ(tokens[6].GetSymbol(), Symbol::SEMICOLON);
+    EXPECT_EQ(tokens[7].GetSymbol(), Symbol::IF);
+    EXPECT_EQ(tokens[8].GetSymbol(), Symbol::OPEN_PARENTHESIS);
+    EXPECT_EQ(tokens[10].GetSymbol(), Symbol::GREATER_EQUAL);
+    EXPECT_EQ(tokens[13].GetSymbol(), Symbol::OPEN_BRACE);
+
+    Token handMadeToken(TokenType::OPERATOR, 0);
+    handMadeToken.SetValue<String>("==");
+    EXPECT_EQ(handMadeToken.GetSymbol(), Symbol::EQUAL);
+}
+
+TEST(SymbolTableTest, EveryFixedSpellingIsLexedToItsSymbol)
+{
+    for (u32 symbolIndex = u32(Symbol::NONE) + 1; symbolIndex < u32(Symbol::COUNT); symbolIndex++)
+    {
+        Tokenizer tokenizer(String(fixedSymbolTexts[symbolIndex]));
+        const Vector<Token> &tokens = tokenizer.GetTokens();
+
+        ASSERT_EQ(tokens.size(), 1) << fixedSymbolTexts[symbolIndex];
+        EXPECT_EQ(tokens[0].GetSymbol(), Symbol(symbolIndex)) << fixedSymbolTexts[symbolIndex];
+        EXPECT_EQ(tokens[0].GetLength(), fixedSymbolTexts[symbolIndex].length());
+        EXPECT_EQ(SymbolTable::IsKeyword(Symbol(symbolIndex)),
+                  tokens[0].GetType() == TokenType::KEYWORD);
+    }
+}
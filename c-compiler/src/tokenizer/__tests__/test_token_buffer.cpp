@@ -0,0 +1,107 @@
+#include "test_common.h"
+#include "tokenizer/token_buffer.h"
+#include "tokenizer/tokenizer.h"
+
+using namespace ntt;
+
+TEST(TokenBufferTest, PackedTokensUnpackToTheLexedTokens)
+{
+    Tokenizer tokenizer("let count : number = 12 + 3.5; if (true) { print(\"text\"); } 12abc $");
+    const TokenBuffer &buffer = tokenizer.GetTokenBuffer();
+    ASSERT_EQ(buffer.GetSize(), 22);
+
+    TokenBuffer copiedBuffer(tokenizer.GetSource());
+    for (u32 tokenIndex = 0; tokenIndex < buffer.GetSize(); tokenIndex++)
+    {
+        Token token = buffer.GetToken(tokenIndex);
+        copiedBuffer.Push(token);
+
+        // the texts which view into the source file are not copied again.
+        EXPECT_EQ(buffer.GetSymbol(tokenIndex), token.GetSymbol());
+        EXPECT_FALSE(buffer[tokenIndex].HasFlag(PackedToken::TEXT_IN_ARENA));
+        EXPECT_EQ(copiedBuffer[tokenIndex].flags, buffer[tokenIndex].flags);
+    }
+
+    EXPECT_LT(buffer.GetMemoryUsage(), u64(buffer.GetSize()) * sizeof(Token) / 2);
+
+    EXPECT_EQ(buffer[0].GetType(), TokenType::KEYWORD);
+    EXPECT_EQ(buffer.GetText(1), "count");
+    EXPECT_EQ(buffer.GetToken(5).GetValue<u32>(), 12);
+    EXPECT_EQ(buffer.GetToken(7).GetValue<f32>(), 3.5f);
+    EXPECT_EQ(buffer.GetToken(11).GetValue<b8>(), NTT_TRUE);
+    EXPECT_EQ(buffer.GetText(11), "");
+    EXPECT_EQ(buffer.GetText(16), "\"text\"");
+    EXPECT_EQ(buffer[20].GetType(), TokenType::INVALID);
+    EXPECT_EQ(buffer.GetText(21), "$");
+
+    for (u32 tokenIndex = 0; tokenIndex < buffer.GetSize(); tokenIndex++)
+    {
+        EXPECT_EQ(copiedBuffer.GetToken(tokenIndex).ToJSON(), buffer.GetToken(tokenIndex).ToJSON());
+    }
+}
+
+TEST(TokenBufferTest, HandMadeTokensKeepTheirTextInTheArena)
+{
+    TokenBuffer buffer;
+
+    Token identifierToken(TokenType::IDENTIFIER, 4);
+    identifierToken.SetValue<String>("tokenBufferTestName");
+    identifierToken.SetLength(19);
+    buffer.Push(identifierToken);
+
+    Token emptyToken(TokenType::NONE, 0);
+    buffer.Push(emptyToken);
+
+    Token integerToken(TokenType::INTEGER, 30);
+    integerToken.SetValue<u32>(42);
+    buffer.Push(integerToken);
+
+    EXPECT_TRUE(buffer[0].HasFlag(PackedToken::TEXT_IN_ARENA));
+    EXPECT_EQ(buffer[1].flags, 0);
+    EXPECT_EQ(buffer.GetText(0), "tokenBufferTestName");
+    EXPECT_EQ(buffer.GetSymbol(0), SymbolTable::Get().Find("tokenBufferTestName"));
+
+    TokenBuffer otherBuffer;
+    otherBuffer.Push(integerToken);
+    otherBuffer.Append(std::move(buffer));
+    ASSERT_EQ(otherBuffer.GetSize(), 4);
+    EXPECT_EQ(otherBuffer.GetToken(1).ToJSON(), identifierToken.ToJSON());
+    EXPECT_EQ(otherBuffer.GetToken(1).GetSymbol(), identifierToken.GetSymbol());
+    EXPECT_EQ(otherBuffer.GetToken(2).ToJSON(), emptyToken.ToJSON());
+    EXPECT_EQ(otherBuffer.GetToken(3).GetValue<u32>(), 42);
+
+    otherBuffer.Replace(0, 2, TokenBuffer());
+    ASSERT_EQ(otherBuffer.GetSize(), 2);
+    EXPECT_EQ(otherBuffer[0].GetType(), TokenType::NONE);
+    EXPECT_EQ(otherBuffer[1].startIndex, 30);
+}
+
+TEST(TokenBufferTest, ReplacedTokensGiveBackTheirArenaSpace)
+{
+    Token identifierToken(TokenType::IDENTIFIER, 0);
+    identifierToken.SetValue<String>("tokenBufferReplacedName");
+    identifierToken.SetLength(23);
+
+    Token integerToken(TokenType::INTEGER, 24);
+    integerToken.SetValue<u64>(1ull << 40);
+
+    TokenBuffer buffer;
+    buffer.Push(identifierToken);
+    buffer.Push(integerToken);
+
+    TokenBuffer insertedTokens;
+    insertedTokens.Push(identifierToken);
+    insertedTokens.Push(integerToken);
+
+    buffer.Replace(0, 2, insertedTokens);
+    u64 memoryUsage = buffer.GetMemoryUsage();
+    for (u32 replaceIndex = 0; replaceIndex < 1000; replaceIndex++)
+    {
+        buffer.Replace(0, 2, insertedTokens);
+    }
+
+    EXPECT_LE(buffer.GetMemoryUsage(), memoryUsage);
+    ASSERT_EQ(buffer.GetSize(), 2);
+    EXPECT_EQ(buffer.GetToken(0).ToJSON(), identifierToken.ToJSON());
+    EXPECT_EQ(buffer.GetToken(1).GetValue<u64>(), 1ull << 40);
+}
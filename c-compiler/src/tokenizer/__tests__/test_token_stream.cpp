@@ -0,0 +1,43 @@
+#include "test_common.h"
+#include "tokenizer/token_stream.h"
+#include "tokenizer/tokenizer.h"
+
+using namespace ntt;
+
+TEST(TokenStreamTest, SameTokensAsTheTokenizer)
+{
+    String content = "let tokenStreamName : number = 12 + 3.5;\n"
+                     "if (true) { print(\"a\\\"b\", 12abc); } $ \"unterminated";
+    Tokenizer tokenizer(content);
+    TokenStream stream(content);
+
+    for (const auto &expectedToken : tokenizer.GetTokens())
+    {
+        ASSERT_FALSE(stream.IsAtEnd());
+        Token token = stream.Next();
+        EXPECT_EQ(token.ToJSON(), expectedToken.ToJSON());
+        EXPECT_EQ(token.GetSymbol(), expectedToken.GetSymbol());
+    }
+
+    EXPECT_TRUE(stream.IsAtEnd());
+    EXPECT_EQ(stream.Next().GetType(), TokenType::NONE);
+    EXPECT_EQ(stream.Peek().GetStartIndex(), content.length());
+}
+
+TEST(TokenStreamTest, PeekDoesNotConsume)
+{
+    TokenStream stream("a = b + 1;");
+
+    EXPECT_EQ(stream.Peek(0).GetValue<String>(), "a");
+    EXPECT_EQ(stream.Peek(4).GetValue<u32>(), 1);
+    EXPECT_EQ(stream.Peek(7).GetType(), TokenType::NONE);
+    EXPECT_EQ(stream.Next().GetValue<String>(), "a");
+    EXPECT_EQ(stream.Peek(0).GetSymbol(), Symbol::ASSIGN);
+    EXPECT_EQ(stream.Peek(4).GetSymbol(), Symbol::SEMICOLON);
+
+    for (u32 tokenIndex = 0; tokenIndex < 5; tokenIndex++)
+    {
+        stream.Next();
+    }
+    EXPECT_TRUE(stream.IsAtEnd());
+}
@@ -1,5 +1,7 @@
 #include "test_common.h"
 #include "tokenizer/tokenizer.h"
+#include <cstdio>
+#include <fstream>
 
 using namespace ntt;
 
@@ -292,4 +294,280 @@ if (radius > 0) {
     LINE_PROPAGATION(AssertBRACKETToken, tokens[index++], ")", -1, 1);
     LINE_PROPAGATION(AssertDELIMITERToken, tokens[index++], ";", -1, 1);
     LINE_PROPAGATION(AssertBRACKETToken, tokens[index++], "}", -1, 1);
-}
\ No newline at end of file
+}
+
+TEST(TokenizerTest, OperatorPriority)
+{
+    Tokenizer tokenizer("+++= a--b !== c");
+    const auto &tokens = tokenizer.GetTokens();
+    ASSERT_EQ(tokens.size(), 8);
+
+    LINE_PROPAGATION(AssertOPERATORToken, tokens[0], "+++", 0, 3);
+    LINE_PROPAGATION(AssertOPERATORToken, tokens[1], "=", 3, 1);
+    LINE_PROPAGATION(AssertIDENTIFIERToken, tokens[2], "a", 5, 1);
+    LINE_PROPAGATION(AssertOPERATORToken, tokens[3], "--", 6, 2);
+    LINE_PROPAGATION(AssertIDENTIFIERToken, tokens[4], "b", 8, 1);
+    LINE_PROPAGATION(AssertOPERATORToken, tokens[5], "!=", 10, 2);
+    LINE_PROPAGATION(AssertOPERATORToken, tokens[6], "=", 12, 1);
+    LINE_PROPAGATION(AssertIDENTIFIERToken, tokens[7], "c", 14, 1);
+}
+
+TEST(TokenizerTest, NumberPrefixes)
+{
+    Tokenizer tokenizer("1.2.3 12a_b 7.e");
+    const auto &tokens = tokenizer.GetTokens();
+    ASSERT_EQ(tokens.size(), 6);
+
+    LINE_PROPAGATION(AssertFLOATToken, tokens[0], 1.2f, 0, 3);
+    LINE_PROPAGATION(AssertFLOATToken, tokens[1], 0.3f, 3, 2);
+    LINE_PROPAGATION(AssertINVALIDToken, tokens[2], "12a", 6, 3);
+    LINE_PROPAGATION(AssertIDENTIFIERToken, tokens[3], "_b", 9, 2);
+    LINE_PROPAGATION(AssertFLOATToken, tokens[4], 7.0f, 12, 2);
+    LINE_PROPAGATION(AssertIDENTIFIERToken, tokens[5], "e", 14, 1);
+}
+
+TEST(TokenizerTest, NumbersAreDecodedWhenRead)
+{
+    Tokenizer tokenizer("4294967296 18446744073709551615 18446744073709551616 0.1 12.");
+    const auto &tokens = tokenizer.GetTokens();
+    ASSERT_EQ(tokens.size(), 5);
+
+    EXPECT_EQ(tokens[0].GetValue<u64>(), 4294967296ull);
+    EXPECT_EQ(tokens[0].GetValue<u32>(), 0xFFFFFFFF);
+    EXPECT_FALSE(tokens[0].IsValueOutOfRange());
+    EXPECT_TRUE(tokens[0].IsValueOutOfRange<u32>());
+
+    EXPECT_EQ(tokens[1].GetValue<u64>(), 18446744073709551615ull);
+    EXPECT_FALSE(tokens[1].IsValueOutOfRange());
+
+    EXPECT_EQ(tokens[2].GetValue<u64>(), 18446744073709551615ull);
+    EXPECT_EQ(tokens[2].GetValue<std::string_view>(), "18446744073709551616");
+    EXPECT_TRUE(tokens[2].IsValueOutOfRange());
+
+    Token copiedToken(tokens[2]);
+    EXPECT_TRUE(copiedToken.IsValueOutOfRange());
+    EXPECT_EQ(copiedToken.GetValue<u64>(), 18446744073709551615ull);
+
+    EXPECT_EQ(tokens[3].GetValue<f64>(), 0.1);
+    EXPECT_EQ(tokens[3].GetValue<f32>(), 0.1f);
+    EXPECT_EQ(tokens[4].GetValue<f64>(), 12.0);
+
+    Token handMadeToken(TokenType::INTEGER, 0);
+    handMadeToken.SetValue<u64>(1ull << 40);
+    EXPECT_EQ(handMadeToken.GetValue<u64>(), 1ull << 40);
+    EXPECT_FALSE(handMadeToken.IsValueOutOfRange());
+    EXPECT_TRUE(handMadeToken.IsValueOutOfRange<u32>());
+    EXPECT_EQ(handMadeToken.GetValue<std::string_view>(), "");
+}
+
+TEST(TokenizerTest, UnterminatedStringIsInvalid)
+{
+    Tokenizer tokenizer("\"abc def");
+    const auto &tokens = tokenizer.GetTokens();
+    ASSERT_EQ(tokens.size(), 2);
+
+    LINE_PROPAGATION(AssertINVALIDToken, tokens[0], "\"abc", 0, 4);
+    LINE_PROPAGATION(AssertIDENTIFIERToken, tokens[1], "def", 5, 3);
+}
+
+TEST(TokenizerTest, TokenValuesViewTheSource)
+{
+    std::vector<Token> tokens;
+    Ref<SourceFile> source;
+
+    {
+        Tokenizer tokenizer("let name = \"value\";");
+        tokens = tokenizer.GetTokens();
+        source = tokenizer.GetSource();
+    }
+
+    ASSERT_EQ(tokens.size(), 5);
+    for (const auto &token : tokens)
+    {
+        EXPECT_TRUE(token.IsView());
+        EXPECT_EQ(token.GetValue<std::string_view>().data(), source->GetData() + token.GetStartIndex());
+    }
+
+    LINE_PROPAGATION(AssertKEYWORDToken, tokens[0], "let", 0, 3);
+    LINE_PROPAGATION(AssertIDENTIFIERToken, tokens[1], "name", 4, 4);
+    LINE_PROPAGATION(AssertSTRINGToken, tokens[3], "\"value\"", 11, 7);
+
+    Token ownedToken(TokenType::IDENTIFIER, 0);
+    ownedToken.SetValue<std::string>("owned");
+    EXPECT_FALSE(ownedToken.IsView());
+    EXPECT_EQ(ownedToken.GetValue<std::string_view>(), "owned");
+}
+
+TEST(TokenizerTest, NewLinesAreSkippedInPlace)
+{
+    Tokenizer tokenizer("a\nb \"c\nd\" `\ne");
+    EXPECT_EQ(tokenizer.GetSource()->GetData()[1], '\n');
+
+    const auto &tokens = tokenizer.GetTokens();
+    ASSERT_EQ(tokens.size(), 5);
+    LINE_PROPAGATION(AssertIDENTIFIERToken, tokens[0], "a", 0, 1);
+    LINE_PROPAGATION(AssertIDENTIFIERToken, tokens[1], "b", 2, 1);
+    LINE_PROPAGATION(AssertSTRINGToken, tokens[2], "\"c\nd\"", 4, 5);
+    LINE_PROPAGATION(AssertINVALIDToken, tokens[3], "`", 10, 1);
+    LINE_PROPAGATION(AssertIDENTIFIERToken, tokens[4], "e", 12, 1);
+}
+
+TEST(TokenizerTest, TokenizeSpanWithoutCopy)
+{
+    const char buffer[] = "let a = 1; ignored";
+    Tokenizer tokenizer(buffer, 10);
+
+    EXPECT_EQ(tokenizer.GetSource()->GetData(), buffer);
+    const auto &tokens = tokenizer.GetTokens();
+    ASSERT_EQ(tokens.size(), 5);
+    EXPECT_EQ(tokens[1].GetValue<std::string_view>().data(), buffer + 4);
+    LINE_PROPAGATION(AssertDELIMITERToken, tokens[4], ";", 9, 1);
+}
+
+TEST(TokenizerTest, TokenizeMappedFile)
+{
+    String content = "let a = 1;\nif (a) {\n    b = \"c\";\n}\n";
+    String path = ::testing::TempDir() + "ntt_mapped_source.txt";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+
+    Ref<SourceFile> source = SourceFile::MapFile(path);
+    ASSERT_NE(source, NTT_NULL);
+    ASSERT_EQ(source->GetLength(), content.length());
+
+    Tokenizer tokenizer(source);
+    Tokenizer expectedTokenizer(content);
+    const auto &tokens = tokenizer.GetTokens();
+    const auto &expectedTokens = expectedTokenizer.GetTokens();
+    ASSERT_EQ(tokens.size(), expectedTokens.size());
+    for (u32 tokenIndex = 0; tokenIndex < tokens.size(); tokenIndex++)
+    {
+        EXPECT_EQ(tokens[tokenIndex].ToJSON(), expectedTokens[tokenIndex].ToJSON());
+    }
+
+    EXPECT_EQ(SourceFile::MapFile(path + ".missing"), NTT_NULL);
+    std::remove(path.c_str());
+}
+
+TEST(TokenizerTest, ParallelTokenizationMatchesSerial)
+{
+    // long enough for several chunks, with strings and invalid tokens across the lines.
+    String content;
+    for (u32 lineIndex = 0; lineIndex < 6000; lineIndex++)
+    {
+        content += "let parallelName" + std::to_string(lineIndex) + " = \"a\n b \\\" c\" + 12.5;\n";
+        if (lineIndex % 7 == 0)
+        {
+            content += "print(\"unterminated, x);\n`\\\n";
+        }
+    }
+
+    Tokenizer parallelTokenizer(CreateRef<SourceFile>(content), 4);
+    Tokenizer serialTokenizer(content);
+
+    const auto &tokens = parallelTokenizer.GetTokens();
+    const auto &expectedTokens = serialTokenizer.GetTokens();
+    ASSERT_EQ(tokens.size(), expectedTokens.size());
+
+    u32 lastNewSymbol = 0;
+    for (u32 tokenIndex = 0; tokenIndex < tokens.size(); tokenIndex++)
+    {
+        ASSERT_EQ(tokens[tokenIndex].ToJSON(), expectedTokens[tokenIndex].ToJSON());
+        ASSERT_EQ(tokens[tokenIndex].GetSymbol(), expectedTokens[tokenIndex].GetSymbol());
+
+        // the new names are interned in the order of the tokens.
+        if (tokens[tokenIndex].GetType() == TokenType::IDENTIFIER &&
+            tokens[tokenIndex].GetValue<std::string_view>().substr(0, 12) == "parallelName")
+        {
+            EXPECT_GT(u32(tokens[tokenIndex].GetSymbol()), lastNewSymbol);
+            lastNewSymbol = u32(tokens[tokenIndex].GetSymbol());
+        }
+    }
+}
+
+#define EDIT_TESTING(input, offset, removedLength, insertedText)                                         \
+    {                                                                                                    \
+        Tokenizer tokenizer(input);                                                                      \
+        tokenizer.ApplyEdit(offset, removedLength, insertedText);                                        \
+        String expectedContent = String(input).replace(offset, removedLength, insertedText);             \
+        Tokenizer expectedTokenizer(expectedContent);                                                    \
+        const auto &tokens = tokenizer.GetTokens();                                                      \
+        const auto &expectedTokens = expectedTokenizer.GetTokens();                                      \
+        ASSERT_EQ(tokens.size(), expectedTokens.size()) << "Edited = " << expectedContent;               \
+        for (u32 tokenIndex = 0; tokenIndex < tokens.size(); tokenIndex++)                               \
+        {                                                                                                \
+            EXPECT_EQ(tokens[tokenIndex].ToJSON(), expectedTokens[tokenIndex].ToJSON())                  \
+                << "Edited = " << expectedContent;                                                       \
+            if (tokens[tokenIndex].IsView())                                                             \
+            {                                                                                            \
+                EXPECT_EQ(tokens[tokenIndex].GetValue<std::string_view>().data(),                        \
+                          tokenizer.GetSource()->GetData() + tokens[tokenIndex].GetStartIndex());        \
+            }                                                                                            \
+        }                                                                                                \
+    }
+
+TEST(TokenizerTest, ApplyEditMatchesFullTokenization)
+{
+    EDIT_TESTING("let abc = 1;", 7, 0, "d");
+    EDIT_TESTING("let abc = 1;", 4, 3, "x");
+    EDIT_TESTING("let abc = 1;", 0, 12, "");
+    EDIT_TESTING("", 0, 0, "a + 1");
+    EDIT_TESTING("a + b", 2, 0, "+");
+    EDIT_TESTING("a + b", 5, 0, "c");
+    EDIT_TESTING("12 . 5", 2, 1, ".");
+    EDIT_TESTING("a = \"b c; d = e;", 16, 0, "\"");
+    EDIT_TESTING("a = \"b c\"; d = e;", 4, 1, "");
+    EDIT_TESTING("if (a) {\n b; \n} else { c; }", 9, 2, "x\ny");
+}
+
+TEST(TokenizerTest, ApplyEditKeepsTheTokensAroundTheEdit)
+{
+    Tokenizer tokenizer("let a = 1; let b = 2; let c = 3;");
+    EXPECT_EQ(&tokenizer.GetTokens(), &tokenizer.GetTokens());
+    EXPECT_EQ(tokenizer.GetTokens()[6].GetValue<String>(), "b");
+
+    TokenEdit edit = tokenizer.ApplyEdit(15, 1, "bb");
+
+    EXPECT_EQ(edit.firstToken, 6);
+    EXPECT_EQ(edit.numberOfRemovedTokens, 1);
+    EXPECT_EQ(edit.numberOfInsertedTokens, 1);
+
+    const auto &tokens = tokenizer.GetTokens();
+    ASSERT_EQ(tokens.size(), 15);
+    LINE_PROPAGATION(AssertIDENTIFIERToken, tokens[6], "bb", 15, 2);
+    LINE_PROPAGATION(AssertINTEGERToken, tokens[8], 2, 20, 1);
+    LINE_PROPAGATION(AssertIDENTIFIERToken, tokens[11], "c", 27, 1);
+}
+
+TEST(TokenizerTest, LineIndexGivesLinesAndColumns)
+{
+    Tokenizer tokenizer("let a : number = 1;\n\n  if (a) {\n    a = 2;\n}");
+    const LineIndex &lineIndex = tokenizer.GetLineIndex();
+    ASSERT_EQ(lineIndex.GetLineCount(), 5);
+    EXPECT_EQ(lineIndex.GetLineStart(3), 21);
+
+    const auto &tokens = tokenizer.GetTokens();
+    JSON json = tokens[7].ToJSON(&lineIndex);
+    EXPECT_EQ(json["line"], 3);
+    EXPECT_EQ(json["column"], 3);
+    EXPECT_FALSE(tokens[7].ToJSON().contains("line"));
+
+    SourceLocation location = lineIndex.GetLocation(tokens[12].GetStartIndex());
+    EXPECT_EQ(location.line, 4);
+    EXPECT_EQ(location.column, 5);
+    EXPECT_EQ(lineIndex.GetLocation(0).line, 1);
+    EXPECT_EQ(lineIndex.GetLocation(19).column, 20);
+    EXPECT_EQ(lineIndex.GetLocation(20).line, 2);
+
+    // the lines after the edit are moved, the ones of the inserted text are added.
+    tokenizer.ApplyEdit(10, 9, "\nx;\n");
+    Tokenizer expectedTokenizer(tokenizer.GetSource()->GetData(), tokenizer.GetSource()->GetLength());
+    const LineIndex &expectedLineIndex = expectedTokenizer.GetLineIndex();
+    ASSERT_EQ(tokenizer.GetLineIndex().GetLineCount(), expectedLineIndex.GetLineCount());
+    for (u32 line = 1; line <= expectedLineIndex.GetLineCount(); line++)
+    {
+        EXPECT_EQ(tokenizer.GetLineIndex().GetLineStart(line), expectedLineIndex.GetLineStart(line));
+    }
+}
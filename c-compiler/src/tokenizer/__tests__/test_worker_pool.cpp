@@ -0,0 +1,23 @@
+#include "test_common.h"
+#include "tokenizer/worker_pool.h"
+#include <atomic>
+
+using namespace ntt;
+
+TEST(WorkerPoolTest, RunsEveryTaskOnce)
+{
+    WorkerPool &pool = WorkerPool::Get();
+    EXPECT_GE(pool.GetConcurrency(), 1);
+    EXPECT_EQ(&WorkerPool::Get(), &pool);
+
+    for (u32 numberOfTasks : {0u, 1u, 3u, 64u})
+    {
+        Vector<std::atomic<u32>> numberOfCalls(numberOfTasks);
+        pool.Run(numberOfTasks, [&](u32 taskIndex) { numberOfCalls[taskIndex]++; });
+
+        for (u32 taskIndex = 0; taskIndex < numberOfTasks; taskIndex++)
+        {
+            EXPECT_EQ(numberOfCalls[taskIndex].load(), 1);
+        }
+    }
+}
@@ -0,0 +1,443 @@
+#include "tokenizer/lexer_dfa.h"
+#include <algorithm>
+#include <bitset>
+#include <map>
+
+namespace ntt
+{
+    namespace
+    {
+        constexpr u32 NO_RULE = 0xFFFFFFFF;
+        constexpr u16 DEAD_STATE = 0;
+        constexpr u16 START_STATE = 1;
+
+        /**
+         * Thompson construction state. A state either consumes one character of `characters`
+         *      and moves to `next`, or moves to its epsilon targets without consuming.
+         */
+        struct NfaState
+        {
+            std::bitset<256> characters;
+            i32 next = -1;
+            i32 epsilons[2] = {-1, -1};
+            u32 rule = NO_RULE;
+        };
+
+        struct NfaFragment
+        {
+            i32 start;
+            i32 end;
+        };
+
+        /**
+         * Recursive descent compiler for the regex subset described in `LexerRule`.
+         */
+        class RegexCompiler
+        {
+        public:
+            RegexCompiler(Vector<NfaState> &states, const String &pattern)
+                : m_states(states), m_pattern(pattern), m_cursor(0)
+            {
+                if (m_pattern.length() > 0 && m_pattern[0] == '^')
+                {
+                    m_cursor++;
+                }
+            }
+
+            NfaFragment Compile()
+            {
+                NfaFragment fragment = ParseAlternation();
+                NTT_ASSERT_MSG(m_cursor == m_pattern.length(), "Unexpected character in lexer pattern.");
+                return fragment;
+            }
+
+        private:
+            i32 NewState()
+            {
+                m_states.push_back(NfaState());
+                return i32(m_states.size() - 1);
+            }
+
+            void AddEpsilon(i32 from, i32 to)
+            {
+                NfaState &state = m_states[from];
+                if (state.epsilons[0] == -1)
+                {
+                    state.epsilons[0] = to;
+                }
+                else
+                {
+                    NTT_ASSERT(state.epsilons[1] == -1);
+                    state.epsilons[1] = to;
+                }
+            }
+
+            inline b8 IsEnd() const { return m_cursor >= m_pattern.length(); }
+            inline char Peek() const { return m_pattern[m_cursor]; }
+
+            NfaFragment ParseAlternation()
+            {
+                NfaFragment fragment = ParseConcatenation();
+
+                while (!IsEnd() && Peek() == '|')
+                {
+                    m_cursor++;
+                    NfaFragment other = ParseConcatenation();
+
+                    i32 start = NewState();
+                    i32 end = NewState();
+                    AddEpsilon(start, fragment.start);
+                    AddEpsilon(start, other.start);
+                    AddEpsilon(fragment.end, end);
+                    AddEpsilon(other.end, end);
+                    fragment = {start, end};
+                }
+
+                return fragment;
+            }
+
+            NfaFragment ParseConcatenation()
+            {
+                i32 start = NewState();
+                NfaFragment fragment = {start, start};
+
+                while (!IsEnd() && Peek() != '|' && Peek() != ')')
+                {
+                    NfaFragment piece = ParseRepetition();
+                    AddEpsilon(fragment.end, piece.start);
+                    fragment.end = piece.end;
+                }
+
+                return fragment;
+            }
+
+            NfaFragment ParseRepetition()
+            {
+                NfaFragment atom = ParseAtom();
+
+                while (!IsEnd() && (Peek() == '*' || Peek() == '+' || Peek() == '?'))
+                {
+                    char quantifier = Peek();
+                    m_cursor++;
+
+                    i32 start = NewState();
+                    i32 end = NewState();
+                    AddEpsilon(start, atom.start);
+
+                    if (quantifier != '+')
+                    {
+                        AddEpsilon(start, end);
+                    }
+
+                    if (quantifier != '?')
+                    {
+                        AddEpsilon(atom.end, atom.start);
+                    }
+
+                    AddEpsilon(atom.end, end);
+                    atom = {start, end};
+                }
+
+                return atom;
+            }
+
+            NfaFragment ParseAtom()
+            {
+                NTT_ASSERT_MSG(!IsEnd(), "Unexpected end of lexer pattern.");
+                char character = Peek();
+                m_cursor++;
+
+                if (character == '(')
+                {
+                    if (m_pattern.compare(m_cursor, 2, "?:") == 0)
+                    {
+                        m_cursor += 2;
+                    }
+
+                    NfaFragment group = ParseAlternation();
+                    NTT_ASSERT_MSG(!IsEnd() && Peek() == ')', "Missing ')' in lexer pattern.");
+                    m_cursor++;
+                    return group;
+                }
+
+                std::bitset<256> characters;
+
+                if (character == '[')
+                {
+                    characters = ParseClass();
+                }
+                else if (character == '.')
+                {
+                    // ECMAScript `.` does not match the line terminators.
+                    characters.set();
+                    characters.reset(u8('\n'));
+                    characters.reset(u8('\r'));
+                }
+                else if (character == '\\')
+                {
+                    NTT_ASSERT_MSG(!IsEnd(), "Dangling escape in lexer pattern.");
+                    characters.set(u8(Peek()));
+                    m_cursor++;
+                }
+                else
+                {
+                    characters.set(u8(character));
+                }
+
+                i32 start = NewState();
+                i32 end = NewState();
+                m_states[start].characters = characters;
+                m_states[start].next = end;
+                return {start, end};
+            }
+
+            std::bitset<256> ParseClass()
+            {
+                std::bitset<256> characters;
+                b8 isNegated = NTT_FALSE;
+
+                if (!IsEnd() && Peek() == '^')
+                {
+                    isNegated = NTT_TRUE;
+                    m_cursor++;
+                }
+
+                while (!IsEnd() && Peek() != ']')
+                {
+                    u8 rangeStart = ParseClassCharacter();
+                    u8 rangeEnd = rangeStart;
+
+                    if (m_cursor + 1 < m_pattern.length() &&
+                        Peek() == '-' &&
+                        m_pattern[m_cursor + 1] != ']')
+                    {
+                        m_cursor++;
+                        rangeEnd = ParseClassCharacter();
+                    }
+
+                    for (u32 value = rangeStart; value <= rangeEnd; value++)
+                    {
+                        characters.set(value);
+                    }
+                }
+
+                NTT_ASSERT_MSG(!IsEnd(), "Missing ']' in lexer pattern.");
+                m_cursor++;
+
+                if (isNegated)
+                {
+                    characters.flip();
+                }
+
+                return characters;
+            }
+
+            u8 ParseClassCharacter()
+            {
+                if (Peek() == '\\')
+                {
+                    m_cursor++;
+                    NTT_ASSERT_MSG(!IsEnd(), "Dangling escape in lexer pattern.");
+                }
+
+                u8 character = u8(Peek());
+                m_cursor++;
+                return character;
+            }
+
+        private:
+            Vector<NfaState> &m_states;
+            const String &m_pattern;
+            u32 m_cursor;
+        };
+
+        typedef Vector<i32> NfaStateSet;
+
+        void AddClosure(const Vector<NfaState> &states, i32 stateIndex,
+                        Vector<b8> &visited, NfaStateSet &outSet)
+        {
+            Vector<i32> pending = {stateIndex};
+
+            while (!pending.empty())
+            {
+                i32 current = pending.back();
+                pending.pop_back();
+
+                if (visited[current])
+                {
+                    continue;
+                }
+
+                visited[current] = NTT_TRUE;
+                outSet.push_back(current);
+
+                for (i32 target : states[current].epsilons)
+                {
+                    if (target != -1 && !visited[target])
+                    {
+                        pending.push_back(target);
+                    }
+                }
+            }
+        }
+    } // namespace anonymous
+
+    LexerDfa::LexerDfa(const Vector<LexerRule> &rules)
+    {
+        Vector<NfaState> states;
+        Vector<i32> ruleStarts;
+
+        for (u32 ruleIndex = 0; ruleIndex < u32(rules.size()); ruleIndex++)
+        {
+            RegexCompiler compiler(states, rules[ruleIndex].pattern);
+            NfaFragment fragment = compiler.Compile();
+            states[fragment.end].rule = ruleIndex;
+            ruleStarts.push_back(fragment.start);
+            m_ruleTypes.push_back(rules[ruleIndex].type);
+        }
+
+        // subset construction, each DFA state is the sorted set of NFA states it stands for.
+        std::map<NfaStateSet, u16> stateIds;
+        Vector<NfaStateSet> stateSets;
+        Vector<Vector<u16>> fullTransitions;
+
+        auto internState = [&](NfaStateSet &set) -> u16
+        {
+            std::sort(set.begin(), set.end());
+            auto found = stateIds.find(set);
+            if (found != stateIds.end())
+            {
+                return found->second;
+            }
+
+            NTT_ASSERT_MSG(stateSets.size() < 0xFFFF, "Lexer automaton is too large.");
+            u16 id = u16(stateSets.size());
+            stateIds[set] = id;
+            stateSets.push_back(set);
+            return id;
+        };
+
+        {
+            NfaStateSet deadSet;
+            internState(deadSet);
+
+            Vector<b8> visited(states.size(), NTT_FALSE);
+            NfaStateSet startSet;
+            for (i32 start : ruleStarts)
+            {
+                AddClosure(states, start, visited, startSet);
+            }
+            internState(startSet);
+        }
+
+        for (u32 stateIndex = 0; stateIndex < u32(stateSets.size()); stateIndex++)
+        {
+            Vector<u16> row(256, DEAD_STATE);
+
+            for (u32 character = 0; character < 256; character++)
+            {
+                Vector<b8> visited(states.size(), NTT_FALSE);
+                NfaStateSet nextSet;
+
+                for (i32 nfaState : stateSets[stateIndex])
+                {
+                    const NfaState &state = states[nfaState];
+                    if (state.next != -1 && state.characters.test(character))
+                    {
+                        AddClosure(states, state.next, visited, nextSet);
+                    }
+                }
+
+                row[character] = nextSet.empty() ? DEAD_STATE : internState(nextSet);
+            }
+
+            fullTransitions.push_back(row);
+        }
+
+        m_stateCount = u32(stateSets.size());
+
+        // group the bytes which behave the same in every state into one class.
+        std::map<Vector<u16>, u8> classIds;
+        for (u32 character = 0; character < 256; character++)
+        {
+            Vector<u16> column(m_stateCount);
+            for (u32 stateIndex = 0; stateIndex < m_stateCount; stateIndex++)
+            {
+                column[stateIndex] = fullTransitions[stateIndex][character];
+            }
+
+            auto found = classIds.find(column);
+            if (found == classIds.end())
+            {
+                u8 classId = u8(classIds.size());
+                classIds[column] = classId;
+                m_byteClasses[character] = classId;
+            }
+            else
+            {
+                m_byteClasses[character] = found->second;
+            }
+        }
+
+        m_classCount = u32(classIds.size());
+        m_transitions.resize(m_stateCount * m_classCount);
+
+        for (u32 stateIndex = 0; stateIndex < m_stateCount; stateIndex++)
+        {
+            for (u32 character = 0; character < 256; character++)
+            {
+                m_transitions[stateIndex * m_classCount + m_byteClasses[character]] =
+                    fullTransitions[stateIndex][character];
+            }
+        }
+
+        m_acceptedRules.resize(m_stateCount, NO_RULE);
+        for (u32 stateIndex = 0; stateIndex < m_stateCount; stateIndex++)
+        {
+            for (i32 nfaState : stateSets[stateIndex])
+            {
+                m_acceptedRules[stateIndex] = std::min(m_acceptedRules[stateIndex], states[nfaState].rule);
+            }
+        }
+    }
+
+    LexerDfa::~LexerDfa()
+    {
+    }
+
+    b8 LexerDfa::Match(const char *input, u32 length, u32 &outRuleIndex, u32 &outLength) const
+    {
+        u32 state = START_STATE;
+        u32 bestRule = NO_RULE;
+        u32 bestLength = 0;
+
+        for (u32 characterIndex = 0; characterIndex < length; characterIndex++)
+        {
+            state = m_transitions[state * m_classCount + m_byteClasses[u8(input[characterIndex])]];
+
+            if (state == DEAD_STATE)
+            {
+                break;
+            }
+
+            // A state accepting a rule lower than the current best means that rule
+            //      matches too and it has the priority. The same rule accepting again
+            //      means its match is longer.
+            u32 acceptedRule = m_acceptedRules[state];
+            if (acceptedRule <= bestRule && acceptedRule != NO_RULE)
+            {
+                bestRule = acceptedRule;
+                bestLength = characterIndex + 1;
+            }
+        }
+
+        if (bestRule == NO_RULE)
+        {
+            return NTT_FALSE;
+        }
+
+        outRuleIndex = bestRule;
+        outLength = bestLength;
+        return NTT_TRUE;
+    }
+} // namespace ntt
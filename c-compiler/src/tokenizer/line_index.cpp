@@ -0,0 +1,66 @@
+#include "tokenizer/line_index.h"
+#include "tokenizer/scan_kernels.h"
+#include <algorithm>
+
+namespace ntt
+{
+    LineIndex::LineIndex()
+        : m_lineStarts({0})
+    {
+    }
+
+    LineIndex::LineIndex(const char *text, u32 length)
+        : m_lineStarts({0})
+    {
+        FindLineStarts(text, length, 0, m_lineStarts);
+    }
+
+    LineIndex::~LineIndex()
+    {
+    }
+
+    void LineIndex::FindLineStarts(const char *text, u32 length, u32 offset, Vector<u32> &outLineStarts)
+    {
+        u32 index = 0;
+        while (NTT_TRUE)
+        {
+            index += FindNewLine(text + index, length - index);
+            if (index == length)
+            {
+                break;
+            }
+
+            index++;
+            outLineStarts.push_back(offset + index);
+        }
+    }
+
+    SourceLocation LineIndex::GetLocation(u32 offset) const
+    {
+        // the line is the last one which starts at or before the offset.
+        u32 line = u32(std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset) - m_lineStarts.begin());
+        return {line, offset - m_lineStarts[line - 1] + 1};
+    }
+
+    void LineIndex::ApplyEdit(u32 offset, u32 removedLength, std::string_view insertedText)
+    {
+        u32 insertedLength = u32(insertedText.length());
+
+        // the lines which start in the removed text are replaced by the ones of the
+        //      inserted text.
+        auto removedStart = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset);
+        auto removedEnd = std::upper_bound(removedStart, m_lineStarts.end(), offset + removedLength);
+
+        Vector<u32> insertedLineStarts;
+        FindLineStarts(insertedText.data(), insertedLength, offset, insertedLineStarts);
+
+        for (auto lineStart = removedEnd; lineStart != m_lineStarts.end(); lineStart++)
+        {
+            *lineStart = *lineStart + insertedLength - removedLength;
+        }
+
+        u32 firstRemovedLine = u32(removedStart - m_lineStarts.begin());
+        m_lineStarts.erase(removedStart, removedEnd);
+        m_lineStarts.insert(m_lineStarts.begin() + firstRemovedLine, insertedLineStarts.begin(), insertedLineStarts.end());
+    }
+} // namespace ntt
@@ -0,0 +1,272 @@
+#include "tokenizer/scan_kernels.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NTT_SCAN_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define NTT_TARGET_SSE2 __attribute__((target("sse2")))
+#define NTT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define NTT_TARGET_SSE2
+#define NTT_TARGET_AVX2
+#endif
+
+namespace ntt
+{
+    namespace
+    {
+        typedef u32 (*ScanKernel)(const char *text, u32 length);
+
+        inline b8 IsSpaceCharacter(char character)
+        {
+            return character == ' ' || character == '\n';
+        }
+
+        inline b8 IsNotNewLineCharacter(char character)
+        {
+            return character != '\n';
+        }
+
+        inline b8 IsDigitCharacter(char character)
+        {
+            return character >= '0' && character <= '9';
+        }
+
+        inline b8 IsIdentifierCharacter(char character)
+        {
+            return (character >= 'a' && character <= 'z') ||
+                   (character >= 'A' && character <= 'Z') ||
+                   IsDigitCharacter(character) ||
+                   character == '_';
+        }
+
+        template <b8 (*IsInClass)(char)>
+        u32 CountLeadingScalar(const char *text, u32 length)
+        {
+            u32 index = 0;
+            while (index < length && IsInClass(text[index]))
+            {
+                index++;
+            }
+            return index;
+        }
+
+#ifdef NTT_SCAN_KERNELS_X86
+        inline u32 CountTrailingZeros(u32 value)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, value);
+            return u32(index);
+#else
+            return u32(__builtin_ctz(value));
+#endif
+        }
+
+        // the comparisons are signed, the bytes from 0x80 are negative so they are never
+        //      in a class.
+        NTT_TARGET_SSE2 inline __m128i MatchSpaces128(__m128i chunk)
+        {
+            return _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+                                _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')));
+        }
+
+        NTT_TARGET_SSE2 inline __m128i MatchNotNewLines128(__m128i chunk)
+        {
+            return _mm_andnot_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')), _mm_set1_epi8(-1));
+        }
+
+        NTT_TARGET_SSE2 inline __m128i MatchDigits128(__m128i chunk)
+        {
+            return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)),
+                                 _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chunk));
+        }
+
+        NTT_TARGET_SSE2 inline __m128i MatchIdentifierCharacters128(__m128i chunk)
+        {
+            // setting the 0x20 bit turns the upper case letters into the lower case ones.
+            __m128i lowerCase = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+            __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(lowerCase, _mm_set1_epi8('a' - 1)),
+                                            _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), lowerCase));
+            return _mm_or_si128(_mm_or_si128(letters, MatchDigits128(chunk)),
+                                _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')));
+        }
+
+        template <__m128i (*Match)(__m128i), b8 (*IsInClass)(char)>
+        NTT_TARGET_SSE2 u32 CountLeadingSse2(const char *text, u32 length)
+        {
+            u32 index = 0;
+            for (; index + 16 <= length; index += 16)
+            {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + index));
+                u32 mask = u32(_mm_movemask_epi8(Match(chunk)));
+                if (mask != 0xFFFF)
+                {
+                    return index + CountTrailingZeros(~mask);
+                }
+            }
+
+            return index + CountLeadingScalar<IsInClass>(text + index, length - index);
+        }
+
+        NTT_TARGET_AVX2 inline __m256i MatchSpaces256(__m256i chunk)
+        {
+            return _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')),
+                                   _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n')));
+        }
+
+        NTT_TARGET_AVX2 inline __m256i MatchNotNewLines256(__m256i chunk)
+        {
+            return _mm256_andnot_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n')), _mm256_set1_epi8(-1));
+        }
+
+        NTT_TARGET_AVX2 inline __m256i MatchDigits256(__m256i chunk)
+        {
+            return _mm256_and_si256(_mm256_cmpgt_epi8(chunk, _mm256_set1_epi8('0' - 1)),
+                                    _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chunk));
+        }
+
+        NTT_TARGET_AVX2 inline __m256i MatchIdentifierCharacters256(__m256i chunk)
+        {
+            __m256i lowerCase = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+            __m256i letters = _mm256_and_si256(_mm256_cmpgt_epi8(lowerCase, _mm256_set1_epi8('a' - 1)),
+                                               _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lowerCase));
+            return _mm256_or_si256(_mm256_or_si256(letters, MatchDigits256(chunk)),
+                                   _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('_')));
+        }
+
+        template <__m256i (*Match)(__m256i), __m128i (*Match128)(__m128i), b8 (*IsInClass)(char)>
+        NTT_TARGET_AVX2 u32 CountLeadingAvx2(const char *text, u32 length)
+        {
+            u32 index = 0;
+            for (; index + 32 <= length; index += 32)
+            {
+                __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + index));
+                u32 mask = u32(_mm256_movemask_epi8(Match(chunk)));
+                if (mask != 0xFFFFFFFF)
+                {
+                    return index + CountTrailingZeros(~mask);
+                }
+            }
+
+            return index + CountLeadingSse2<Match128, IsInClass>(text + index, length - index);
+        }
+
+        ScanKernelLevel DetectScanKernelLevel()
+        {
+#if defined(_MSC_VER)
+            int information[4];
+            __cpuid(information, 1);
+            b8 isOsSavingAvx = (information[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+            __cpuidex(information, 7, 0);
+            return isOsSavingAvx && (information[1] & (1 << 5)) != 0
+                       ? ScanKernelLevel::AVX2
+                       : ScanKernelLevel::SSE2;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? ScanKernelLevel::AVX2 : ScanKernelLevel::SSE2;
+#endif
+        }
+#else
+        ScanKernelLevel DetectScanKernelLevel()
+        {
+            return ScanKernelLevel::SCALAR;
+        }
+#endif
+
+        struct ScanKernels
+        {
+            ScanKernelLevel supportedLevel;
+            ScanKernelLevel level;
+            ScanKernel countLeadingSpaces;
+            ScanKernel countLeadingIdentifierCharacters;
+            ScanKernel countLeadingDigits;
+            ScanKernel findNewLine;
+        };
+
+        void SelectScanKernels(ScanKernels &kernels, ScanKernelLevel level)
+        {
+            kernels.level = level;
+
+            switch (level)
+            {
+#ifdef NTT_SCAN_KERNELS_X86
+            case ScanKernelLevel::AVX2:
+                kernels.countLeadingSpaces = CountLeadingAvx2<MatchSpaces256, MatchSpaces128, IsSpaceCharacter>;
+                kernels.countLeadingIdentifierCharacters = CountLeadingAvx2<MatchIdentifierCharacters256,
+                                                                            MatchIdentifierCharacters128,
+                                                                            IsIdentifierCharacter>;
+                kernels.countLeadingDigits = CountLeadingAvx2<MatchDigits256, MatchDigits128, IsDigitCharacter>;
+                kernels.findNewLine = CountLeadingAvx2<MatchNotNewLines256, MatchNotNewLines128, IsNotNewLineCharacter>;
+                break;
+            case ScanKernelLevel::SSE2:
+                kernels.countLeadingSpaces = CountLeadingSse2<MatchSpaces128, IsSpaceCharacter>;
+                kernels.countLeadingIdentifierCharacters = CountLeadingSse2<MatchIdentifierCharacters128,
+                                                                            IsIdentifierCharacter>;
+                kernels.countLeadingDigits = CountLeadingSse2<MatchDigits128, IsDigitCharacter>;
+                kernels.findNewLine = CountLeadingSse2<MatchNotNewLines128, IsNotNewLineCharacter>;
+                break;
+#endif
+            default:
+                kernels.level = ScanKernelLevel::SCALAR;
+                kernels.countLeadingSpaces = CountLeadingScalar<IsSpaceCharacter>;
+                kernels.countLeadingIdentifierCharacters = CountLeadingScalar<IsIdentifierCharacter>;
+                kernels.countLeadingDigits = CountLeadingScalar<IsDigitCharacter>;
+                kernels.findNewLine = CountLeadingScalar<IsNotNewLineCharacter>;
+                break;
+            }
+        }
+
+        ScanKernels &GetScanKernels()
+        {
+            static ScanKernels kernels = []()
+            {
+                ScanKernels detectedKernels;
+                detectedKernels.supportedLevel = DetectScanKernelLevel();
+                SelectScanKernels(detectedKernels, detectedKernels.supportedLevel);
+                return detectedKernels;
+            }();
+
+            return kernels;
+        }
+    } // namespace anonymous
+
+    u32 CountLeadingSpaces(const char *text, u32 length)
+    {
+        return GetScanKernels().countLeadingSpaces(text, length);
+    }
+
+    u32 CountLeadingIdentifierCharacters(const char *text, u32 length)
+    {
+        return GetScanKernels().countLeadingIdentifierCharacters(text, length);
+    }
+
+    u32 CountLeadingDigits(const char *text, u32 length)
+    {
+        return GetScanKernels().countLeadingDigits(text, length);
+    }
+
+    u32 FindNewLine(const char *text, u32 length)
+    {
+        // the run before the new line is counted with the same kernels as the classes.
+        return GetScanKernels().findNewLine(text, length);
+    }
+
+    ScanKernelLevel GetScanKernelLevel()
+    {
+        return GetScanKernels().level;
+    }
+
+    ScanKernelLevel SetScanKernelLevel(ScanKernelLevel level)
+    {
+        ScanKernels &kernels = GetScanKernels();
+        SelectScanKernels(kernels, std::min(level, kernels.supportedLevel));
+        return kernels.level;
+    }
+} // namespace ntt
@@ -0,0 +1,136 @@
+#include "tokenizer/source_file.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ntt
+{
+    SourceFile::SourceFile()
+    {
+    }
+
+    SourceFile::SourceFile(const String &content)
+        : m_content(content)
+    {
+        m_data = m_content.data();
+        m_length = u32(m_content.length());
+    }
+
+    SourceFile::SourceFile(String &&content)
+        : m_content(std::move(content))
+    {
+        m_data = m_content.data();
+        m_length = u32(m_content.length());
+    }
+
+    SourceFile::SourceFile(const char *data, u32 length)
+        : m_data(data), m_length(length)
+    {
+    }
+
+    SourceFile::~SourceFile()
+    {
+        if (m_mapping == NTT_NULL)
+        {
+            return;
+        }
+
+#if defined(_WIN32)
+        UnmapViewOfFile(m_data);
+        CloseHandle(HANDLE(m_mapping));
+#else
+        munmap(m_mapping, m_length);
+#endif
+    }
+
+    Ref<SourceFile> SourceFile::MapFile(const String &path)
+    {
+        // the constructor is private, so `CreateRef` can not be used.
+        Ref<SourceFile> sourceFile(new SourceFile());
+
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NTT_NULL,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NTT_NULL);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return NTT_NULL;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart > 0xFFFFFFFF)
+        {
+            CloseHandle(file);
+            return NTT_NULL;
+        }
+
+        // an empty file can not be mapped, it keeps the empty text.
+        if (fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return sourceFile;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, NTT_NULL, PAGE_READONLY, 0, 0, NTT_NULL);
+        CloseHandle(file);
+        if (mapping == NTT_NULL)
+        {
+            return NTT_NULL;
+        }
+
+        const void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == NTT_NULL)
+        {
+            CloseHandle(mapping);
+            return NTT_NULL;
+        }
+
+        sourceFile->m_mapping = mapping;
+        sourceFile->m_data = static_cast<const char *>(data);
+        sourceFile->m_length = u32(fileSize.QuadPart);
+#else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            return NTT_NULL;
+        }
+
+        struct stat fileStatus;
+        if (fstat(file, &fileStatus) != 0 || u64(fileStatus.st_size) > 0xFFFFFFFF)
+        {
+            close(file);
+            return NTT_NULL;
+        }
+
+        // an empty file can not be mapped, it keeps the empty text.
+        if (fileStatus.st_size == 0)
+        {
+            close(file);
+            return sourceFile;
+        }
+
+        void *data = mmap(NTT_NULL, size_t(fileStatus.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (data == MAP_FAILED)
+        {
+            return NTT_NULL;
+        }
+
+        // the lexer reads the mapping once from the start to the end.
+        madvise(data, size_t(fileStatus.st_size), MADV_SEQUENTIAL);
+
+        sourceFile->m_mapping = data;
+        sourceFile->m_data = static_cast<const char *>(data);
+        sourceFile->m_length = u32(fileStatus.st_size);
+#endif
+
+        return sourceFile;
+    }
+} // namespace ntt
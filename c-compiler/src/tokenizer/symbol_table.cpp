@@ -0,0 +1,76 @@
+#include "tokenizer/symbol_table.h"
+#include <mutex>
+
+namespace ntt
+{
+    SymbolTable::SymbolTable()
+    {
+        m_texts.reserve(u32(Symbol::COUNT));
+
+        for (u32 symbolIndex = 0; symbolIndex < u32(Symbol::COUNT); symbolIndex++)
+        {
+            std::string_view text = fixedSymbolTexts[symbolIndex];
+            m_texts.push_back(text);
+
+            if (symbolIndex != u32(Symbol::NONE))
+            {
+                m_ids[text] = Symbol(symbolIndex);
+            }
+        }
+    }
+
+    SymbolTable::~SymbolTable()
+    {
+    }
+
+    SymbolTable &SymbolTable::Get()
+    {
+        static SymbolTable table;
+        return table;
+    }
+
+    Symbol SymbolTable::Intern(std::string_view text)
+    {
+        Symbol symbol = Find(text);
+        if (symbol != Symbol::NONE)
+        {
+            return symbol;
+        }
+
+        // another thread may have interned the text since it was looked up.
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        auto found = m_ids.find(text);
+        if (found != m_ids.end())
+        {
+            return found->second;
+        }
+
+        m_storage.emplace_back(text);
+        std::string_view storedText = m_storage.back();
+
+        symbol = Symbol(m_texts.size());
+        m_texts.push_back(storedText);
+        m_ids[storedText] = symbol;
+        return symbol;
+    }
+
+    Symbol SymbolTable::Find(std::string_view text) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto found = m_ids.find(text);
+        return found == m_ids.end() ? Symbol::NONE : found->second;
+    }
+
+    std::string_view SymbolTable::GetText(Symbol symbol) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        NTT_ASSERT_MSG(u32(symbol) < m_texts.size(), "Unknown symbol.");
+        return m_texts[u32(symbol)];
+    }
+
+    u32 SymbolTable::GetCount() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        return u32(m_texts.size());
+    }
+} // namespace ntt
@@ -1,15 +1,68 @@
 #include "tokenizer/token.h"
+#include <algorithm>
+#include <charconv>
+#include <limits>
 
 namespace ntt
 {
+    namespace
+    {
+        constexpr u64 MAX_U64 = std::numeric_limits<u64>::max();
+
+        /**
+         * @return The value of the `[0-9]+` literal, `MAX_U64` when it is too large.
+         */
+        u64 DecodeInteger(std::string_view text, b8 &outIsOutOfRange)
+        {
+            u64 value = 0;
+            std::from_chars_result result = std::from_chars(text.data(), text.data() + text.length(), value);
+            outIsOutOfRange = result.ec == std::errc::result_out_of_range;
+            return outIsOutOfRange ? MAX_U64 : value;
+        }
+
+        /**
+         * @return The value of the float literal (which has no exponent), infinity when it
+         *      is too large. A literal which is too small for a `f64` is 0.
+         */
+        f64 DecodeFloat(std::string_view text, b8 &outIsOutOfRange)
+        {
+            f64 value = 0.0;
+            std::from_chars_result result = std::from_chars(text.data(), text.data() + text.length(), value);
+            outIsOutOfRange = NTT_FALSE;
+            if (result.ec != std::errc::result_out_of_range)
+            {
+                return value;
+            }
+
+            // without exponent only the digits before the dot can make it too large.
+            for (char character : text)
+            {
+                if (character == '.')
+                {
+                    break;
+                }
+
+                if (character != '0')
+                {
+                    outIsOutOfRange = NTT_TRUE;
+                    return std::numeric_limits<f64>::infinity();
+                }
+            }
+
+            return 0.0;
+        }
+    } // namespace anonymous
+
     Token::Token(TokenType type, u32 startIndex)
-        : m_type(type), m_startIndex(startIndex)
+        : m_type(type), m_symbol(Symbol::NONE), m_startIndex(startIndex), m_length(0),
+          m_decodeState(DecodeState::NOT_DECODED)
     {
     }
 
     Token::Token(const Token &other)
-        : m_type(other.m_type), m_value(other.m_value),
-          m_startIndex(other.m_startIndex), m_length(other.m_length)
+        : m_type(other.m_type), m_value(other.m_value), m_symbol(other.m_symbol),
+          m_startIndex(other.m_startIndex), m_length(other.m_length),
+          m_decodeState(other.m_decodeState)
     {
     }
 
@@ -19,7 +72,7 @@ namespace ntt
 
 #define ASSERT_TYPE_IN_ARRAY(...)                                 \
     {                                                             \
-        std::vector<TokenType> types{__VA_ARGS__};                \
+        std::initializer_list<TokenType> types{__VA_ARGS__};      \
         b8 hasMatched = NTT_FALSE;                                \
         for (const auto &tokenType : types)                       \
         {                                                         \
@@ -47,31 +100,228 @@ namespace ntt
         return m_value.member;                \
     }
 
-    GETTER_SETTER_IMPL(u32, numberValue.intValue, TokenType::INTEGER);
-    GETTER_SETTER_IMPL(f32, numberValue.floatValue, TokenType::FLOAT);
     GETTER_SETTER_IMPL(b8, numberValue.boolValue, TokenType::BOOLEAN);
-    GETTER_SETTER_IMPL(std::string, stringValue, TokenType::STRING,
-                       TokenType::INVALID, TokenType::KEYWORD,
-                       TokenType::BRACKET,
-                       TokenType::DELIMITER,
-                       TokenType::IDENTIFIER,
-                       TokenType::OPERATOR,
-                       TokenType::TYPE_HINT,
-                       TokenType::NONE);
 
-    JSON Token::ToJSON() const
+    template <>
+    void Token::SetValue<u64>(u64 value)
+    {
+        ASSERT_TYPE_IN_ARRAY(TokenType::INTEGER);
+        m_value.numberValue.intValue = value;
+        m_value.viewValue = std::string_view();
+    }
+
+    template <>
+    u64 Token::GetValue<u64>() const
+    {
+        ASSERT_TYPE_IN_ARRAY(TokenType::INTEGER);
+        DecodeLiteral();
+        return m_value.numberValue.intValue;
+    }
+
+    template <>
+    void Token::SetValue<u32>(u32 value)
+    {
+        SetValue<u64>(value);
+    }
+
+    template <>
+    u32 Token::GetValue<u32>() const
+    {
+        return u32(std::min(GetValue<u64>(), u64(0xFFFFFFFF)));
+    }
+
+    template <>
+    void Token::SetValue<f64>(f64 value)
+    {
+        ASSERT_TYPE_IN_ARRAY(TokenType::FLOAT);
+        m_value.numberValue.floatValue = value;
+        m_value.viewValue = std::string_view();
+    }
+
+    template <>
+    f64 Token::GetValue<f64>() const
+    {
+        ASSERT_TYPE_IN_ARRAY(TokenType::FLOAT);
+        DecodeLiteral();
+        return m_value.numberValue.floatValue;
+    }
+
+    template <>
+    void Token::SetValue<f32>(f32 value)
+    {
+        SetValue<f64>(value);
+    }
+
+    template <>
+    f32 Token::GetValue<f32>() const
+    {
+        return f32(GetValue<f64>());
+    }
+
+    void Token::SetLiteral(std::string_view text)
+    {
+        ASSERT_TYPE_IN_ARRAY(TokenType::INTEGER, TokenType::FLOAT);
+        m_value.viewValue = text;
+        m_decodeState = DecodeState::NOT_DECODED;
+    }
+
+    void Token::DecodeLiteral() const
+    {
+        if (!IsView() || m_decodeState != DecodeState::NOT_DECODED)
+        {
+            return;
+        }
+
+        b8 isOutOfRange = NTT_FALSE;
+        if (m_type == TokenType::INTEGER)
+        {
+            m_value.numberValue.intValue = DecodeInteger(m_value.viewValue, isOutOfRange);
+        }
+        else
+        {
+            m_value.numberValue.floatValue = DecodeFloat(m_value.viewValue, isOutOfRange);
+        }
+        m_decodeState = isOutOfRange ? DecodeState::OUT_OF_RANGE : DecodeState::DECODED;
+    }
+
+    template <>
+    b8 Token::IsValueOutOfRange<u64>() const
+    {
+        if (m_type != TokenType::INTEGER && m_type != TokenType::FLOAT)
+        {
+            return NTT_FALSE;
+        }
+
+        DecodeLiteral();
+        return m_decodeState == DecodeState::OUT_OF_RANGE;
+    }
+
+    template <>
+    b8 Token::IsValueOutOfRange<f64>() const
+    {
+        return IsValueOutOfRange<u64>();
+    }
+
+    template <>
+    b8 Token::IsValueOutOfRange<u32>() const
+    {
+        return IsValueOutOfRange<u64>() ||
+               (m_type == TokenType::INTEGER && GetValue<u64>() > u64(0xFFFFFFFF));
+    }
+#define ASSERT_STRING_TYPE()                                       \
+    ASSERT_TYPE_IN_ARRAY(TokenType::STRING,                        \
+                         TokenType::INVALID, TokenType::KEYWORD,   \
+                         TokenType::BRACKET,                       \
+                         TokenType::DELIMITER,                     \
+                         TokenType::IDENTIFIER,                    \
+                         TokenType::OPERATOR,                      \
+                         TokenType::TYPE_HINT,                     \
+                         TokenType::NONE)
+
+    template <>
+    void Token::SetValue<std::string>(std::string value)
+    {
+        ASSERT_STRING_TYPE();
+        m_value.stringValue = std::move(value);
+        m_value.viewValue = std::string_view();
+        UpdateSymbol();
+    }
+
+    template <>
+    std::string Token::GetValue<std::string>() const
+    {
+        ASSERT_STRING_TYPE();
+        if (IsView())
+        {
+            return std::string(m_value.viewValue);
+        }
+        return m_value.stringValue;
+    }
+
+    template <>
+    void Token::SetValue<std::string_view>(std::string_view value)
+    {
+        ASSERT_STRING_TYPE();
+        m_value.stringValue.clear();
+        m_value.viewValue = value;
+        UpdateSymbol();
+    }
+
+    void Token::SetText(std::string_view text, Symbol symbol)
+    {
+        ASSERT_STRING_TYPE();
+        m_value.stringValue.clear();
+        m_value.viewValue = text;
+        m_symbol = symbol;
+    }
+
+    void Token::Rebase(u32 startIndex, const SourceFile &source)
+    {
+        m_startIndex = startIndex;
+        if (IsView())
+        {
+            m_value.viewValue = source.GetView(startIndex, u32(m_value.viewValue.length()));
+        }
+    }
+
+    template <>
+    std::string_view Token::GetValue<std::string_view>() const
+    {
+        // the literal of a number is also its text.
+        ASSERT_TYPE_IN_ARRAY(TokenType::STRING,
+                             TokenType::INVALID, TokenType::KEYWORD,
+                             TokenType::BRACKET,
+                             TokenType::DELIMITER,
+                             TokenType::IDENTIFIER,
+                             TokenType::OPERATOR,
+                             TokenType::TYPE_HINT,
+                             TokenType::NONE,
+                             TokenType::INTEGER, TokenType::FLOAT);
+        if (IsView())
+        {
+            return m_value.viewValue;
+        }
+        return m_value.stringValue;
+    }
+
+    void Token::UpdateSymbol()
+    {
+        switch (m_type)
+        {
+        case TokenType::KEYWORD:
+        case TokenType::BRACKET:
+        case TokenType::DELIMITER:
+        case TokenType::IDENTIFIER:
+        case TokenType::TYPE_HINT:
+        case TokenType::OPERATOR:
+        case TokenType::NONE:
+            m_symbol = SymbolTable::Get().Intern(GetValue<std::string_view>());
+            break;
+        default:
+            m_symbol = Symbol::NONE;
+            break;
+        }
+    }
+
+    JSON Token::ToJSON(const LineIndex *lineIndex) const
     {
         JSON json;
         json["type"] = TokenTypeToString(m_type);
         json["startIndex"] = m_startIndex;
         json["length"] = m_length;
+        if (lineIndex != NTT_NULL)
+        {
+            SourceLocation location = lineIndex->GetLocation(m_startIndex);
+            json["line"] = location.line;
+            json["column"] = location.column;
+        }
         switch (m_type)
         {
         case TokenType::INTEGER:
-            json["value"] = m_value.numberValue.intValue;
+            json["value"] = GetValue<u64>();
             break;
         case TokenType::FLOAT:
-            json["value"] = m_value.numberValue.floatValue;
+            json["value"] = GetValue<f32>();
             break;
         case TokenType::BOOLEAN:
             json["value"] = m_value.numberValue.boolValue;
@@ -84,7 +334,7 @@ namespace ntt
         case TokenType::IDENTIFIER:
         case TokenType::TYPE_HINT:
         case TokenType::OPERATOR:
-            json["value"] = m_value.stringValue;
+            json["value"] = GetValue<std::string>();
             break;
         default:
             break;
@@ -0,0 +1,296 @@
+#include "tokenizer/token_buffer.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace ntt
+{
+    TokenBuffer::TokenBuffer(const Ref<SourceFile> &source)
+        : m_source(source)
+    {
+    }
+
+    TokenBuffer::~TokenBuffer()
+    {
+    }
+
+    void TokenBuffer::Push(const Token &token)
+    {
+        PackedToken packedToken = {token.GetStartIndex(), token.GetLength(), 0, u8(token.GetType()), 0};
+
+        switch (token.GetType())
+        {
+        case TokenType::BOOLEAN:
+            packedToken.payload = u32(token.GetValue<b8>());
+            break;
+        case TokenType::INTEGER:
+        case TokenType::FLOAT:
+            if (!token.IsView())
+            {
+                u64 valueBits;
+                if (token.GetType() == TokenType::FLOAT)
+                {
+                    f64 floatValue = token.GetValue<f64>();
+                    std::memcpy(&valueBits, &floatValue, sizeof(floatValue));
+                }
+                else
+                {
+                    valueBits = token.GetValue<u64>();
+                }
+
+                packedToken.flags = PackedToken::VALUE_IN_TABLE;
+                packedToken.payload = u32(m_numberValues.size());
+                m_numberValues.push_back(valueBits);
+                break;
+            }
+            [[fallthrough]];
+        default:
+        {
+            std::string_view text = token.GetValue<std::string_view>();
+            if (text.empty() && token.GetSymbol() == Symbol::NONE)
+            {
+                break;
+            }
+
+            if (m_source != NTT_NULL &&
+                token.GetStartIndex() + token.GetLength() <= m_source->GetLength() &&
+                text.data() == m_source->GetData() + token.GetStartIndex() &&
+                text.length() == token.GetLength())
+            {
+                packedToken.flags = PackedToken::TEXT_IN_SOURCE;
+                packedToken.payload = u32(token.GetSymbol());
+                break;
+            }
+
+            packedToken.flags = PackedToken::TEXT_IN_ARENA;
+            packedToken.payload = u32(m_textSpans.size());
+            m_textSpans.push_back({u32(m_textArena.length()), u32(text.length()), token.GetSymbol()});
+            m_textArena.append(text);
+            break;
+        }
+        }
+
+        m_tokens.push_back(packedToken);
+    }
+
+    void TokenBuffer::Append(TokenBuffer &&other)
+    {
+        Replace(GetSize(), 0, other);
+    }
+
+    void TokenBuffer::Replace(u32 firstToken, u32 numberOfRemovedTokens, const TokenBuffer &insertedTokens)
+    {
+        NTT_ASSERT(firstToken + numberOfRemovedTokens <= GetSize());
+
+        for (u32 tokenIndex = firstToken; tokenIndex < firstToken + numberOfRemovedTokens; tokenIndex++)
+        {
+            const PackedToken &token = m_tokens[tokenIndex];
+            m_numberOfUnusedSpans += token.HasFlag(PackedToken::TEXT_IN_ARENA) ? 1 : 0;
+            m_numberOfUnusedValues += token.HasFlag(PackedToken::VALUE_IN_TABLE) ? 1 : 0;
+        }
+
+        u32 numberOfInsertedTokens = insertedTokens.GetSize();
+        u32 numberOfReplacedTokens = std::min(numberOfRemovedTokens, numberOfInsertedTokens);
+        const PackedToken *inserted = insertedTokens.m_tokens.data();
+
+        std::copy(inserted, inserted + numberOfReplacedTokens, m_tokens.begin() + firstToken);
+        if (numberOfRemovedTokens > numberOfInsertedTokens)
+        {
+            m_tokens.erase(m_tokens.begin() + firstToken + numberOfReplacedTokens,
+                           m_tokens.begin() + firstToken + numberOfRemovedTokens);
+        }
+        else
+        {
+            m_tokens.insert(m_tokens.begin() + firstToken + numberOfRemovedTokens,
+                            inserted + numberOfReplacedTokens, inserted + numberOfInsertedTokens);
+        }
+
+        // the spans and values of the inserted tokens are moved into the side tables of
+        //      this buffer, the replaced ones are left unused until the next compaction.
+        for (u32 tokenIndex = firstToken; tokenIndex < firstToken + numberOfInsertedTokens; tokenIndex++)
+        {
+            PackedToken &token = m_tokens[tokenIndex];
+            if (token.HasFlag(PackedToken::TEXT_IN_ARENA))
+            {
+                TextSpan span = insertedTokens.m_textSpans[token.payload];
+                token.payload = u32(m_textSpans.size());
+                m_textSpans.push_back({u32(m_textArena.length()), span.length, span.symbol});
+                m_textArena.append(insertedTokens.m_textArena, span.offset, span.length);
+            }
+            else if (token.HasFlag(PackedToken::VALUE_IN_TABLE))
+            {
+                u64 valueBits = insertedTokens.m_numberValues[token.payload];
+                token.payload = u32(m_numberValues.size());
+                m_numberValues.push_back(valueBits);
+            }
+        }
+
+        // compacting once at least half of the entries are unused keeps it amortized
+        //      linear in the number of replaced tokens.
+        if (m_numberOfUnusedSpans * 2 > m_textSpans.size() ||
+            m_numberOfUnusedValues * 2 > m_numberValues.size())
+        {
+            Compact();
+        }
+    }
+
+    void TokenBuffer::Compact()
+    {
+        Vector<TextSpan> textSpans;
+        String textArena;
+        Vector<u64> numberValues;
+        textSpans.reserve(m_textSpans.size() - m_numberOfUnusedSpans);
+        numberValues.reserve(m_numberValues.size() - m_numberOfUnusedValues);
+
+        for (PackedToken &token : m_tokens)
+        {
+            if (token.HasFlag(PackedToken::TEXT_IN_ARENA))
+            {
+                const TextSpan &span = m_textSpans[token.payload];
+                token.payload = u32(textSpans.size());
+                textSpans.push_back({u32(textArena.length()), span.length, span.symbol});
+                textArena.append(m_textArena, span.offset, span.length);
+            }
+            else if (token.HasFlag(PackedToken::VALUE_IN_TABLE))
+            {
+                numberValues.push_back(m_numberValues[token.payload]);
+                token.payload = u32(numberValues.size() - 1);
+            }
+        }
+
+        m_textSpans = std::move(textSpans);
+        m_textArena = std::move(textArena);
+        m_numberValues = std::move(numberValues);
+        m_numberOfUnusedSpans = 0;
+        m_numberOfUnusedValues = 0;
+    }
+
+    std::string_view TokenBuffer::GetText(u32 index) const
+    {
+        const PackedToken &token = m_tokens[index];
+        if (token.HasFlag(PackedToken::TEXT_IN_SOURCE))
+        {
+            return m_source->GetView(token.startIndex, token.length);
+        }
+
+        if (token.HasFlag(PackedToken::TEXT_IN_ARENA))
+        {
+            const TextSpan &span = m_textSpans[token.payload];
+            return std::string_view(m_textArena.data() + span.offset, span.length);
+        }
+
+        return std::string_view();
+    }
+
+    Symbol TokenBuffer::GetSymbol(u32 index) const
+    {
+        const PackedToken &token = m_tokens[index];
+        if (token.HasFlag(PackedToken::TEXT_IN_SOURCE))
+        {
+            return Symbol(token.payload);
+        }
+
+        if (token.HasFlag(PackedToken::TEXT_IN_ARENA))
+        {
+            return m_textSpans[token.payload].symbol;
+        }
+
+        return Symbol::NONE;
+    }
+
+    Token TokenBuffer::Unpack(const PackedToken &packedToken, const SourceFile &source)
+    {
+        NTT_ASSERT(!packedToken.HasFlag(PackedToken::TEXT_IN_ARENA) &&
+                   !packedToken.HasFlag(PackedToken::VALUE_IN_TABLE));
+
+        Token token(packedToken.GetType(), packedToken.startIndex);
+        token.SetLength(packedToken.length);
+
+        if (packedToken.GetType() == TokenType::BOOLEAN)
+        {
+            token.SetValue<b8>(packedToken.payload != 0);
+        }
+        else if (packedToken.HasFlag(PackedToken::TEXT_IN_SOURCE))
+        {
+            std::string_view text = source.GetView(packedToken.startIndex, packedToken.length);
+            if (packedToken.GetType() == TokenType::INTEGER || packedToken.GetType() == TokenType::FLOAT)
+            {
+                token.SetLiteral(text);
+            }
+            else
+            {
+                token.SetText(text, Symbol(packedToken.payload));
+            }
+        }
+
+        return token;
+    }
+
+    Token TokenBuffer::GetToken(u32 index) const
+    {
+        const PackedToken &packedToken = m_tokens[index];
+        if (packedToken.HasFlag(PackedToken::TEXT_IN_SOURCE))
+        {
+            return Unpack(packedToken, *m_source);
+        }
+
+        Token token(packedToken.GetType(), packedToken.startIndex);
+        token.SetLength(packedToken.length);
+
+        switch (packedToken.GetType())
+        {
+        case TokenType::INTEGER:
+            if (packedToken.HasFlag(PackedToken::VALUE_IN_TABLE))
+            {
+                token.SetValue<u64>(m_numberValues[packedToken.payload]);
+            }
+            else if (packedToken.flags != 0)
+            {
+                token.SetLiteral(GetText(index));
+            }
+            break;
+        case TokenType::FLOAT:
+            if (packedToken.HasFlag(PackedToken::VALUE_IN_TABLE))
+            {
+                f64 floatValue;
+                std::memcpy(&floatValue, &m_numberValues[packedToken.payload], sizeof(floatValue));
+                token.SetValue<f64>(floatValue);
+            }
+            else if (packedToken.flags != 0)
+            {
+                token.SetLiteral(GetText(index));
+            }
+            break;
+        case TokenType::BOOLEAN:
+            token.SetValue<b8>(packedToken.payload != 0);
+            break;
+        default:
+            if (packedToken.flags != 0)
+            {
+                token.SetText(GetText(index), GetSymbol(index));
+            }
+            break;
+        }
+
+        return token;
+    }
+
+    Vector<Token> TokenBuffer::GetTokens() const
+    {
+        Vector<Token> tokens;
+        tokens.reserve(m_tokens.size());
+        for (u32 tokenIndex = 0; tokenIndex < GetSize(); tokenIndex++)
+        {
+            tokens.push_back(GetToken(tokenIndex));
+        }
+        return tokens;
+    }
+
+    u64 TokenBuffer::GetMemoryUsage() const
+    {
+        return u64(m_tokens.capacity()) * sizeof(PackedToken) +
+               u64(m_textSpans.capacity()) * sizeof(TextSpan) +
+               u64(m_textArena.capacity()) +
+               u64(m_numberValues.capacity()) * sizeof(u64);
+    }
+} // namespace ntt
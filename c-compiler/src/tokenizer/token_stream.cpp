@@ -0,0 +1,81 @@
+#include "tokenizer/token_stream.h"
+#include "tokenizer/tokenizer.h"
+#include "tokenizer/scan_kernels.h"
+
+namespace ntt
+{
+    static_assert((TokenStream::LOOKAHEAD_CAPACITY & (TokenStream::LOOKAHEAD_CAPACITY - 1)) == 0,
+                  "The lookahead capacity must be a power of two.");
+
+    TokenStream::TokenStream(const String &input)
+        : m_source(CreateRef<SourceFile>(input))
+    {
+    }
+
+    TokenStream::TokenStream(const Ref<SourceFile> &source)
+        : m_source(source)
+    {
+        NTT_ASSERT(m_source != NTT_NULL);
+    }
+
+    TokenStream::~TokenStream()
+    {
+    }
+
+    b8 TokenStream::IsAtEnd()
+    {
+        Fill(1);
+        return m_lookaheadCount == 0;
+    }
+
+    Token TokenStream::Next()
+    {
+        Fill(1);
+        if (m_lookaheadCount == 0)
+        {
+            return GetEndToken();
+        }
+
+        const PackedToken &token = m_lookahead[m_lookaheadStart];
+        m_lookaheadStart = (m_lookaheadStart + 1) & (LOOKAHEAD_CAPACITY - 1);
+        m_lookaheadCount--;
+        return TokenBuffer::Unpack(token, *m_source);
+    }
+
+    Token TokenStream::Peek(u32 distance)
+    {
+        NTT_ASSERT(distance < LOOKAHEAD_CAPACITY);
+
+        Fill(distance + 1);
+        if (distance >= m_lookaheadCount)
+        {
+            return GetEndToken();
+        }
+
+        return TokenBuffer::Unpack(m_lookahead[(m_lookaheadStart + distance) & (LOOKAHEAD_CAPACITY - 1)], *m_source);
+    }
+
+    void TokenStream::Fill(u32 numberOfTokens)
+    {
+        const char *input = m_source->GetData();
+        u32 inputLength = m_source->GetLength();
+
+        while (m_lookaheadCount < numberOfTokens)
+        {
+            m_cursor += CountLeadingSpaces(input + m_cursor, inputLength - m_cursor);
+            if (m_cursor >= inputLength)
+            {
+                break;
+            }
+
+            m_lookahead[(m_lookaheadStart + m_lookaheadCount) & (LOOKAHEAD_CAPACITY - 1)] =
+                Tokenizer::ReadToken(*m_source, m_cursor, NTT_TRUE);
+            m_lookaheadCount++;
+        }
+    }
+
+    Token TokenStream::GetEndToken() const
+    {
+        return Token(TokenType::NONE, m_source->GetLength());
+    }
+} // namespace ntt
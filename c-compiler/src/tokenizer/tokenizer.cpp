@@ -1,76 +1,24 @@
 #include "tokenizer/tokenizer.h"
+#include "tokenizer/lexer_dfa.h"
+#include "tokenizer/lexeme_tables.h"
+#include "tokenizer/scan_kernels.h"
+#include "tokenizer/worker_pool.h"
 #include <utility>
-#include <regex>
-#include <set>
+#include <algorithm>
 
 namespace ntt
 {
     namespace
     {
-        std::set<std::string> keywords = {
-            // types
-            "number",
-            "string",
-            "boolean",
-            "null",
-            "any",
-
-            // control flow
-            "if",
-            "else",
-            "while",
-            "for",
-
-            // declaration
-            "const",
-            "let",
-            "function",
-            "class",
-        };
-
         typedef std::pair<TokenType, std::vector<std::string>> TokenRegexPair;
 
+        /**
+         * The patterns of the tokens which have no fixed spelling. The operators, brackets,
+         *      delimiters and type hint are matched by `MatchOperator` and `MatchPunctuation`
+         *      (checked against the spellings of their symbols) before the automaton runs,
+         *      so they have no rule here.
+         */
         std::vector<TokenRegexPair> regexes = {
-            {
-                TokenType::OPERATOR,
-                {
-                    "^\\+=",
-                    "^\\-=",
-                    "^\\*=",
-                    "^\\/=",
-                    "^\\%=",
-                    "^\\&=",
-                    "^\\|=",
-                    "^\\^=",
-                    "^\\@=",
-
-                    "^==",
-                    "^!=",
-                    "^>=",
-                    "^<=",
-                    "^>",
-                    "^<",
-
-                    "^&&",
-                    "^\\|\\|",
-
-                    "^\\++",
-                    "^\\--",
-
-                    "^\\+",
-                    "^\\-",
-                    "^\\*",
-                    "^\\/",
-                    "^\\%",
-                    "^\\^",
-                    "^@",
-                    "^!",
-                    "^\\|",
-                    "^&",
-
-                    "^=",
-                },
-            },
             {
                 TokenType::INVALID,
                 {
@@ -83,30 +31,6 @@ namespace ntt
                     "^[a-zA-Z_][a-zA-Z0-9_]*",
                 },
             },
-            {
-                TokenType::DELIMITER,
-                {
-                    "^\\;",
-                    "^\\,",
-                },
-            },
-            {
-                TokenType::BRACKET,
-                {
-                    "^\\(",
-                    "^\\{",
-                    "^\\[",
-                    "^\\)",
-                    "^\\}",
-                    "^\\]",
-                },
-            },
-            {
-                TokenType::TYPE_HINT,
-                {
-                    "^\\:",
-                },
-            },
             {
                 TokenType::FLOAT,
                 {
@@ -124,207 +48,512 @@ namespace ntt
             {
                 TokenType::STRING,
                 {
-                    "^\"((?:[^\"\\\\]|\\\\.)*)\"",
+                    // the escaped character may be a new line.
+                    "^\"((?:[^\"\\\\]|\\\\(?:.|\n))*)\"",
                 },
             },
         };
+
+        /**
+         * The automaton is built once from the `regexes` table, the rules keep the
+         *      order of the table so the first listed pattern still has the priority.
+         */
+        const LexerDfa &GetLexerDfa()
+        {
+            static const LexerDfa lexerDfa = []()
+            {
+                Vector<LexerRule> rules;
+                for (const auto &[tokenType, regexList] : regexes)
+                {
+                    for (const auto &regex : regexList)
+                    {
+                        rules.push_back({tokenType, regex});
+                    }
+                }
+                return LexerDfa(rules);
+            }();
+
+            return lexerDfa;
+        }
+
+        /**
+         * @return The index after the last character the lexer looked at when it read the
+         *      token, a token does not change while the text before that index does not.
+         */
+        u32 GetScanEnd(const PackedToken &token, const char *input)
+        {
+            // an unterminated string is only known to be invalid once the automaton reached
+            //      the end of the input, every other token is decided by its characters and
+            //      the first one after it.
+            if (token.GetType() == TokenType::INVALID && input[token.startIndex] == '"')
+            {
+                return 0xFFFFFFFF;
+            }
+
+            return token.startIndex + token.length + 1;
+        }
+
+        /**
+         * @return A token whose text is the matched characters of the source file.
+         */
+        PackedToken MakeTextToken(TokenType type, u32 startIndex, u32 length, Symbol symbol)
+        {
+            return {startIndex, length, u32(symbol), u8(type), PackedToken::TEXT_IN_SOURCE};
+        }
+
+        PackedToken MakeValueToken(TokenType type, u32 startIndex, u32 length, u32 payload)
+        {
+            return {startIndex, length, payload, u8(type), 0};
+        }
+
+        /**
+         * @return Whether the text of the tokens of this type is interned.
+         */
+        b8 HasSymbol(TokenType type)
+        {
+            return type != TokenType::STRING && type != TokenType::INVALID &&
+                   type != TokenType::INTEGER && type != TokenType::FLOAT;
+        }
+
+        /**
+         * The lexers which run on the worker threads do not intern anything, they only look
+         *      up the texts which are already interned and leave the others to the merge,
+         *      which interns them in the order of the tokens as the serial lexer does.
+         */
+        Symbol LookUpSymbol(std::string_view text, b8 isInterning)
+        {
+            return isInterning ? SymbolTable::Get().Intern(text) : SymbolTable::Get().Find(text);
+        }
+
+        b8 IsSpace(char character)
+        {
+            return character == ' ' || character == '\n';
+        }
+
+        b8 IsDigit(char character)
+        {
+            return character >= '0' && character <= '9';
+        }
+
+        b8 IsIdentifierStart(char character)
+        {
+            return (character >= 'a' && character <= 'z') ||
+                   (character >= 'A' && character <= 'Z') ||
+                   character == '_';
+        }
+
+        /**
+         * @return Whether the quote at `index` is escaped, only used to guess where the
+         *      strings are so it does not look further back than one character.
+         */
+        b8 IsQuote(const char *input, u32 index)
+        {
+            return input[index] == '"' && (index == 0 || input[index - 1] != '\\');
+        }
+
+        /**
+         * Each chunk of a parallel tokenization is at least this long, smaller inputs are
+         *      lexed on fewer threads.
+         */
+        constexpr u32 MINIMUM_CHUNK_LENGTH = 16 * 1024;
     } // namespace anonymous
 
-    Tokenizer::Tokenizer(const char *input) : m_input(input)
+    Tokenizer::Tokenizer(const char *input)
+        : m_tokens(CreateRef<SourceFile>(String(input)))
+    {
+        TokenizeInput();
+    }
+
+    Tokenizer::Tokenizer(const std::string &input)
+        : m_tokens(CreateRef<SourceFile>(input))
+    {
+        TokenizeInput();
+    }
+
+    Tokenizer::Tokenizer(const char *input, u32 length)
+        : m_tokens(CreateRef<SourceFile>(input, length))
     {
-        PreProcessContent();
         TokenizeInput();
     }
 
-    Tokenizer::Tokenizer(const std::string &input) : m_input(input)
+    Tokenizer::Tokenizer(const Ref<SourceFile> &source)
+        : m_tokens(source)
     {
-        PreProcessContent();
+        NTT_ASSERT(source != NTT_NULL);
         TokenizeInput();
     }
 
+    Tokenizer::Tokenizer(const Ref<SourceFile> &source, u32 numberOfThreads)
+        : m_tokens(source)
+    {
+        NTT_ASSERT(source != NTT_NULL);
+        TokenizeInputInParallel(numberOfThreads);
+    }
+
     Tokenizer::~Tokenizer()
     {
     }
 
-    void Tokenizer::PreProcessContent()
+    void Tokenizer::TokenizeInput()
     {
-        std::string temporaryContent = "";
-        u32 characterIndex = 0;
-        u32 inputLength = (u32)m_input.length();
+        m_lineIndex = LineIndex(GetSource()->GetData(), GetSource()->GetLength());
+        LexRange(0, GetSource()->GetLength(), NTT_TRUE, m_tokens);
+    }
 
-        while (characterIndex < inputLength)
+    void Tokenizer::LexRange(u32 startIndex, u32 endIndex, b8 isInterning, TokenBuffer &outTokens) const
+    {
+        const char *input = GetSource()->GetData();
+        u32 cursor = startIndex;
+
+        while (cursor < endIndex)
         {
-            char curentCharacter = m_input[characterIndex];
+            // skip spaces and new line characters
+            cursor += CountLeadingSpaces(input + cursor, endIndex - cursor);
 
-            if (curentCharacter != '\n')
-            {
-                temporaryContent += curentCharacter;
-            }
-            else
+            if (cursor >= endIndex)
             {
-                temporaryContent += ' ';
+                break;
             }
 
-            characterIndex++;
+            outTokens.Push(ReadToken(*GetSource(), cursor, isInterning));
         }
-
-        NTT_ASSERT(temporaryContent.length() == m_input.length());
-        m_input = std::move(temporaryContent);
     }
 
-    void Tokenizer::TokenizeInput()
+    void Tokenizer::TokenizeInputInParallel(u32 numberOfThreads)
     {
-        std::string temporaryContent = m_input;
+        const char *input = GetSource()->GetData();
+        u32 inputLength = GetSource()->GetLength();
 
-        while (temporaryContent.length() > 0)
+        if (numberOfThreads == 0)
         {
-            // remove spaces and new line characters
+            numberOfThreads = WorkerPool::Get().GetConcurrency();
+        }
+
+        u32 numberOfChunks = std::min(numberOfThreads, std::max(1u, inputLength / MINIMUM_CHUNK_LENGTH));
+        if (numberOfChunks == 1)
+        {
+            TokenizeInput();
+            return;
+        }
+
+        // count the quotes of every chunk, the parity before a position tells whether it
+        //      is (most likely) inside a string.
+        Vector<u32> numberOfQuotes(numberOfChunks, 0);
+        WorkerPool::Get().Run(
+            numberOfChunks,
+            [&](u32 chunkIndex)
             {
-                while (true)
+                u32 endIndex = u32(u64(inputLength) * (chunkIndex + 1) / numberOfChunks);
+                for (u32 index = u32(u64(inputLength) * chunkIndex / numberOfChunks); index < endIndex; index++)
                 {
-                    bool isTemporaryContentEmpty = temporaryContent.length() == 0;
+                    numberOfQuotes[chunkIndex] += IsQuote(input, index);
+                }
+            });
 
-                    if (isTemporaryContentEmpty)
-                    {
-                        break;
-                    }
+        // every chunk starts at a new line (or a space) with an even number of quotes before
+        //      it, the chunks which find none are merged into the previous one.
+        Vector<u32> chunkStarts = {0};
+        u32 numberOfQuotesBefore = 0;
+        for (u32 chunkIndex = 1; chunkIndex < numberOfChunks; chunkIndex++)
+        {
+            numberOfQuotesBefore += numberOfQuotes[chunkIndex - 1];
 
-                    char firstTemporaryCharacter = temporaryContent[0];
+            u32 chunkEnd = u32(u64(inputLength) * (chunkIndex + 1) / numberOfChunks);
+            u32 index = u32(u64(inputLength) * chunkIndex / numberOfChunks);
+            u32 parity = numberOfQuotesBefore % 2;
+            u32 spaceIndex = chunkEnd;
 
-                    if (firstTemporaryCharacter == ' ' || firstTemporaryCharacter == '\n')
-                    {
-                        temporaryContent = temporaryContent.substr(1);
-                    }
-                    else
-                    {
-                        break;
-                    }
+            for (; index < chunkEnd; index++)
+            {
+                if (parity == 0 && input[index] == '\n')
+                {
+                    break;
                 }
 
-                if (temporaryContent.length() == 0)
+                if (parity == 0 && input[index] == ' ' && spaceIndex == chunkEnd)
                 {
-                    break;
+                    spaceIndex = index;
                 }
+
+                parity ^= u32(IsQuote(input, index));
+            }
+
+            index = index < chunkEnd ? index : spaceIndex;
+            if (index < chunkEnd && index > chunkStarts.back())
+            {
+                chunkStarts.push_back(index);
             }
+        }
+        chunkStarts.push_back(inputLength);
+
+        numberOfChunks = u32(chunkStarts.size()) - 1;
+        Vector<TokenBuffer> chunkTokens(numberOfChunks, TokenBuffer(GetSource()));
 
-            b8 hasMatched = NTT_FALSE;
-            u32 currentRawInputIndex = (u32)m_input.length() - (u32)temporaryContent.length();
-            for (const auto &[tokenType, regexList] : regexes)
+        // the last task indexes the lines while the others lex the chunks.
+        WorkerPool::Get().Run(
+            numberOfChunks + 1,
+            [&](u32 chunkIndex)
             {
-                for (const auto &regex : regexList)
+                if (chunkIndex == numberOfChunks)
                 {
-                    std::smatch match;
-                    std::regex rgx(regex);
-                    if (std::regex_search(temporaryContent, match, rgx))
-                    {
-                        std::string matchedStr = match.str(0);
-                        temporaryContent = temporaryContent.substr(matchedStr.length());
-                        Token token(tokenType, currentRawInputIndex);
-
-                        switch (tokenType)
-                        {
-                        case TokenType::INTEGER:
-                        {
-                            u32 intValue = std::stoul(matchedStr);
-                            token.SetValue<u32>(intValue);
-                            break;
-                        }
-                        case TokenType::FLOAT:
-                        {
-                            f32 floatValue = std::stof(matchedStr);
-                            token.SetValue<f32>(floatValue);
-                            break;
-                        }
-                        case TokenType::IDENTIFIER:
-                        {
-                            if (keywords.find(matchedStr) != keywords.end())
-                            {
-                                token = Token(TokenType::KEYWORD, currentRawInputIndex);
-                            }
-                            else if (matchedStr == "true")
-                            {
-                                token = Token(TokenType::BOOLEAN, currentRawInputIndex);
-                                token.SetValue<b8>(NTT_TRUE);
-                                break;
-                            }
-                            else if (matchedStr == "false")
-                            {
-                                token = Token(TokenType::BOOLEAN, currentRawInputIndex);
-                                token.SetValue<b8>(NTT_FALSE);
-                                break;
-                            }
-                            else
-                            {
-                                token = Token(TokenType::IDENTIFIER, currentRawInputIndex);
-                            }
-                            token.SetValue<std::string>(matchedStr);
-                            break;
-                        }
-                        case TokenType::STRING:
-                        case TokenType::DELIMITER:
-                        case TokenType::BRACKET:
-                        case TokenType::INVALID:
-                        case TokenType::OPERATOR:
-                        case TokenType::TYPE_HINT:
-                        {
-                            token.SetValue<std::string>(matchedStr);
-                            break;
-                        }
-                        default:
-                            break;
-                        }
-
-                        token.SetLength((u32)matchedStr.length());
-                        hasMatched = NTT_TRUE;
-                        m_tokens.push_back(token);
-                        break;
-                    }
+                    m_lineIndex = LineIndex(input, inputLength);
+                    return;
+                }
+
+                LexRange(chunkStarts[chunkIndex], chunkStarts[chunkIndex + 1], NTT_FALSE,
+                         chunkTokens[chunkIndex]);
+            });
+
+        // a chunk may start in the middle of a token of the previous one (a string which
+        //      has a new line), the tokens are then lexed again from the end of the
+        //      previous chunk until they reach the start of a token of the chunk, from
+        //      there the lexer is in the same state as the serial one.
+        u32 totalNumberOfTokens = 0;
+        for (const auto &tokens : chunkTokens)
+        {
+            totalNumberOfTokens += tokens.GetSize();
+        }
+        m_tokens.Reserve(totalNumberOfTokens);
+
+        u32 cursor = 0;
+        for (auto &tokens : chunkTokens)
+        {
+            u32 numberOfTokens = tokens.GetSize();
+            u32 tokenIndex = 0;
+
+            while (NTT_TRUE)
+            {
+                cursor += CountLeadingSpaces(input + cursor, inputLength - cursor);
+
+                while (tokenIndex < numberOfTokens && tokens[tokenIndex].startIndex < cursor)
+                {
+                    tokenIndex++;
                 }
 
-                if (hasMatched)
+                if (cursor == inputLength ||
+                    tokenIndex == numberOfTokens ||
+                    tokens[tokenIndex].startIndex == cursor)
                 {
                     break;
                 }
+
+                m_tokens.Push(ReadToken(*GetSource(), cursor, NTT_TRUE));
             }
 
-            if (!hasMatched)
+            // the symbols are interned in the order of the tokens, as the serial lexer does.
+            for (; tokenIndex < numberOfTokens; tokenIndex++)
             {
-                // find the text until next non ' '
-                // or end of the file as invalid token.
+                PackedToken &token = tokens[tokenIndex];
+                if (Symbol(token.payload) == Symbol::NONE && HasSymbol(token.GetType()) &&
+                    token.HasFlag(PackedToken::TEXT_IN_SOURCE))
+                {
+                    token.payload = u32(SymbolTable::Get().Intern(tokens.GetText(tokenIndex)));
+                }
 
-                std::string temporaryInvalidToken = "";
-                u32 characterIndex = 0;
-                u32 temporaryContentLength = (u32)temporaryContent.length();
+                cursor = token.startIndex + token.length;
+                m_tokens.Push(token);
+            }
+        }
 
-                while (characterIndex < temporaryContentLength)
+        LexRange(cursor, inputLength, NTT_TRUE, m_tokens);
+    }
+
+    const std::vector<Token> &Tokenizer::GetTokens() const
+    {
+        if (!m_isUnpacked)
+        {
+            m_unpackedTokens = m_tokens.GetTokens();
+            m_isUnpacked = NTT_TRUE;
+        }
+        return m_unpackedTokens;
+    }
+
+    TokenEdit Tokenizer::ApplyEdit(u32 offset, u32 removedLength, const std::string &insertedText)
+    {
+        m_unpackedTokens.clear();
+        m_isUnpacked = NTT_FALSE;
+
+        // kept alive until the edited text is built.
+        Ref<SourceFile> oldSource = GetSource();
+        NTT_ASSERT(offset + removedLength <= oldSource->GetLength());
+
+        u32 numberOfOldTokens = m_tokens.GetSize();
+        u32 firstToken = 0;
+        while (firstToken < numberOfOldTokens && GetScanEnd(m_tokens[firstToken], oldSource->GetData()) <= offset)
+        {
+            firstToken++;
+        }
+
+        u32 insertedLength = u32(insertedText.length());
+        u32 editEnd = offset + insertedLength;
+
+        std::string content;
+        content.reserve(oldSource->GetLength() - removedLength + insertedLength);
+        content.append(oldSource->GetData(), offset);
+        content.append(insertedText);
+        content.append(oldSource->GetData() + offset + removedLength,
+                       oldSource->GetLength() - offset - removedLength);
+
+        // the texts of the tokens are only positions in the source file, the kept tokens
+        //      before the edit need no update.
+        m_tokens.SetSource(CreateRef<SourceFile>(std::move(content)));
+        m_lineIndex.ApplyEdit(offset, removedLength, insertedText);
+
+        // the tokens are lexed again from the first one which looked at the edited text
+        //      until the cursor reaches the start of an old token after the edit, the
+        //      lexer has no state so everything from there is unchanged.
+        const char *input = GetSource()->GetData();
+        u32 inputLength = GetSource()->GetLength();
+        u32 cursor = firstToken > 0
+                         ? m_tokens[firstToken - 1].startIndex + m_tokens[firstToken - 1].length
+                         : 0;
+        u32 resyncToken = firstToken;
+        TokenBuffer insertedTokens(GetSource());
+
+        while (cursor < inputLength)
+        {
+            cursor += CountLeadingSpaces(input + cursor, inputLength - cursor);
+
+            if (cursor == inputLength)
+            {
+                break;
+            }
+
+            if (cursor >= editEnd)
+            {
+                u32 oldCursor = cursor - insertedLength + removedLength;
+                while (resyncToken < numberOfOldTokens && m_tokens[resyncToken].startIndex < oldCursor)
                 {
-                    char currentCharacter = temporaryContent[characterIndex];
+                    resyncToken++;
+                }
 
-                    if (currentCharacter != ' ')
-                    {
-                        temporaryInvalidToken += currentCharacter;
-                        characterIndex++;
-                    }
-                    else
-                    {
-                        Token newInvalidToken(TokenType::INVALID, currentRawInputIndex);
-                        newInvalidToken.SetValue<std::string>(temporaryInvalidToken);
-                        newInvalidToken.SetLength((u32)temporaryInvalidToken.length());
-                        temporaryContent = temporaryContent.substr((u32)temporaryInvalidToken.length());
-                        m_tokens.push_back(newInvalidToken);
-                        break;
-                    }
+                if (resyncToken < numberOfOldTokens && m_tokens[resyncToken].startIndex == oldCursor)
+                {
+                    break;
                 }
+            }
+
+            insertedTokens.Push(ReadToken(*GetSource(), cursor, NTT_TRUE));
+        }
+
+        if (cursor == inputLength)
+        {
+            resyncToken = numberOfOldTokens;
+        }
+
+        u32 numberOfRemovedTokens = resyncToken - firstToken;
+        u32 numberOfInsertedTokens = insertedTokens.GetSize();
+        m_tokens.Replace(firstToken, numberOfRemovedTokens, insertedTokens);
+
+        for (u32 tokenIndex = firstToken + numberOfInsertedTokens; tokenIndex < m_tokens.GetSize(); tokenIndex++)
+        {
+            m_tokens[tokenIndex].startIndex += insertedLength - removedLength;
+        }
+
+        return {firstToken, numberOfRemovedTokens, numberOfInsertedTokens};
+    }
+
+    PackedToken Tokenizer::ReadToken(const SourceFile &source, u32 &cursor, b8 isInterning)
+    {
+        const LexerDfa &lexerDfa = GetLexerDfa();
+        const char *tokenStart = source.GetData() + cursor;
+        u32 remainingLength = source.GetLength() - cursor;
+        u32 startIndex = cursor;
+        u32 ruleIndex = 0;
+        u32 matchedLength = 0;
+
+        // the operators and the punctuation are recognized directly, the automaton only
+        //      knows the other tokens and none of them starts with their characters.
+        Symbol fixedSymbol = Symbol::NONE;
+        u32 operatorLength = MatchOperator(tokenStart, remainingLength, fixedSymbol);
+        if (operatorLength > 0)
+        {
+            std::string_view operatorStr(tokenStart, operatorLength);
+            cursor += operatorLength;
+            return MakeTextToken(TokenType::OPERATOR, startIndex, operatorLength,
+                                 fixedSymbol != Symbol::NONE
+                                     ? fixedSymbol
+                                     : LookUpSymbol(operatorStr, isInterning));
+        }
+
+        TokenType punctuationType = MatchPunctuation(tokenStart[0], fixedSymbol);
+        if (punctuationType != TokenType::NONE)
+        {
+            cursor++;
+            return MakeTextToken(punctuationType, startIndex, 1, fixedSymbol);
+        }
+
+        // the identifiers and the integers are the most common tokens, their end is found
+        //      directly (the automaton would match the same run) and the automaton only
+        //      runs for the other tokens.
+        TokenType tokenType = TokenType::NONE;
+        if (IsIdentifierStart(tokenStart[0]))
+        {
+            tokenType = TokenType::IDENTIFIER;
+            matchedLength = 1 + CountLeadingIdentifierCharacters(tokenStart + 1, remainingLength - 1);
+        }
+        else if (IsDigit(tokenStart[0]))
+        {
+            // a letter or a dot after the digits makes an invalid token or a float.
+            u32 numberOfDigits = CountLeadingDigits(tokenStart, remainingLength);
+            if (numberOfDigits == remainingLength ||
+                (!IsIdentifierStart(tokenStart[numberOfDigits]) && tokenStart[numberOfDigits] != '.'))
+            {
+                tokenType = TokenType::INTEGER;
+                matchedLength = numberOfDigits;
+            }
+        }
 
-                if (temporaryInvalidToken.length() > 0 && characterIndex == temporaryContentLength) // end of line
+        if (tokenType == TokenType::NONE)
+        {
+            if (!lexerDfa.Match(tokenStart, remainingLength, ruleIndex, matchedLength))
+            {
+                // find the text until next space, new line or end of the file as invalid token.
+                u32 invalidLength = 0;
+                while (invalidLength < remainingLength &&
+                       !IsSpace(tokenStart[invalidLength]))
                 {
-                    Token newInvalidToken(TokenType::INVALID, currentRawInputIndex);
-                    newInvalidToken.SetValue<std::string>(temporaryInvalidToken);
-                    newInvalidToken.SetLength((u32)temporaryInvalidToken.length());
-                    m_tokens.push_back(newInvalidToken);
-                    temporaryContent = "";
+                    invalidLength++;
                 }
+
+                cursor += invalidLength;
+                return MakeTextToken(TokenType::INVALID, startIndex, invalidLength, Symbol::NONE);
             }
+
+            tokenType = lexerDfa.GetRuleType(ruleIndex);
+        }
+
+        std::string_view matchedStr(tokenStart, matchedLength);
+        cursor += matchedLength;
+
+        switch (tokenType)
+        {
+        case TokenType::INTEGER:
+        case TokenType::FLOAT:
+            // the value is only decoded from the text when it is read.
+            return MakeTextToken(tokenType, startIndex, matchedLength, Symbol::NONE);
+        case TokenType::IDENTIFIER:
+        {
+            const KeywordEntry *keyword = FindKeyword(matchedStr);
+
+            if (keyword == NTT_NULL)
+            {
+                return MakeTextToken(TokenType::IDENTIFIER, startIndex, matchedLength,
+                                     LookUpSymbol(matchedStr, isInterning));
+            }
+
+            if (keyword->type == TokenType::BOOLEAN)
+            {
+                return MakeValueToken(TokenType::BOOLEAN, startIndex, matchedLength, u32(keyword->boolValue));
+            }
+
+            return MakeTextToken(keyword->type, startIndex, matchedLength, keyword->symbol);
+        }
+        case TokenType::STRING:
+        case TokenType::INVALID:
+            return MakeTextToken(tokenType, startIndex, matchedLength, Symbol::NONE);
+        default:
+            return MakeTextToken(tokenType, startIndex, matchedLength, LookUpSymbol(matchedStr, isInterning));
         }
     }
 } // namespace ntt
@@ -0,0 +1,88 @@
+#include "tokenizer/worker_pool.h"
+#include <algorithm>
+
+namespace ntt
+{
+    WorkerPool::WorkerPool(u32 numberOfThreads)
+    {
+        m_threads.reserve(numberOfThreads);
+        for (u32 threadIndex = 0; threadIndex < numberOfThreads; threadIndex++)
+        {
+            m_threads.emplace_back([this]() { Work(); });
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isStopping = NTT_TRUE;
+        }
+        m_wakeUp.notify_all();
+
+        for (auto &thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    WorkerPool &WorkerPool::Get()
+    {
+        // the calling thread of `Run` is one of the workers.
+        static WorkerPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+
+    void WorkerPool::Run(u32 numberOfTasks, const std::function<void(u32)> &task)
+    {
+        std::lock_guard<std::mutex> runLock(m_runMutex);
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_task = &task;
+        m_numberOfTasks = numberOfTasks;
+        m_nextTask = 0;
+        m_numberOfFinishedTasks = 0;
+        m_generation++;
+        m_wakeUp.notify_all();
+
+        RunTasks(lock);
+        m_done.wait(lock, [this]() { return m_numberOfFinishedTasks == m_numberOfTasks; });
+        m_task = NTT_NULL;
+    }
+
+    void WorkerPool::Work()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        u64 generation = 0;
+
+        while (NTT_TRUE)
+        {
+            m_wakeUp.wait(lock, [&]() { return m_isStopping || m_generation != generation; });
+            if (m_isStopping)
+            {
+                return;
+            }
+
+            generation = m_generation;
+            RunTasks(lock);
+        }
+    }
+
+    void WorkerPool::RunTasks(std::unique_lock<std::mutex> &lock)
+    {
+        while (m_nextTask < m_numberOfTasks)
+        {
+            u32 taskIndex = m_nextTask++;
+            const std::function<void(u32)> &task = *m_task;
+
+            lock.unlock();
+            task(taskIndex);
+            lock.lock();
+
+            if (++m_numberOfFinishedTasks == m_numberOfTasks)
+            {
+                m_done.notify_all();
+            }
+        }
+    }
+} // namespace ntt
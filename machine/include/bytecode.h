@@ -0,0 +1,161 @@
+#pragma once
+#include "pch.h"
+#include "value.h"
+#include <cstring>
+#include <deque>
+#include <unordered_map>
+
+namespace ntt
+{
+    /**
+     * Instructions of the stack machine. Every instruction is one byte followed by its
+     *      operands, which are written in the byte order of the host:
+     *      - PUSH_CONSTANT: u16 index of the constant.
+     *      - LOAD_VARIABLE, STORE_VARIABLE: u16 slot of the variable.
+     *      - JUMP, JUMP_IF_FALSE: u32 offset of the target instruction.
+     *      - CALL: u16 index of the function and u8 number of arguments.
+     */
+    enum class OpCode : u8
+    {
+        PUSH_CONSTANT,
+        PUSH_NULL,
+        PUSH_TRUE,
+        PUSH_FALSE,
+
+        LOAD_VARIABLE,
+        STORE_VARIABLE,
+        DUPLICATE,
+        POP,
+
+        ADD,
+        SUBTRACT,
+        MULTIPLY,
+        DIVIDE,
+        POWER,
+
+        EQUAL,
+        NOT_EQUAL,
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL,
+        NOT,
+
+        JUMP,
+        JUMP_IF_FALSE,
+        CALL,
+
+        HALT,
+        COUNT,
+    };
+
+    String OpCodeToString(OpCode opCode);
+
+    /**
+     * @return The number of bytes of the instruction, its operands included.
+     */
+    u32 GetInstructionSize(OpCode opCode);
+
+    /**
+     * @return How many values the instruction adds to the stack (negative when it removes
+     *      some), without the arguments which CALL removes.
+     */
+    i32 GetStackEffect(OpCode opCode);
+
+    /**
+     * A compiled program: the instructions with the constants, the variable slots and
+     *      the functions they refer to.
+     */
+    class Bytecode
+    {
+    public:
+        Bytecode();
+        ~Bytecode();
+
+        inline const Vector<u8> &GetCode() const { return m_code; }
+        inline u32 GetSize() const { return u32(m_code.size()); }
+
+        inline const Value &GetConstant(u32 index) const { return m_constants[index]; }
+        inline const Value *GetConstants() const { return m_constants.data(); }
+        inline u32 GetConstantCount() const { return u32(m_constants.size()); }
+
+        /**
+         * Every `let` and `const` gets its own slot, the names are only kept to look the
+         *      variables up from outside the machine.
+         */
+        inline const Vector<String> &GetVariableNames() const { return m_variableNames; }
+        inline u32 GetVariableCount() const { return u32(m_variableNames.size()); }
+
+        /**
+         * The functions are called by index, the machine binds the names to its native
+         *      functions once the program is compiled.
+         */
+        inline const Vector<String> &GetFunctionNames() const { return m_functionNames; }
+
+        inline u32 GetMaxStackDepth() const { return m_maxStackDepth; }
+        inline void SetMaxStackDepth(u32 depth) { m_maxStackDepth = depth; }
+
+        template <typename T>
+        inline T Read(u32 offset) const
+        {
+            T value;
+            std::memcpy(&value, m_code.data() + offset, sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        inline void Write(u32 offset, T value)
+        {
+            std::memcpy(m_code.data() + offset, &value, sizeof(T));
+        }
+
+        /**
+         * Appends an instruction, the operands are written with `Append`.
+         */
+        inline void Emit(OpCode opCode) { m_code.push_back(u8(opCode)); }
+
+        template <typename T>
+        inline void Append(T operand)
+        {
+            m_code.resize(m_code.size() + sizeof(T));
+            Write<T>(GetSize() - sizeof(T), operand);
+        }
+
+        /**
+         * The number constants are shared between the instructions which use the same
+         *      value.
+         */
+        u32 AddNumber(f64 number);
+        u32 AddString(const String &text);
+
+        u32 AddVariable(const String &name);
+        u32 AddFunction(const String &name);
+
+        /**
+         * @return The number of instructions (not bytes) of the code.
+         */
+        u32 GetInstructionCount() const;
+
+        /**
+         * One instruction per line with its operands, used to debug the compiler.
+         */
+        String Disassemble() const;
+
+    private:
+        Vector<u8> m_code;
+        Vector<Value> m_constants;
+
+        /**
+         * Storage of the string constants, a deque never moves its elements so the
+         *      values can point to them.
+         */
+        std::deque<String> m_strings;
+
+        std::unordered_map<u64, u32> m_numberConstants;
+        std::unordered_map<String, u32> m_stringConstants;
+
+        Vector<String> m_variableNames;
+        Vector<String> m_functionNames;
+        u32 m_maxStackDepth;
+    };
+} // namespace ntt
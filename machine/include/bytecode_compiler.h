@@ -0,0 +1,79 @@
+#pragma once
+#include "pch.h"
+#include "bytecode.h"
+#include "lowering_utils.h"
+#include "machine_error.h"
+#include "parser/node.h"
+
+namespace ntt
+{
+    /**
+     * Lowers a parsed program (a PROGRAM block after `Compress` and `Parse`) to the
+     *      bytecode of the stack machine. The expressions leave their value on the stack,
+     *      the statements leave the stack as they found it.
+     */
+    class BytecodeCompiler : public NodeVisitor
+    {
+    public:
+        BytecodeCompiler(Bytecode &bytecode);
+        ~BytecodeCompiler();
+
+        /**
+         * @return The first error met, the bytecode is incomplete when there is one. The
+         *      nodes which carry parsing errors are not compiled.
+         */
+        MachineError Compile(Node &program);
+
+    private:
+        void Visit(Atomic &node) override;
+        void Visit(BlockNode &node) override;
+        void Visit(InvalidNode &node) override;
+        void Visit(OperationNode &node) override;
+        void Visit(UnaryOperationNode &node) override;
+        void Visit(IfStatementNode &node) override;
+        void Visit(FunctionCallNode &node) override;
+        void Visit(VariableDefinitionNode &node) override;
+
+        /**
+         * Compiles an expression, its value is left on the stack.
+         */
+        void CompileNode(Node &node);
+
+        /**
+         * Compiles a statement or an expression whose value is dropped.
+         */
+        void CompileStatement(Node &node);
+
+        void CompileBlock(const Vector<Ref<Node>> &children);
+
+        /**
+         * @param isValueKept Whether the assigned value stays on the stack.
+         */
+        void CompileAssignment(OperationNode &node, b8 isValueKept);
+
+        void Emit(OpCode opCode);
+        void EmitConstant(u32 constantIndex);
+        void EmitVariable(OpCode opCode, u32 slot);
+
+        /**
+         * @return The offset of the target operand, see `PatchJump`.
+         */
+        u32 EmitJump(OpCode opCode);
+
+        /**
+         * Points the jump whose operand is at `operandOffset` to the next instruction.
+         */
+        void PatchJump(u32 operandOffset);
+
+        void SetError(MachineError error);
+
+    private:
+        Bytecode &m_bytecode;
+        MachineError m_error;
+
+        u32 m_stackDepth;
+        u32 m_maxStackDepth;
+
+        VariableScopes m_scopes;
+    };
+} // namespace ntt
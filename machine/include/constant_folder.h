@@ -0,0 +1,95 @@
+#pragma once
+#include "pch.h"
+#include "type_inference.h"
+#include "value.h"
+#include "parser/node.h"
+#include <deque>
+
+namespace ntt
+{
+    /**
+     * Simplifies a parsed program in place before it is lowered:
+     *      - the operations whose operands are literals are replaced by their result,
+     *          computed the way the machine would.
+     *      - the identities `x * 1`, `x / 1`, `x ^ 1`, `x - 0` and `x + (-0)` (and the
+     *          commuted ones) are replaced by `x` when `x` is known to be a number: a
+     *          number literal, an arithmetic operation or a variable the type inference
+     *          proves to be a number. `x + 0` is not folded, it gives `0` for `x = -0`.
+     *      - `!!b` is replaced by `b` when `b` is known to be a boolean.
+     *      - the if statements with a literal condition are replaced by the taken block,
+     *          or removed when that block is empty. The dropped block is not compiled, so
+     *          its compilation errors (an undefined variable for example) go with it.
+     *      - the parentheses (single child EXPRESSION blocks) are removed, the tree
+     *          already keeps the order of the operations.
+     *
+     * The nodes which carry parsing errors are left as they are. The folded tree is only
+     *      meant to be compiled, the tokens of the new literals do not view the source.
+     */
+    class ConstantFolder : public NodeVisitor
+    {
+    public:
+        /**
+         * @param types The types inferred on the program before it is folded, without
+         *      them the variables are never known to be numbers.
+         */
+        ConstantFolder(const TypeInference *types = NTT_NULL);
+        ~ConstantFolder();
+
+        /**
+         * @return The number of nodes removed from the tree.
+         */
+        u32 Fold(Node &program);
+
+        /**
+         * @return The number of nodes removed by all the calls to `Fold`.
+         */
+        inline u32 GetEliminatedNodeCount() const { return m_numberOfEliminatedNodes; }
+
+    private:
+        void Visit(BlockNode &node) override;
+        void Visit(OperationNode &node) override;
+        void Visit(UnaryOperationNode &node) override;
+        void Visit(IfStatementNode &node) override;
+        void Visit(FunctionCallNode &node) override;
+        void Visit(VariableDefinitionNode &node) override;
+
+        /**
+         * Folds the node in the slot and puts its replacement there, the slot is null
+         *      when the node is removed.
+         */
+        void FoldNode(Ref<Node> &node);
+
+        void Replace(const Ref<Node> &replacement, u32 numberOfEliminatedNodes);
+
+        /**
+         * @return Whether the node always gives a number when the machine does not stop
+         *      on it.
+         */
+        b8 IsNumberNode(const Ref<Node> &node) const;
+
+        /**
+         * @return Whether the node is an INTEGER, FLOAT, BOOLEAN or STRING atomic, its
+         *      value is written to `outValue`.
+         */
+        b8 GetLiteral(const Ref<Node> &node, Value &outValue);
+
+        /**
+         * @return An atomic holding `value`, null when the value has no literal (the
+         *      numbers which are not finite).
+         */
+        Ref<Node> CreateLiteral(const Value &value, u32 startIndex) const;
+
+    private:
+        const TypeInference *m_types;
+        u32 m_numberOfEliminatedNodes;
+
+        Ref<Node> m_replacement;
+        b8 m_isRemoved;
+
+        /**
+         * The contents of the string literals read while folding, a deque never moves
+         *      its elements so the values can point to them.
+         */
+        std::deque<String> m_strings;
+    };
+} // namespace ntt
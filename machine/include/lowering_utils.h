@@ -0,0 +1,61 @@
+#pragma once
+#include "pch.h"
+#include "parser/node.h"
+#include "tokenizer/token.h"
+
+namespace ntt
+{
+    /**
+     * @return The symbol of the atomic token, `Symbol::NONE` for the other nodes.
+     */
+    Symbol GetAtomicSymbol(const Ref<Node> &node);
+
+    b8 IsIdentifierAtomic(const Ref<Node> &node);
+
+    /**
+     * The lexed strings keep their quotes and escapes, the ones created by hand (the
+     *      default values) are the plain text.
+     */
+    String GetStringContent(const Token &token);
+
+    /**
+     * The variables the compilers can see while they walk the blocks of a program, the
+     *      innermost definition of a name hides the outer ones.
+     */
+    class VariableScopes
+    {
+    public:
+        struct Variable
+        {
+            Symbol name;
+            u32 slot;
+            b8 isConstant;
+        };
+
+        VariableScopes();
+        ~VariableScopes();
+
+        void PushBlock();
+
+        /**
+         * Forgets the variables defined since the matching `PushBlock`.
+         */
+        void PopBlock();
+
+        inline void Add(Symbol name, u32 slot, b8 isConstant) { m_variables.push_back({name, slot, isConstant}); }
+
+        /**
+         * @return The innermost variable with the name, `NTT_NULL` if there is none.
+         */
+        const Variable *Find(Symbol name) const;
+
+        /**
+         * @return Whether the innermost block already defines the name.
+         */
+        b8 IsDefinedInBlock(Symbol name) const;
+
+    private:
+        Vector<Variable> m_variables;
+        Vector<u32> m_blockStarts;
+    };
+} // namespace ntt
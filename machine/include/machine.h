@@ -0,0 +1,142 @@
+#pragma once
+#include "pch.h"
+#include "bytecode.h"
+#include "machine_error.h"
+#include "register_bytecode.h"
+#include "value.h"
+#include "parser/node.h"
+#include <deque>
+#include <unordered_map>
+
+namespace ntt
+{
+    class Machine;
+
+    /**
+     * Function of the host which the programs can call, it returns the value of the call.
+     */
+    typedef Value (*NativeFunction)(Machine &machine, const Value *arguments, u32 numberOfArguments);
+
+    /**
+     * The instruction sets a program can be compiled to:
+     *      - STACK: the one byte op codes of `Bytecode`, every operand goes through the
+     *          stack.
+     *      - REGISTER: the three-address code of `RegisterBytecode`, the operands are
+     *          read from the registers directly so there are fewer instructions.
+     */
+    enum class MachineBackend
+    {
+        STACK,
+        REGISTER,
+    };
+
+    /**
+     * Machine which runs the parsed programs. A program is compiled once to bytecode and
+     *      can then be run any number of times, every run starts with all the variables
+     *      set to null. Both backends give the same output and variables.
+     *
+     * The instructions are dispatched with computed gotos when the compiler supports
+     *      them (GCC and Clang) and with a switch otherwise, defining
+     *      `NTT_MACHINE_SWITCH_DISPATCH` forces the switch.
+     */
+    class Machine
+    {
+    public:
+        /**
+         * The machine starts with the `print` function, which writes its arguments to the
+         *      output separated by spaces and followed by a new line.
+         */
+        Machine(MachineBackend backend = MachineBackend::STACK);
+        ~Machine();
+
+        inline MachineBackend GetBackend() const { return m_backend; }
+
+        void RegisterFunction(const String &name, NativeFunction function);
+
+        /**
+         * Lowers `program` (see `BytecodeCompiler` and `RegisterCompiler`) and binds
+         *      the functions it calls, the previous program is dropped.
+         *
+         * The register backend specializes the operations using the types resolved from
+         *      the type hints (see `TypeInference`), a program which does not respect its
+         *      hints still runs.
+         */
+        MachineError Compile(Node &program);
+
+        MachineError Run();
+
+        inline b8 IsCompiled() const { return m_bytecode != NTT_NULL || m_registerBytecode != NTT_NULL; }
+
+        /**
+         * Only valid once a program is compiled with the matching backend.
+         */
+        inline const Bytecode &GetBytecode() const { return *m_bytecode; }
+        inline const RegisterBytecode &GetRegisterBytecode() const { return *m_registerBytecode; }
+
+        /**
+         * @return The value of the first variable defined with the name after the last
+         *      run, null if there is none.
+         */
+        Value GetVariable(const String &name) const;
+
+        /**
+         * @return The number of instructions the last run dispatched.
+         */
+        inline u64 GetExecutedInstructionCount() const { return m_executedInstructionCount; }
+
+        /**
+         * Everything the last run wrote, the output is cleared when a run starts.
+         */
+        inline const String &GetOutput() const { return m_output; }
+        inline void Write(const String &text) { m_output += text; }
+
+        /**
+         * @return A string which lives until the next run, used for the strings built
+         *      while running.
+         */
+        const String *CreateString(String &&text);
+
+    private:
+        /**
+         * Fills `m_boundFunctions` with the native function of each name.
+         */
+        MachineError BindFunctions(const Vector<String> &functionNames);
+
+        MachineError RunStack();
+        MachineError RunRegisters();
+
+    private:
+        MachineBackend m_backend;
+        std::unordered_map<String, NativeFunction> m_functions;
+
+        Scope<Bytecode> m_bytecode;
+        Scope<RegisterBytecode> m_registerBytecode;
+
+        /**
+         * The native function of each function index of the bytecode.
+         */
+        Vector<NativeFunction> m_boundFunctions;
+
+        Vector<Value> m_variables;
+        Vector<Value> m_stack;
+
+        /**
+         * The register file of the register backend, the variables are in it.
+         */
+        Vector<Value> m_registers;
+
+        /**
+         * The arguments of the native function calls of the register backend, they are
+         *      copied out of the registers since the result can replace one of them.
+         */
+        Vector<Value> m_callArguments;
+
+        /**
+         * A deque never moves its elements so the values can point to them.
+         */
+        std::deque<String> m_runtimeStrings;
+
+        String m_output;
+        u64 m_executedInstructionCount;
+    };
+} // namespace ntt
@@ -0,0 +1,33 @@
+#pragma once
+#include "pch.h"
+
+namespace ntt
+{
+    /**
+     * Why a program could not be compiled to bytecode or could not finish running.
+     */
+    enum class MachineError
+    {
+        NO_ERROR,
+
+        // compilation
+        INVALID_PROGRAM,
+        UNSUPPORTED_NODE,
+        UNDEFINED_VARIABLE,
+        REDEFINED_VARIABLE,
+        ASSIGN_TO_CONSTANT,
+        UNDEFINED_FUNCTION,
+        TOO_MANY_CONSTANTS,
+        TOO_MANY_VARIABLES,
+        TOO_MANY_ARGUMENTS,
+        TYPE_MISMATCH,
+
+        // execution
+        INVALID_OPERANDS,
+        NOT_COMPILED,
+
+        COUNT,
+    };
+
+    String MachineErrorToString(MachineError error);
+} // namespace ntt
@@ -0,0 +1,169 @@
+#pragma once
+#include "pch.h"
+#include "value.h"
+#include <deque>
+#include <unordered_map>
+
+namespace ntt
+{
+    /**
+     * Three-address instructions of the register machine. The registers hold the
+     *      constants first, then the variables and then the temporaries of the
+     *      expressions, so the operands never need to be loaded:
+     *      - MOVE: a = b.
+     *      - ADD ... GREATER_EQUAL: a = b <op> c.
+     *      - NOT: a = !b.
+     *      - ADD_NUMBERS ... GREATER_EQUAL_NUMBERS: a = b <op> c, the operands are known to
+     *          be numbers (see `TypeInference`) so their types are not checked.
+     *      - JUMP: go to the target.
+     *      - JUMP_IF_FALSE: go to the target when a is not truthy.
+     *      - CALL: a = the function of the call site with its argument registers.
+     */
+    enum class RegisterOpCode : u8
+    {
+        MOVE,
+
+        ADD,
+        SUBTRACT,
+        MULTIPLY,
+        DIVIDE,
+        POWER,
+
+        EQUAL,
+        NOT_EQUAL,
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL,
+        NOT,
+
+        ADD_NUMBERS,
+        SUBTRACT_NUMBERS,
+        MULTIPLY_NUMBERS,
+        DIVIDE_NUMBERS,
+        POWER_NUMBERS,
+        LESS_NUMBERS,
+        LESS_EQUAL_NUMBERS,
+        GREATER_NUMBERS,
+        GREATER_EQUAL_NUMBERS,
+
+        JUMP,
+        JUMP_IF_FALSE,
+        CALL,
+
+        HALT,
+        COUNT,
+    };
+
+    String RegisterOpCodeToString(RegisterOpCode opCode);
+
+    /**
+     * Every instruction has the same size, the jumps and the calls keep their 32 bits
+     *      operand (the target instruction or the call site) in `b` and `c`.
+     */
+    struct RegisterInstruction
+    {
+        RegisterOpCode opCode;
+        u16 a;
+        u16 b;
+        u16 c;
+
+        inline u32 GetWideOperand() const { return u32(b) | (u32(c) << 16); }
+    };
+
+    static_assert(sizeof(RegisterInstruction) == 8, "RegisterInstruction must stay 8 bytes.");
+
+    struct CallSite
+    {
+        u32 function;
+        u32 firstArgument;
+        u32 numberOfArguments;
+    };
+
+    /**
+     * A program compiled for the register machine, see `RegisterCompiler`.
+     */
+    class RegisterBytecode
+    {
+    public:
+        static constexpr u32 NULL_CONSTANT = 0;
+        static constexpr u32 TRUE_CONSTANT = 1;
+        static constexpr u32 FALSE_CONSTANT = 2;
+
+        RegisterBytecode();
+        ~RegisterBytecode();
+
+        inline const Vector<RegisterInstruction> &GetInstructions() const { return m_instructions; }
+        inline u32 GetInstructionCount() const { return u32(m_instructions.size()); }
+        inline void SetInstructions(Vector<RegisterInstruction> &&instructions) { m_instructions = std::move(instructions); }
+
+        /**
+         * The constants are copied to the first registers when a run starts.
+         */
+        inline const Vector<Value> &GetConstants() const { return m_constants; }
+        inline u32 GetConstantCount() const { return u32(m_constants.size()); }
+
+        inline const Vector<String> &GetVariableNames() const { return m_variableNames; }
+        inline u32 GetVariableCount() const { return u32(m_variableNames.size()); }
+
+        /**
+         * @return The register of the variable slot.
+         */
+        inline u32 GetVariableRegister(u32 slot) const { return GetConstantCount() + slot; }
+
+        inline u32 GetTemporaryCount() const { return m_temporaryCount; }
+        inline void SetTemporaryCount(u32 count) { m_temporaryCount = count; }
+
+        inline u32 GetRegisterCount() const
+        {
+            return GetConstantCount() + GetVariableCount() + GetTemporaryCount();
+        }
+
+        inline const Vector<String> &GetFunctionNames() const { return m_functionNames; }
+
+        inline const CallSite &GetCallSite(u32 index) const { return m_callSites[index]; }
+        inline const Vector<u16> &GetArgumentRegisters() const { return m_argumentRegisters; }
+
+        /**
+         * The number constants are shared between the instructions which use the same
+         *      value.
+         */
+        u32 AddNumber(f64 number);
+        u32 AddString(const String &text);
+
+        u32 AddVariable(const String &name);
+        u32 AddFunction(const String &name);
+
+        /**
+         * @return The index of a call site of the function whose argument registers are
+         *      added with `AddArgumentRegister`.
+         */
+        u32 AddCallSite(u32 function, u32 numberOfArguments);
+        inline void AddArgumentRegister(u16 argumentRegister) { m_argumentRegisters.push_back(argumentRegister); }
+
+        /**
+         * One instruction per line with its registers, used to debug the compiler.
+         */
+        String Disassemble() const;
+
+    private:
+        Vector<RegisterInstruction> m_instructions;
+        Vector<Value> m_constants;
+
+        /**
+         * Storage of the string constants, a deque never moves its elements so the
+         *      values can point to them.
+         */
+        std::deque<String> m_strings;
+
+        std::unordered_map<u64, u32> m_numberConstants;
+        std::unordered_map<String, u32> m_stringConstants;
+
+        Vector<String> m_variableNames;
+        u32 m_temporaryCount;
+
+        Vector<String> m_functionNames;
+        Vector<CallSite> m_callSites;
+        Vector<u16> m_argumentRegisters;
+    };
+} // namespace ntt
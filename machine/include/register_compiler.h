@@ -0,0 +1,139 @@
+#pragma once
+#include "pch.h"
+#include "lowering_utils.h"
+#include "machine_error.h"
+#include "register_bytecode.h"
+#include "type_inference.h"
+#include "parser/node.h"
+
+namespace ntt
+{
+    class OperationNode;
+
+    /**
+     * Lowers a parsed program to the three-address code of the register machine.
+     *
+     * The constants and the variables are read from their own registers, so only the
+     *      intermediate results of the expressions need a register: every one of them
+     *      gets a virtual register while compiling, and once the whole program is
+     *      compiled a linear scan over their live ranges packs them into as few
+     *      temporary registers as possible. The last instruction of an assignment
+     *      writes straight into the register of the variable.
+     *
+     * When the types of the program are given, the arithmetic and the comparisons whose
+     *      operands are both numbers use the instructions which do not check them.
+     */
+    class RegisterCompiler : public NodeVisitor
+    {
+    public:
+        RegisterCompiler(RegisterBytecode &bytecode, const TypeInference *types = NTT_NULL);
+        ~RegisterCompiler();
+
+        /**
+         * @return The first error met, the bytecode is empty when there is one. The nodes
+         *      which carry parsing errors are not compiled.
+         */
+        MachineError Compile(Node &program);
+
+    private:
+        void Visit(Atomic &node) override;
+        void Visit(BlockNode &node) override;
+        void Visit(InvalidNode &node) override;
+        void Visit(OperationNode &node) override;
+        void Visit(UnaryOperationNode &node) override;
+        void Visit(IfStatementNode &node) override;
+        void Visit(FunctionCallNode &node) override;
+        void Visit(VariableDefinitionNode &node) override;
+
+        /**
+         * A register before the layout of the register file is known, the kind is kept
+         *      in the two highest bits.
+         */
+        typedef u32 Operand;
+
+        enum OperandKind : u32
+        {
+            CONSTANT = 0u << 30,
+            VARIABLE = 1u << 30,
+            TEMPORARY = 2u << 30,
+            NO_OPERAND = 3u << 30,
+        };
+
+        static constexpr u32 OPERAND_KIND_MASK = 3u << 30;
+
+        /**
+         * The jumps keep their target and the calls their function in `b`, the
+         *      arguments of a call are `m_arguments[firstArgument, firstArgument +
+         *      numberOfArguments)`.
+         */
+        struct PendingInstruction
+        {
+            RegisterOpCode opCode;
+            Operand a;
+            Operand b;
+            Operand c;
+            u32 firstArgument;
+            u32 numberOfArguments;
+        };
+
+        /**
+         * Compiles an expression.
+         *
+         * @param destination The register the value must end in, `NO_OPERAND` to let the
+         *      expression pick one.
+         * @return The register which holds the value.
+         */
+        Operand CompileExpression(Node &node, Operand destination = NO_OPERAND);
+
+        void CompileNode(Node &node);
+        void CompileStatement(Node &node);
+        void CompileBlock(const Vector<Ref<Node>> &children);
+
+        /**
+         * @return `m_destination` or a new temporary when there is none.
+         */
+        Operand TakeDestination();
+
+        /**
+         * Copies `operand` into a new temporary right before the instruction at `position`
+         *      when it is a variable which may be assigned after it was read (an
+         *      assignment nested in an expression), so the instruction which uses it
+         *      still sees the value from the time it was read.
+         */
+        Operand ProtectOperand(Operand operand, u32 position, u32 numberOfAssignments);
+
+        void Emit(RegisterOpCode opCode, Operand a, Operand b = NO_OPERAND, Operand c = NO_OPERAND);
+        void PatchJump(u32 jumpIndex);
+
+        /**
+         * Linear scan over the live ranges of the temporaries.
+         *
+         * @return The physical temporary of each virtual one.
+         */
+        Vector<u32> AssignTemporaries(u32 &outNumberOfTemporaries) const;
+
+        void Encode(const Vector<u32> &temporaries);
+
+        void SetError(MachineError error);
+
+    private:
+        RegisterBytecode &m_bytecode;
+        const TypeInference *m_types;
+        MachineError m_error;
+
+        Vector<PendingInstruction> m_instructions;
+        Vector<Operand> m_arguments;
+        u32 m_numberOfTemporaries;
+
+        /**
+         * Number of assignments compiled so far, used to find out whether an operand may
+         *      have been written before its use.
+         */
+        u32 m_numberOfAssignments;
+
+        Operand m_destination;
+        Operand m_result;
+
+        VariableScopes m_scopes;
+    };
+} // namespace ntt
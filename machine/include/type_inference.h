@@ -0,0 +1,100 @@
+#pragma once
+#include "pch.h"
+#include "lowering_utils.h"
+#include "machine_error.h"
+#include "parser/node.h"
+#include <unordered_map>
+
+namespace ntt
+{
+    /**
+     * The type an expression is known to have before the program runs, ANY when it can
+     *      hold values of different types.
+     */
+    enum class StaticType : u8
+    {
+        ANY,
+        NUMBER,
+        STRING,
+        BOOLEAN,
+        COUNT,
+    };
+
+    String StaticTypeToString(StaticType type);
+
+    /**
+     * Resolves the type of the expressions of a parsed program from the type hints of its
+     *      variable definitions (`number`, `string`, `boolean` and `any`).
+     *
+     * A variable keeps its hint only when every value assigned to it (its default value
+     *      included) has that type, otherwise it is ANY. Since a variable becoming ANY can
+     *      make the values assigned to other variables ANY, the program is walked again
+     *      until no variable changes. The resolved types are sound: an expression whose
+     *      type is not ANY always holds a value of that type when it is evaluated, so a
+     *      backend can skip the tag checks of its operands.
+     *
+     * The operations only give their result type when they succeed (`x - y` is always a
+     *      number, `n + x` is a number when `n` is one), the machine stops on the others.
+     */
+    class TypeInference : public NodeVisitor
+    {
+    public:
+        TypeInference();
+        ~TypeInference();
+
+        /**
+         * @return TYPE_MISMATCH when a value does not match the hint of its variable or an
+         *      operand can never be accepted by its operation. The types are resolved
+         *      either way, the variables with a mismatch are ANY.
+         */
+        MachineError Infer(Node &program);
+
+        /**
+         * @return The type of the expression, ANY for the nodes which are not
+         *      expressions.
+         */
+        StaticType GetType(const Node &node) const;
+
+    private:
+        void Visit(Atomic &node) override;
+        void Visit(BlockNode &node) override;
+        void Visit(InvalidNode &node) override;
+        void Visit(OperationNode &node) override;
+        void Visit(UnaryOperationNode &node) override;
+        void Visit(IfStatementNode &node) override;
+        void Visit(FunctionCallNode &node) override;
+        void Visit(VariableDefinitionNode &node) override;
+
+        /**
+         * @return The type of the node, which is also recorded.
+         */
+        StaticType InferNode(Node &node);
+
+        /**
+         * Checks that `valueType` matches the type of the variable, the variable becomes
+         *      ANY when it does not.
+         */
+        void Assign(u32 slot, StaticType valueType);
+
+        /**
+         * Reports an operand whose type is known and is not `expectedType`.
+         */
+        void CheckOperand(StaticType operandType, StaticType expectedType);
+
+        void SetError(MachineError error);
+
+    private:
+        std::unordered_map<const Node *, StaticType> m_types;
+
+        /**
+         * The type of each variable definition, in the order they are walked.
+         */
+        Vector<StaticType> m_variableTypes;
+        u32 m_numberOfVisitedVariables;
+        b8 m_hasVariableChanged;
+
+        VariableScopes m_scopes;
+        StaticType m_result;
+        MachineError m_error;
+    };
+} // namespace ntt
@@ -0,0 +1,140 @@
+#pragma once
+#include "pch.h"
+#include <cstring>
+
+namespace ntt
+{
+    enum class ValueType : u8
+    {
+        NULL_VALUE,
+        NUMBER,
+        BOOLEAN,
+        STRING,
+    };
+
+    String ValueTypeToString(ValueType type);
+
+    /**
+     * Runtime value of the machine. All the numbers of the language are `f64`, the
+     *      strings are owned by the bytecode (the literals) or by the machine (the ones
+     *      built while running), a value only points to them.
+     *
+     * The value is NaN-boxed in 64 bits: the numbers are stored as their own bits, the
+     *      other values are quiet NaNs with the `BOX_MASK` bits set, which no number has
+     *      (the NaN numbers are all stored as the canonical NaN):
+     *      - null: `BOX_MASK | 1`.
+     *      - false / true: `BOX_MASK | 2` / `BOX_MASK | 3`.
+     *      - string: `SIGN_BIT | BOX_MASK | pointer`, the pointer fits in the 48 low bits.
+     */
+    class Value
+    {
+    public:
+        Value() : m_bits(NULL_BITS) {}
+
+        static inline Value FromNumber(f64 number)
+        {
+            Value value;
+            if (number != number)
+            {
+                value.m_bits = CANONICAL_NAN_BITS;
+            }
+            else
+            {
+                std::memcpy(&value.m_bits, &number, sizeof(number));
+            }
+            return value;
+        }
+
+        /**
+         * Same as `FromNumber` without the NaN check, for the result of an arithmetic
+         *      operation on numbers: the processors either produce their default NaN or
+         *      quiet the NaN of an operand, neither has the `BOX_MASK` bits set.
+         */
+        static inline Value FromOperationResult(f64 number)
+        {
+            Value value;
+            std::memcpy(&value.m_bits, &number, sizeof(number));
+            return value;
+        }
+
+        static inline Value FromBoolean(b8 boolean)
+        {
+            Value value;
+            value.m_bits = boolean ? TRUE_BITS : FALSE_BITS;
+            return value;
+        }
+
+        static inline Value FromString(const String *string)
+        {
+            NTT_ASSERT((u64(reinterpret_cast<uintptr_t>(string)) & ~POINTER_MASK) == 0);
+
+            Value value;
+            value.m_bits = STRING_TAG | u64(reinterpret_cast<uintptr_t>(string));
+            return value;
+        }
+
+        inline ValueType GetType() const
+        {
+            if (IsNumber())
+            {
+                return ValueType::NUMBER;
+            }
+
+            if (IsString())
+            {
+                return ValueType::STRING;
+            }
+
+            return m_bits == NULL_BITS ? ValueType::NULL_VALUE : ValueType::BOOLEAN;
+        }
+
+        inline b8 IsNull() const { return m_bits == NULL_BITS; }
+        inline b8 IsNumber() const { return (m_bits & BOX_MASK) != BOX_MASK; }
+        inline b8 IsBoolean() const { return (m_bits | 1) == TRUE_BITS; }
+        inline b8 IsString() const { return (m_bits & STRING_TAG) == STRING_TAG; }
+
+        inline f64 GetNumber() const
+        {
+            f64 number;
+            std::memcpy(&number, &m_bits, sizeof(number));
+            return number;
+        }
+
+        inline b8 GetBoolean() const { return m_bits == TRUE_BITS; }
+
+        inline const String &GetString() const
+        {
+            return *reinterpret_cast<const String *>(uintptr_t(m_bits & POINTER_MASK));
+        }
+
+        /**
+         * @return False for null, false, 0 and the empty string, true otherwise.
+         */
+        b8 IsTruthy() const;
+
+        /**
+         * @return Whether both values have the same type and the same content.
+         */
+        b8 Equals(const Value &other) const;
+
+        /**
+         * The integral numbers are written without fraction, `print` writes the values
+         *      this way.
+         */
+        String ToString() const;
+
+    private:
+        static constexpr u64 SIGN_BIT = 0x8000000000000000;
+        static constexpr u64 BOX_MASK = 0x7FFC000000000000;
+        static constexpr u64 POINTER_MASK = 0x0000FFFFFFFFFFFF;
+        static constexpr u64 STRING_TAG = SIGN_BIT | BOX_MASK;
+        static constexpr u64 CANONICAL_NAN_BITS = 0x7FF8000000000000;
+        static constexpr u64 NULL_BITS = BOX_MASK | 1;
+        static constexpr u64 FALSE_BITS = BOX_MASK | 2;
+        static constexpr u64 TRUE_BITS = BOX_MASK | 3;
+
+        u64 m_bits;
+    };
+
+    static_assert(sizeof(Value) == 8, "Value must stay 8 bytes.");
+} // namespace ntt
@@ -0,0 +1,158 @@
+#include "bench_common.h"
+#include "compiler.h"
+#include "constant_folder.h"
+#include "machine.h"
+
+using namespace ntt;
+
+/**
+ * Straight-line arithmetic with a branch per group, the shape of the programs the graph
+ *      editor generates.
+ *
+ * @param typeHint The type hint of the variables, `any` turns the typed instructions off.
+ */
+static String CreateArithmeticProgram(const String &typeHint = "number")
+{
+    String content = "let a : " + typeHint + " = 1; let b : " + typeHint + " = 2; let c : " + typeHint + " = 3;\n";
+    for (u32 groupIndex = 0; groupIndex < 2000; groupIndex++)
+    {
+        content += "a = (a + b * c) / (c + 1.5);\n";
+        content += "b = a * 2 - (b + c) / 4;\n";
+        content += "if (a > b) { c = c + 1; } else { c = c - 1; }\n";
+    }
+    return content;
+}
+
+static void CompileArithmeticProgramWith(BenchmarkState &state, MachineBackend backend)
+{
+    BlockNode program(NodeType::PROGRAM, CreateArithmeticProgram());
+    program.Compress();
+    program.Parse();
+
+    Machine machine(backend);
+    while (state.KeepRunning())
+    {
+        machine.Compile(program);
+    }
+
+    state.SetItemsPerIteration(backend == MachineBackend::REGISTER
+                                   ? machine.GetRegisterBytecode().GetInstructionCount()
+                                   : machine.GetBytecode().GetInstructionCount(),
+                               "instructions");
+}
+
+/**
+ * The items are the dispatched instructions, so the time per iteration of the two
+ *      backends compares the whole runs and the items the number of dispatches.
+ */
+static void RunArithmeticProgramWith(BenchmarkState &state, MachineBackend backend,
+                                     const String &typeHint = "number")
+{
+    BlockNode program(NodeType::PROGRAM, CreateArithmeticProgram(typeHint));
+    program.Compress();
+    program.Parse();
+
+    Machine machine(backend);
+    machine.Compile(program);
+
+    while (state.KeepRunning())
+    {
+        machine.Run();
+    }
+
+    state.SetItemsPerIteration(machine.GetExecutedInstructionCount(), "instructions");
+}
+
+NTT_BENCHMARK(CompileArithmeticProgram)
+{
+    CompileArithmeticProgramWith(state, MachineBackend::STACK);
+}
+
+NTT_BENCHMARK(CompileArithmeticProgramToRegisters)
+{
+    CompileArithmeticProgramWith(state, MachineBackend::REGISTER);
+}
+
+NTT_BENCHMARK(RunArithmeticProgram)
+{
+    RunArithmeticProgramWith(state, MachineBackend::STACK);
+}
+
+NTT_BENCHMARK(RunArithmeticProgramOnRegisters)
+{
+    RunArithmeticProgramWith(state, MachineBackend::REGISTER);
+}
+
+NTT_BENCHMARK(RunUntypedArithmeticProgramOnRegisters)
+{
+    RunArithmeticProgramWith(state, MachineBackend::REGISTER, "any");
+}
+
+/**
+ * The arithmetic program with the literal subexpressions the graph editor leaves in the
+ *      nodes it fills with their default inputs.
+ */
+static String CreateLiteralProgram()
+{
+    String content = "let a : number = 1; let b : number = 2; let c : number = 3;\n";
+    for (u32 groupIndex = 0; groupIndex < 2000; groupIndex++)
+    {
+        content += "a = (a + b * (2 * 3)) * 1 / (c + 1.5 - 0);\n";
+        content += "b = a * (4 / 2) - (b + c) / (2 ^ 2) + 0;\n";
+        content += "if (!!(a > b)) { c = c + 1; } else { c = c - (3 - 2); }\n";
+    }
+    return content;
+}
+
+NTT_BENCHMARK(FoldLiteralProgram)
+{
+    String content = CreateLiteralProgram();
+    u32 numberOfEliminatedNodes = 0;
+
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        BlockNode program(NodeType::PROGRAM, content);
+        program.Compress();
+        program.Parse();
+        state.ResumeTiming();
+
+        ConstantFolder folder;
+        numberOfEliminatedNodes = folder.Fold(program);
+    }
+
+    state.SetItemsPerIteration(numberOfEliminatedNodes, "eliminated nodes");
+}
+
+static void RunLiteralProgramWith(BenchmarkState &state, b8 isFolded)
+{
+    BlockNode program(NodeType::PROGRAM, CreateLiteralProgram());
+    program.Compress();
+    program.Parse();
+
+    if (isFolded)
+    {
+        ConstantFolder folder;
+        folder.Fold(program);
+    }
+
+    Machine machine;
+    machine.Compile(program);
+
+    while (state.KeepRunning())
+    {
+        machine.Run();
+    }
+
+    state.SetItemsPerIteration(machine.GetExecutedInstructionCount(), "instructions");
+}
+
+NTT_BENCHMARK(RunLiteralProgram)
+{
+    RunLiteralProgramWith(state, NTT_FALSE);
+}
+
+NTT_BENCHMARK(RunFoldedLiteralProgram)
+{
+    RunLiteralProgramWith(state, NTT_TRUE);
+}
@@ -0,0 +1,210 @@
+#include "test_common.h"
+#include "compiler.h"
+#include "constant_folder.h"
+#include "lowering_utils.h"
+#include "machine.h"
+#include "parser/operationNode.h"
+#include "parser/unaryOperationNode.h"
+#include "parser/variable_definition_node.h"
+
+using namespace ntt;
+
+static Ref<BlockNode> Parse(const String &content)
+{
+    Ref<BlockNode> program = CreateRef<BlockNode>(NodeType::PROGRAM, content);
+    program->Compress();
+    program->Parse();
+    return program;
+}
+
+/**
+ * @return The default value of the variable defined by the statement at `statementIndex`.
+ */
+static Ref<Node> GetDefaultValue(BlockNode &program, u32 statementIndex)
+{
+    BlockNode *statement = NodeCast<BlockNode>(program.GetChildren()[statementIndex].get());
+    return NodeCast<VariableDefinitionNode>(statement->GetChildren()[0])->GetDefaultValue();
+}
+
+static void ExpectLiteral(const Ref<Node> &node, TokenType type, const String &text)
+{
+    Atomic *atomic = NodeCast<Atomic>(node.get());
+    ASSERT_NE(atomic, NTT_NULL);
+    EXPECT_EQ(atomic->GetToken().GetType(), type);
+    EXPECT_EQ(atomic->ToJSON()["token"]["value"].dump(), text);
+}
+
+TEST(ConstantFolderTest, FoldsTheLiteralOperations)
+{
+    Ref<BlockNode> program = Parse("let x : number = 2;"
+                                   "let y : number = (2 * 3) + x * 1;"
+                                   "let z : number = 1 + 2 * 3 - 10 / 4;");
+
+    TypeInference types;
+    types.Infer(*program);
+
+    ConstantFolder folder(&types);
+    // `2 * 3`: 3 nodes, its parentheses: 1, `x * 1`: 3, `z`: 4 operations of 3 nodes.
+    EXPECT_EQ(folder.Fold(*program), 19u);
+    EXPECT_EQ(folder.GetEliminatedNodeCount(), 19u);
+
+    OperationNode *y = NodeCast<OperationNode>(GetDefaultValue(*program, 1).get());
+    ASSERT_NE(y, NTT_NULL);
+    ExpectLiteral(y->GetLeftOperand(), TokenType::INTEGER, "6");
+    EXPECT_EQ(NodeCast<Atomic>(y->GetRightOperand().get())->GetToken().GetType(), TokenType::IDENTIFIER);
+    ExpectLiteral(GetDefaultValue(*program, 2), TokenType::FLOAT, "4.5");
+
+    // a second pass has nothing left to fold.
+    EXPECT_EQ(folder.Fold(*program), 0u);
+}
+
+TEST(ConstantFolderTest, FoldsLikeTheMachine)
+{
+    Ref<BlockNode> program = Parse("let a : string = \"a\\\"\" + \"b\";"
+                                   "let b : boolean = 1 < 2;"
+                                   "let c : boolean = !\"\";"
+                                   "let d : boolean = (2 ^ 3) == 8;"
+                                   "let e : boolean = \"1\" == 1;"
+                                   "let f : number = \"a\" - 1;"
+                                   "let g : number = 1 / 0;");
+
+    ConstantFolder folder;
+    folder.Fold(*program);
+
+    ExpectLiteral(GetDefaultValue(*program, 0), TokenType::STRING, "\"\\\"a\\\\\\\"b\\\"\"");
+    ExpectLiteral(GetDefaultValue(*program, 1), TokenType::BOOLEAN, "true");
+    ExpectLiteral(GetDefaultValue(*program, 2), TokenType::BOOLEAN, "true");
+    ExpectLiteral(GetDefaultValue(*program, 3), TokenType::BOOLEAN, "true");
+    ExpectLiteral(GetDefaultValue(*program, 4), TokenType::BOOLEAN, "false");
+
+    // the machine stops on the first one and the second one has no literal.
+    EXPECT_EQ(GetDefaultValue(*program, 5)->GetType(), NodeType::OPERATION);
+    EXPECT_EQ(GetDefaultValue(*program, 6)->GetType(), NodeType::OPERATION);
+}
+
+TEST(ConstantFolderTest, DoubleNotIsOnlyRemovedFromBooleans)
+{
+    Ref<BlockNode> program = Parse("let x : number = 2;"
+                                   "let a : boolean = !!(x > 1);"
+                                   "let b : boolean = !!x;"
+                                   "let c : boolean = !!!x;");
+
+    ConstantFolder folder;
+    folder.Fold(*program);
+
+    EXPECT_EQ(GetDefaultValue(*program, 1)->GetType(), NodeType::OPERATION);
+
+    UnaryOperationNode *b = NodeCast<UnaryOperationNode>(GetDefaultValue(*program, 2).get());
+    ASSERT_NE(b, NTT_NULL);
+    EXPECT_EQ(b->GetOperand()->GetType(), NodeType::UNARY_OPERATION);
+
+    UnaryOperationNode *c = NodeCast<UnaryOperationNode>(GetDefaultValue(*program, 3).get());
+    ASSERT_NE(c, NTT_NULL);
+    EXPECT_EQ(c->GetOperand()->GetType(), NodeType::ATOMIC);
+}
+
+TEST(ConstantFolderTest, IfStatementsKeepTheTakenBlock)
+{
+    Ref<BlockNode> program = Parse("if (1 < 2) { print(1); } else { print(2); }"
+                                   "if (false) { print(3); }"
+                                   "if (\"\") { print(4); } else { print(5); }");
+
+    ConstantFolder folder;
+    EXPECT_GT(folder.Fold(*program), 0u);
+
+    const Vector<Ref<Node>> &children = program->GetChildren();
+    ASSERT_EQ(children.size(), 2u);
+    EXPECT_EQ(children[0]->GetType(), NodeType::BLOCK);
+    EXPECT_EQ(children[1]->GetType(), NodeType::BLOCK);
+
+    Machine machine;
+    ASSERT_EQ(machine.Compile(*program), MachineError::NO_ERROR);
+    ASSERT_EQ(machine.Run(), MachineError::NO_ERROR);
+    EXPECT_EQ(machine.GetOutput(), "1\n5\n");
+
+    // the dropped blocks are not compiled anymore.
+    program = Parse("if (0) { print(zz); } print(1);");
+    ASSERT_EQ(machine.Compile(*program), MachineError::UNDEFINED_VARIABLE);
+    folder.Fold(*program);
+    EXPECT_EQ(machine.Compile(*program), MachineError::NO_ERROR);
+}
+
+TEST(ConstantFolderTest, FoldedProgramsRunTheSame)
+{
+    String content = "let x : number = 3;"
+                     "let s : string = \"a\" + \"\\\\\" + \"b\";"
+                     "let y : number = (2 * 3) + x * 1 - (0 + x) / 1;"
+                     "if (!(1 > 2) == true) { let x : string = s + \"c\"; print(x, y); }"
+                     "if ((y - 0) > 10) { print(\"big\"); } else { print(\"small\", !!(y < x)); }";
+
+    Machine machine;
+    Ref<BlockNode> program = Parse(content);
+    ASSERT_EQ(machine.Compile(*program), MachineError::NO_ERROR);
+    ASSERT_EQ(machine.Run(), MachineError::NO_ERROR);
+    String output = machine.GetOutput();
+    u64 numberOfInstructions = machine.GetExecutedInstructionCount();
+
+    ConstantFolder folder;
+    EXPECT_GT(folder.Fold(*program), 0u);
+    ASSERT_EQ(machine.Compile(*program), MachineError::NO_ERROR);
+    ASSERT_EQ(machine.Run(), MachineError::NO_ERROR);
+    EXPECT_EQ(machine.GetOutput(), output);
+    EXPECT_LT(machine.GetExecutedInstructionCount(), numberOfInstructions);
+}
+
+TEST(ConstantFolderTest, IdentitiesKeepTheOperandChecks)
+{
+    Ref<BlockNode> program = Parse("let s : string = \"s\";"
+                                   "let x : any = 2;"
+                                   "let a : any = s * 1;"
+                                   "let b : any = s - 0;"
+                                   "let c : any = x * 1;"
+                                   "let d : any = (x - 1) * 1;"
+                                   "let e : any = 1 * (x + 2);");
+
+    TypeInference types;
+    types.Infer(*program);
+
+    ConstantFolder folder(&types);
+    folder.Fold(*program);
+
+    // neither `s` nor `x` are known to be numbers, the machine must still stop on `s`.
+    EXPECT_EQ(GetDefaultValue(*program, 2)->GetType(), NodeType::OPERATION);
+    EXPECT_EQ(GetDefaultValue(*program, 3)->GetType(), NodeType::OPERATION);
+    EXPECT_EQ(GetDefaultValue(*program, 4)->GetType(), NodeType::OPERATION);
+
+    OperationNode *d = NodeCast<OperationNode>(GetDefaultValue(*program, 5).get());
+    ASSERT_NE(d, NTT_NULL);
+    EXPECT_EQ(GetAtomicSymbol(d->GetOperator()), Symbol::MINUS);
+
+    OperationNode *e = NodeCast<OperationNode>(GetDefaultValue(*program, 6).get());
+    ASSERT_NE(e, NTT_NULL);
+    EXPECT_EQ(GetAtomicSymbol(e->GetOperator()), Symbol::PLUS);
+
+    Ref<BlockNode> errorProgram = Parse("let s : string = \"s\"; print(s * 1, s - 0);");
+    ConstantFolder().Fold(*errorProgram);
+
+    Machine machine;
+    ASSERT_EQ(machine.Compile(*errorProgram), MachineError::NO_ERROR);
+    EXPECT_EQ(machine.Run(), MachineError::INVALID_OPERANDS);
+}
+
+TEST(ConstantFolderTest, NegativeZeroIsKept)
+{
+    String content = "let v1 : number = 0 * (0 - 1);"
+                     "print(1 / (v1 + 0), 1 / (0 + v1), 1 / (v1 - 0), 1 / (v1 + 0 * (0 - 1)));";
+
+    Machine machine;
+    Ref<BlockNode> program = Parse(content);
+    ASSERT_EQ(machine.Compile(*program), MachineError::NO_ERROR);
+    ASSERT_EQ(machine.Run(), MachineError::NO_ERROR);
+    EXPECT_EQ(machine.GetOutput(), "inf inf -inf -inf\n");
+
+    TypeInference types;
+    types.Infer(*program);
+    ConstantFolder folder(&types);
+    EXPECT_GT(folder.Fold(*program), 0u);
+    ASSERT_EQ(machine.Compile(*program), MachineError::NO_ERROR);
+    ASSERT_EQ(machine.Run(), MachineError::NO_ERROR);
+    EXPECT_EQ(machine.GetOutput(), "inf inf -inf -inf\n");
+}
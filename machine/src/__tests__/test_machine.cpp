@@ -0,0 +1,98 @@
+#include "test_common.h"
+#include "compiler.h"
+#include "machine.h"
+
+using namespace ntt;
+
+static MachineError CompileAndRun(Machine &machine, const String &content)
+{
+    BlockNode program(NodeType::PROGRAM, content);
+    program.Compress();
+    program.Parse();
+
+    MachineError error = machine.Compile(program);
+    return error != MachineError::NO_ERROR ? error : machine.Run();
+}
+
+TEST(MachineTest, ArithmeticFollowsTheOperationTree)
+{
+    Machine machine;
+    ASSERT_EQ(CompileAndRun(machine, "let a : number = 1 + 2 * 3;"
+                                     "let b : number = (a - 1) / 2 ^ 2;"
+                                     "let c : number;"
+                                     "c = b * 4 - 0.5;"),
+              MachineError::NO_ERROR);
+
+    EXPECT_EQ(machine.GetVariable("a").GetNumber(), 7.0);
+    EXPECT_EQ(machine.GetVariable("b").GetNumber(), 1.5);
+    EXPECT_EQ(machine.GetVariable("c").GetNumber(), 5.5);
+}
+
+TEST(MachineTest, IfStatementsRunOneBranch)
+{
+    Machine machine;
+    ASSERT_EQ(CompileAndRun(machine, "let x : number = 5;"
+                                     "let size : string = \"none\";"
+                                     "if (x > 3) { size = \"big\"; } else { size = \"small\"; }"
+                                     "if (x == 1) { x = 0; }"
+                                     "if (!(x < 3)) { print(size, x, true, \"a\" + \"b\"); }"),
+              MachineError::NO_ERROR);
+
+    EXPECT_EQ(machine.GetOutput(), "big 5 true ab\n");
+    EXPECT_EQ(machine.GetVariable("size").GetString(), "big");
+}
+
+TEST(MachineTest, BlocksHideTheOuterVariables)
+{
+    Machine machine;
+    ASSERT_EQ(CompileAndRun(machine, "let x : number = 1;"
+                                     "if (true) { let x : string = \"inner\"; print(x); x = \"changed\"; }"
+                                     "let y;"
+                                     "print(x, y);"),
+              MachineError::NO_ERROR);
+
+    EXPECT_EQ(machine.GetOutput(), "inner\n1 null\n");
+
+    // every run starts again from the same state.
+    ASSERT_EQ(machine.Run(), MachineError::NO_ERROR);
+    EXPECT_EQ(machine.GetOutput(), "inner\n1 null\n");
+    EXPECT_GT(machine.GetExecutedInstructionCount(), machine.GetBytecode().GetInstructionCount() / 2);
+}
+
+TEST(MachineTest, ErrorsStopTheProgram)
+{
+    Machine machine;
+    EXPECT_EQ(CompileAndRun(machine, "a = 1;"), MachineError::UNDEFINED_VARIABLE);
+    EXPECT_EQ(CompileAndRun(machine, "const a : number = 1; a = 2;"), MachineError::ASSIGN_TO_CONSTANT);
+    EXPECT_EQ(CompileAndRun(machine, "let a : number; let a : string;"), MachineError::REDEFINED_VARIABLE);
+    EXPECT_EQ(CompileAndRun(machine, "draw(1);"), MachineError::UNDEFINED_FUNCTION);
+    EXPECT_EQ(CompileAndRun(machine, "let a : number = 1"), MachineError::INVALID_PROGRAM);
+    EXPECT_FALSE(machine.IsCompiled());
+    EXPECT_EQ(machine.Run(), MachineError::NOT_COMPILED);
+
+    EXPECT_EQ(CompileAndRun(machine, "let a : number = 1; print(a); a = a - \"text\"; print(a);"),
+              MachineError::INVALID_OPERANDS);
+    EXPECT_EQ(machine.GetOutput(), "1\n");
+}
+
+static Value Sum(Machine &machine, const Value *arguments, u32 numberOfArguments)
+{
+    NTT_UNUSED(machine);
+
+    f64 sum = 0.0;
+    for (u32 argumentIndex = 0; argumentIndex < numberOfArguments; argumentIndex++)
+    {
+        sum += arguments[argumentIndex].GetNumber();
+    }
+    return Value::FromNumber(sum);
+}
+
+TEST(MachineTest, ProgramsCallTheRegisteredFunctions)
+{
+    Machine machine;
+    machine.RegisterFunction("sum", Sum);
+
+    ASSERT_EQ(CompileAndRun(machine, "let total : number = 3; print(sum(1, 2, total + 3), sum());"),
+              MachineError::NO_ERROR);
+    EXPECT_EQ(machine.GetOutput(), "9 0\n");
+}
@@ -0,0 +1,127 @@
+#include "test_common.h"
+#include "compiler.h"
+#include "machine.h"
+
+using namespace ntt;
+
+static MachineError CompileAndRun(Machine &machine, const String &content)
+{
+    BlockNode program(NodeType::PROGRAM, content);
+    program.Compress();
+    program.Parse();
+
+    MachineError error = machine.Compile(program);
+    return error != MachineError::NO_ERROR ? error : machine.Run();
+}
+
+/**
+ * Runs the program on both backends, they must end with the same output and variables.
+ */
+static void ExpectSameRun(const String &content, const Vector<String> &variableNames)
+{
+    Machine stackMachine(MachineBackend::STACK);
+    Machine registerMachine(MachineBackend::REGISTER);
+
+    MachineError stackError = CompileAndRun(stackMachine, content);
+    ASSERT_EQ(CompileAndRun(registerMachine, content), stackError) << content;
+    EXPECT_EQ(registerMachine.GetOutput(), stackMachine.GetOutput()) << content;
+
+    for (const String &variableName : variableNames)
+    {
+        EXPECT_TRUE(registerMachine.GetVariable(variableName).Equals(stackMachine.GetVariable(variableName)))
+            << content << " " << variableName << ": " << registerMachine.GetVariable(variableName).ToString()
+            << " != " << stackMachine.GetVariable(variableName).ToString();
+    }
+}
+
+TEST(RegisterMachineTest, RunsLikeTheStackMachine)
+{
+    ExpectSameRun("let a : number = 1 + 2 * 3;"
+                  "let b : number = (a - 1) / 2 ^ 2;"
+                  "let c : number;"
+                  "c = b * 4 - 0.5;",
+                  {"a", "b", "c"});
+
+    ExpectSameRun("let x : number = 5;"
+                  "let size : string = \"none\";"
+                  "if (x > 3) { size = \"big\"; } else { size = \"small\"; }"
+                  "if (x == 1) { x = 0; }"
+                  "if (!(x < 3)) { print(size, x, true, \"a\" + \"b\"); }",
+                  {"x", "size"});
+
+    ExpectSameRun("let x : number = 1;"
+                  "if (true) { let x : string = \"inner\"; print(x); x = \"changed\"; }"
+                  "let y;"
+                  "print(x, y, !y, x != 2, null == y);",
+                  {"x", "y"});
+
+    ExpectSameRun("let a : number = 1; let b : number = a; b = (a = 4); print(a, b);", {"a", "b"});
+    ExpectSameRun("let a : number = 1; print(a); a = a - \"text\"; print(a);", {"a"});
+}
+
+TEST(RegisterMachineTest, NestedAssignmentsKeepTheReadValues)
+{
+    // the left operand is read before the assignment on the right writes it.
+    ExpectSameRun("let a : number = 1; let b : number = a + (a = 5); print(a, b);", {"a", "b"});
+    ExpectSameRun("let a : number = 2; let b : number = a * (a = a + 1) - a; print(a, b);", {"a", "b"});
+    ExpectSameRun("let a : number = 1; print(a, a = 3, a);", {"a"});
+    ExpectSameRun("let a : number = 1; print(a + 0, (a = 3) + 1, a);", {"a"});
+    ExpectSameRun("let a : number = 1; let a2 : number = 0; if (true) { let a : number = a + 1; a2 = a; } print(a, a2);",
+                  {"a", "a2"});
+}
+
+TEST(RegisterMachineTest, DispatchesFewerInstructions)
+{
+    String content = "let a : number = 1; let b : number = 2; let c : number = 3;";
+    for (u32 groupIndex = 0; groupIndex < 20; groupIndex++)
+    {
+        content += "a = (a + b * c) / (c + 1.5);"
+                   "b = a * 2 - (b + c) / 4;"
+                   "if (a > b) { c = c + 1; } else { c = c - 1; }";
+    }
+
+    ExpectSameRun(content, {"a", "b", "c"});
+
+    Machine stackMachine(MachineBackend::STACK);
+    Machine registerMachine(MachineBackend::REGISTER);
+    ASSERT_EQ(CompileAndRun(stackMachine, content), MachineError::NO_ERROR);
+    ASSERT_EQ(CompileAndRun(registerMachine, content), MachineError::NO_ERROR);
+
+    EXPECT_LT(registerMachine.GetExecutedInstructionCount() * 2, stackMachine.GetExecutedInstructionCount());
+}
+
+TEST(RegisterMachineTest, TemporariesAreReused)
+{
+    // every operation needs a temporary but at most two of them are alive at once.
+    Machine machine(MachineBackend::REGISTER);
+    ASSERT_EQ(CompileAndRun(machine, "let a : number = 1;"
+                                     "let b : number = (a + 1) * (a + 2) + (a + 3) * (a + 4) + (a + 5) * (a + 6);"),
+              MachineError::NO_ERROR);
+
+    EXPECT_EQ(machine.GetVariable("b").GetNumber(), 6.0 + 20.0 + 42.0);
+    EXPECT_LE(machine.GetRegisterBytecode().GetTemporaryCount(), 3u);
+}
+
+static Value Sum(Machine &machine, const Value *arguments, u32 numberOfArguments)
+{
+    NTT_UNUSED(machine);
+
+    f64 sum = 0.0;
+    for (u32 argumentIndex = 0; argumentIndex < numberOfArguments; argumentIndex++)
+    {
+        sum += arguments[argumentIndex].GetNumber();
+    }
+    return Value::FromNumber(sum);
+}
+
+TEST(RegisterMachineTest, ProgramsCallTheRegisteredFunctions)
+{
+    Machine machine(MachineBackend::REGISTER);
+    machine.RegisterFunction("sum", Sum);
+
+    ASSERT_EQ(CompileAndRun(machine, "let total : number = 3; print(sum(1, 2, total + 3), sum(sum(total), total));"),
+              MachineError::NO_ERROR);
+    EXPECT_EQ(machine.GetOutput(), "9 6\n");
+    EXPECT_EQ(CompileAndRun(machine, "draw(1);"), MachineError::UNDEFINED_FUNCTION);
+    EXPECT_FALSE(machine.IsCompiled());
+}
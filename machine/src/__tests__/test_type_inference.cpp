@@ -0,0 +1,127 @@
+#include "test_common.h"
+#include "compiler.h"
+#include "machine.h"
+#include "type_inference.h"
+#include "parser/operationNode.h"
+#include "parser/variable_definition_node.h"
+
+using namespace ntt;
+
+static Ref<BlockNode> Parse(const String &content)
+{
+    Ref<BlockNode> program = CreateRef<BlockNode>(NodeType::PROGRAM, content);
+    program->Compress();
+    program->Parse();
+    return program;
+}
+
+static VariableDefinitionNode &GetDefinition(BlockNode &program, u32 statementIndex)
+{
+    BlockNode *statement = NodeCast<BlockNode>(program.GetChildren()[statementIndex].get());
+    return *NodeCast<VariableDefinitionNode>(statement->GetChildren()[0].get());
+}
+
+/**
+ * @return The resolved type of the variable defined by the statement at `statementIndex`.
+ */
+static StaticType GetVariableType(const TypeInference &types, BlockNode &program, u32 statementIndex)
+{
+    return types.GetType(GetDefinition(program, statementIndex));
+}
+
+TEST(TypeInferenceTest, PropagatesTheTypeHints)
+{
+    Ref<BlockNode> program = Parse("let n : number;"
+                                   "let s : string = \"a\";"
+                                   "let b : boolean = n < 2;"
+                                   "let x : any = n * 2 + 1;"
+                                   "let y : any = s + x;"
+                                   "let z : any = n;");
+
+    TypeInference types;
+    EXPECT_EQ(types.Infer(*program), MachineError::NO_ERROR);
+
+    EXPECT_EQ(GetVariableType(types, *program, 0), StaticType::NUMBER);
+    EXPECT_EQ(GetVariableType(types, *program, 1), StaticType::STRING);
+    EXPECT_EQ(GetVariableType(types, *program, 2), StaticType::BOOLEAN);
+    EXPECT_EQ(GetVariableType(types, *program, 5), StaticType::ANY);
+
+    // the `any` variables stay ANY but their values are still resolved, `s + x` can
+    //      only succeed with two strings.
+    EXPECT_EQ(GetVariableType(types, *program, 3), StaticType::ANY);
+    EXPECT_EQ(types.GetType(*GetDefinition(*program, 3).GetDefaultValue()), StaticType::NUMBER);
+    EXPECT_EQ(types.GetType(*GetDefinition(*program, 4).GetDefaultValue()), StaticType::STRING);
+
+    OperationNode *comparison = NodeCast<OperationNode>(GetDefinition(*program, 2).GetDefaultValue().get());
+    ASSERT_NE(comparison, NTT_NULL);
+    EXPECT_EQ(types.GetType(*comparison->GetLeftOperand()), StaticType::NUMBER);
+    EXPECT_EQ(types.GetType(*comparison->GetRightOperand()), StaticType::NUMBER);
+}
+
+TEST(TypeInferenceTest, UnprovenHintsBecomeAny)
+{
+    // `b` is assigned `a` before `a` is known to be ANY, the second walk finds it.
+    Ref<BlockNode> program = Parse("let a : number = 1;"
+                                   "let b : number = 0;"
+                                   "b = a;"
+                                   "a = print();"
+                                   "let c : number = 2;"
+                                   "if (true) { let c : string = \"inner\"; c = c + \"!\"; }");
+
+    TypeInference types;
+    EXPECT_EQ(types.Infer(*program), MachineError::NO_ERROR);
+
+    EXPECT_EQ(GetVariableType(types, *program, 0), StaticType::ANY);
+    EXPECT_EQ(GetVariableType(types, *program, 1), StaticType::ANY);
+    EXPECT_EQ(GetVariableType(types, *program, 4), StaticType::NUMBER);
+}
+
+TEST(TypeInferenceTest, ReportsTheMismatches)
+{
+    const char *programs[] = {
+        "let x : number = \"a\";",
+        "let x : number; x = true;",
+        "let x : string; let y : any = x - 1;",
+        "let y : any = true + 1;",
+        "let y : any = 1 + \"a\";",
+        "let x : boolean; let y : any = x < 1;",
+    };
+
+    for (const char *content : programs)
+    {
+        Ref<BlockNode> program = Parse(content);
+        TypeInference types;
+        EXPECT_EQ(types.Infer(*program), MachineError::TYPE_MISMATCH) << content;
+    }
+
+    Ref<BlockNode> program = Parse("let x : number = \"a\";");
+    TypeInference types;
+    types.Infer(*program);
+    EXPECT_EQ(GetVariableType(types, *program, 0), StaticType::ANY);
+}
+
+TEST(TypeInferenceTest, RegisterMachineSkipsTheKnownTypeChecks)
+{
+    const String typedProgram = "let a : number = 1; let b : number = 2; let s : string = \"s\";"
+                                "a = (a + b) * 2; if (a > b) { b = a - b; } print(a, b, s + \"!\", a == b);";
+
+    Machine machine(MachineBackend::REGISTER);
+    Ref<BlockNode> program = Parse(typedProgram);
+    ASSERT_EQ(machine.Compile(*program), MachineError::NO_ERROR);
+    ASSERT_EQ(machine.Run(), MachineError::NO_ERROR);
+    EXPECT_EQ(machine.GetOutput(), "6 4 s! false\n");
+
+    String disassembly = machine.GetRegisterBytecode().Disassemble();
+    EXPECT_NE(disassembly.find("ADD_NUMBERS"), String::npos);
+    EXPECT_NE(disassembly.find("MULTIPLY_NUMBERS"), String::npos);
+    EXPECT_NE(disassembly.find("GREATER_NUMBERS"), String::npos);
+    EXPECT_NE(disassembly.find("SUBTRACT_NUMBERS"), String::npos);
+    EXPECT_NE(disassembly.find(" ADD "), String::npos);
+
+    // a hint the program does not respect only turns the specialization off.
+    program = Parse("let a : number = 1; a = \"a\"; print(a + \"b\", 2 * 3);");
+    ASSERT_EQ(machine.Compile(*program), MachineError::NO_ERROR);
+    ASSERT_EQ(machine.Run(), MachineError::NO_ERROR);
+    EXPECT_EQ(machine.GetOutput(), "ab 6\n");
+    EXPECT_EQ(machine.GetRegisterBytecode().Disassemble().find("ADD_NUMBERS"), String::npos);
+}
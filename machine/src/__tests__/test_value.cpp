@@ -0,0 +1,93 @@
+#include "test_common.h"
+#include "value.h"
+#include <cmath>
+#include <limits>
+
+using namespace ntt;
+
+TEST(ValueTest, KeepsTheTypeAndContent)
+{
+    String text = "text";
+    const f64 numbers[] = {
+        0.0,
+        -0.0,
+        1.5,
+        -2.0,
+        1e300,
+        std::numeric_limits<f64>::denorm_min(),
+        std::numeric_limits<f64>::infinity(),
+        -std::numeric_limits<f64>::infinity(),
+    };
+
+    for (f64 number : numbers)
+    {
+        Value value = Value::FromNumber(number);
+        EXPECT_EQ(value.GetType(), ValueType::NUMBER) << number;
+        EXPECT_TRUE(value.IsNumber());
+        EXPECT_FALSE(value.IsString() || value.IsBoolean() || value.IsNull());
+        EXPECT_EQ(std::signbit(value.GetNumber()), std::signbit(number));
+        EXPECT_EQ(value.GetNumber(), number);
+    }
+
+    EXPECT_EQ(Value().GetType(), ValueType::NULL_VALUE);
+    EXPECT_TRUE(Value::FromBoolean(NTT_TRUE).GetBoolean());
+    EXPECT_FALSE(Value::FromBoolean(NTT_FALSE).GetBoolean());
+    EXPECT_EQ(Value::FromBoolean(NTT_FALSE).GetType(), ValueType::BOOLEAN);
+    EXPECT_FALSE(Value::FromBoolean(NTT_TRUE).IsNumber() || Value::FromBoolean(NTT_TRUE).IsString());
+
+    Value string = Value::FromString(&text);
+    EXPECT_EQ(string.GetType(), ValueType::STRING);
+    EXPECT_FALSE(string.IsNumber() || string.IsBoolean() || string.IsNull());
+    EXPECT_EQ(&string.GetString(), &text);
+}
+
+TEST(ValueTest, NaNsStayNumbers)
+{
+    // a NaN with the bits of a boxed value must not be read as a boxed value.
+    u64 boxedBits = 0xFFFC000000000001;
+    f64 boxedNaN;
+    std::memcpy(&boxedNaN, &boxedBits, sizeof(boxedNaN));
+
+    for (f64 number : {std::numeric_limits<f64>::quiet_NaN(), -std::numeric_limits<f64>::quiet_NaN(), boxedNaN})
+    {
+        Value value = Value::FromNumber(number);
+        EXPECT_EQ(value.GetType(), ValueType::NUMBER);
+        EXPECT_TRUE(std::isnan(value.GetNumber()));
+        EXPECT_FALSE(value.Equals(value));
+        EXPECT_TRUE(value.IsTruthy());
+        EXPECT_EQ(value.ToString(), "nan");
+    }
+
+    Value zero = Value::FromNumber(0.0);
+    Value result = Value::FromOperationResult(zero.GetNumber() / zero.GetNumber());
+    EXPECT_EQ(result.GetType(), ValueType::NUMBER);
+    EXPECT_TRUE(std::isnan(result.GetNumber()));
+}
+
+TEST(ValueTest, ComparesAndConverts)
+{
+    String a = "a";
+    String otherA = "a";
+    String empty;
+
+    EXPECT_TRUE(Value::FromNumber(0.0).Equals(Value::FromNumber(-0.0)));
+    EXPECT_FALSE(Value::FromNumber(1.0).Equals(Value::FromBoolean(NTT_TRUE)));
+    EXPECT_FALSE(Value::FromNumber(0.0).Equals(Value()));
+    EXPECT_TRUE(Value().Equals(Value()));
+    EXPECT_FALSE(Value().Equals(Value::FromBoolean(NTT_FALSE)));
+    EXPECT_TRUE(Value::FromString(&a).Equals(Value::FromString(&otherA)));
+    EXPECT_FALSE(Value::FromString(&a).Equals(Value::FromString(&empty)));
+
+    EXPECT_FALSE(Value().IsTruthy());
+    EXPECT_FALSE(Value::FromNumber(-0.0).IsTruthy());
+    EXPECT_FALSE(Value::FromBoolean(NTT_FALSE).IsTruthy());
+    EXPECT_FALSE(Value::FromString(&empty).IsTruthy());
+    EXPECT_TRUE(Value::FromNumber(-1.0).IsTruthy());
+    EXPECT_TRUE(Value::FromString(&a).IsTruthy());
+
+    EXPECT_EQ(Value::FromNumber(-3.0).ToString(), "-3");
+    EXPECT_EQ(Value::FromNumber(2.5).ToString(), "2.5");
+    EXPECT_EQ(Value::FromBoolean(NTT_TRUE).ToString(), "true");
+    EXPECT_EQ(Value::FromString(&a).ToString(), "a");
+    EXPECT_EQ(Value().ToString(), "null");
+}
@@ -0,0 +1,167 @@
+#include "bytecode.h"
+#include <algorithm>
+
+namespace ntt
+{
+    namespace
+    {
+        struct OpCodeInfo
+        {
+            const char *name;
+            u32 size;
+            i32 stackEffect;
+        };
+
+        constexpr OpCodeInfo opCodeInfos[] = {
+            {"PUSH_CONSTANT", 3, 1},
+            {"PUSH_NULL", 1, 1},
+            {"PUSH_TRUE", 1, 1},
+            {"PUSH_FALSE", 1, 1},
+
+            {"LOAD_VARIABLE", 3, 1},
+            {"STORE_VARIABLE", 3, -1},
+            {"DUPLICATE", 1, 1},
+            {"POP", 1, -1},
+
+            {"ADD", 1, -1},
+            {"SUBTRACT", 1, -1},
+            {"MULTIPLY", 1, -1},
+            {"DIVIDE", 1, -1},
+            {"POWER", 1, -1},
+
+            {"EQUAL", 1, -1},
+            {"NOT_EQUAL", 1, -1},
+            {"LESS", 1, -1},
+            {"LESS_EQUAL", 1, -1},
+            {"GREATER", 1, -1},
+            {"GREATER_EQUAL", 1, -1},
+            {"NOT", 1, 0},
+
+            {"JUMP", 5, 0},
+            {"JUMP_IF_FALSE", 5, -1},
+            {"CALL", 4, 1},
+
+            {"HALT", 1, 0},
+        };
+
+        static_assert(sizeof(opCodeInfos) / sizeof(opCodeInfos[0]) == u32(OpCode::COUNT),
+                      "Every op code needs its info.");
+    } // namespace anonymous
+
+    String OpCodeToString(OpCode opCode)
+    {
+        return opCode < OpCode::COUNT ? opCodeInfos[u32(opCode)].name : "UNKNOWN";
+    }
+
+    u32 GetInstructionSize(OpCode opCode)
+    {
+        return opCodeInfos[u32(opCode)].size;
+    }
+
+    i32 GetStackEffect(OpCode opCode)
+    {
+        return opCodeInfos[u32(opCode)].stackEffect;
+    }
+
+    Bytecode::Bytecode()
+        : m_maxStackDepth(0)
+    {
+    }
+
+    Bytecode::~Bytecode()
+    {
+    }
+
+    u32 Bytecode::AddNumber(f64 number)
+    {
+        u64 numberBits;
+        std::memcpy(&numberBits, &number, sizeof(number));
+
+        auto constant = m_numberConstants.find(numberBits);
+        if (constant != m_numberConstants.end())
+        {
+            return constant->second;
+        }
+
+        u32 constantIndex = GetConstantCount();
+        m_constants.push_back(Value::FromNumber(number));
+        m_numberConstants.emplace(numberBits, constantIndex);
+        return constantIndex;
+    }
+
+    u32 Bytecode::AddString(const String &text)
+    {
+        auto constant = m_stringConstants.find(text);
+        if (constant != m_stringConstants.end())
+        {
+            return constant->second;
+        }
+
+        u32 constantIndex = GetConstantCount();
+        m_strings.push_back(text);
+        m_constants.push_back(Value::FromString(&m_strings.back()));
+        m_stringConstants.emplace(text, constantIndex);
+        return constantIndex;
+    }
+
+    u32 Bytecode::AddVariable(const String &name)
+    {
+        m_variableNames.push_back(name);
+        return GetVariableCount() - 1;
+    }
+
+    u32 Bytecode::AddFunction(const String &name)
+    {
+        auto function = std::find(m_functionNames.begin(), m_functionNames.end(), name);
+        if (function != m_functionNames.end())
+        {
+            return u32(function - m_functionNames.begin());
+        }
+
+        m_functionNames.push_back(name);
+        return u32(m_functionNames.size()) - 1;
+    }
+
+    u32 Bytecode::GetInstructionCount() const
+    {
+        u32 numberOfInstructions = 0;
+        for (u32 offset = 0; offset < GetSize(); offset += GetInstructionSize(OpCode(m_code[offset])))
+        {
+            numberOfInstructions++;
+        }
+        return numberOfInstructions;
+    }
+
+    String Bytecode::Disassemble() const
+    {
+        String text;
+        for (u32 offset = 0; offset < GetSize(); offset += GetInstructionSize(OpCode(m_code[offset])))
+        {
+            OpCode opCode = OpCode(m_code[offset]);
+            text += std::to_string(offset) + " " + OpCodeToString(opCode);
+
+            switch (opCode)
+            {
+            case OpCode::PUSH_CONSTANT:
+                text += " " + GetConstant(Read<u16>(offset + 1)).ToString();
+                break;
+            case OpCode::LOAD_VARIABLE:
+            case OpCode::STORE_VARIABLE:
+                text += " " + m_variableNames[Read<u16>(offset + 1)];
+                break;
+            case OpCode::JUMP:
+            case OpCode::JUMP_IF_FALSE:
+                text += " " + std::to_string(Read<u32>(offset + 1));
+                break;
+            case OpCode::CALL:
+                text += " " + m_functionNames[Read<u16>(offset + 1)] + " " + std::to_string(Read<u8>(offset + 3));
+                break;
+            default:
+                break;
+            }
+
+            text += "\n";
+        }
+        return text;
+    }
+} // namespace ntt
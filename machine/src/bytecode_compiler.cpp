@@ -0,0 +1,423 @@
+#include "bytecode_compiler.h"
+#include "parser/atomic.h"
+#include "parser/blockNode.h"
+#include "parser/function_call.h"
+#include "parser/if_statement.h"
+#include "parser/operationNode.h"
+#include "parser/unaryOperationNode.h"
+#include "parser/variable_definition_node.h"
+#include <algorithm>
+
+namespace ntt
+{
+    namespace
+    {
+        constexpr u32 MAX_OPERAND_INDEX = 0xFFFF;
+        constexpr u32 MAX_NUMBER_OF_ARGUMENTS = 0xFF;
+
+        /**
+         * @return The instruction of a binary operator, `OpCode::COUNT` for the ones the
+         *      machine does not support.
+         */
+        OpCode GetBinaryOpCode(Symbol operatorSymbol)
+        {
+            switch (operatorSymbol)
+            {
+            case Symbol::PLUS:
+                return OpCode::ADD;
+            case Symbol::MINUS:
+                return OpCode::SUBTRACT;
+            case Symbol::MULTIPLY:
+                return OpCode::MULTIPLY;
+            case Symbol::DIVIDE:
+                return OpCode::DIVIDE;
+            case Symbol::CARET:
+                return OpCode::POWER;
+            case Symbol::EQUAL:
+                return OpCode::EQUAL;
+            case Symbol::NOT_EQUAL:
+                return OpCode::NOT_EQUAL;
+            case Symbol::LESS:
+                return OpCode::LESS;
+            case Symbol::LESS_EQUAL:
+                return OpCode::LESS_EQUAL;
+            case Symbol::GREATER:
+                return OpCode::GREATER;
+            case Symbol::GREATER_EQUAL:
+                return OpCode::GREATER_EQUAL;
+            default:
+                return OpCode::COUNT;
+            }
+        }
+    } // namespace anonymous
+
+    BytecodeCompiler::BytecodeCompiler(Bytecode &bytecode)
+        : m_bytecode(bytecode), m_error(MachineError::NO_ERROR), m_stackDepth(0), m_maxStackDepth(0)
+    {
+    }
+
+    BytecodeCompiler::~BytecodeCompiler()
+    {
+    }
+
+    MachineError BytecodeCompiler::Compile(Node &program)
+    {
+        CompileStatement(program);
+        Emit(OpCode::HALT);
+
+        m_bytecode.SetMaxStackDepth(m_maxStackDepth);
+        return m_error;
+    }
+
+    void BytecodeCompiler::CompileNode(Node &node)
+    {
+        if (m_error != MachineError::NO_ERROR)
+        {
+            return;
+        }
+
+        if (node.HasErrors())
+        {
+            SetError(MachineError::INVALID_PROGRAM);
+            return;
+        }
+
+        node.Accept(*this);
+    }
+
+    void BytecodeCompiler::CompileStatement(Node &node)
+    {
+        switch (node.GetType())
+        {
+        case NodeType::ATOMIC:
+        case NodeType::EXPRESSION:
+        case NodeType::UNARY_OPERATION:
+        case NodeType::FUNCTION_CALL:
+            CompileNode(node);
+            Emit(OpCode::POP);
+            break;
+        case NodeType::OPERATION:
+        {
+            OperationNode &operationNode = static_cast<OperationNode &>(node);
+            if (GetAtomicSymbol(operationNode.GetOperator()) == Symbol::ASSIGN && !node.HasErrors())
+            {
+                CompileAssignment(operationNode, NTT_FALSE);
+                break;
+            }
+
+            CompileNode(node);
+            Emit(OpCode::POP);
+            break;
+        }
+        default:
+            CompileNode(node);
+            break;
+        }
+    }
+
+    void BytecodeCompiler::CompileBlock(const Vector<Ref<Node>> &children)
+    {
+        m_scopes.PushBlock();
+
+        for (const Ref<Node> &child : children)
+        {
+            CompileStatement(*child);
+        }
+
+        m_scopes.PopBlock();
+    }
+
+    void BytecodeCompiler::Visit(Atomic &node)
+    {
+        const Token &token = node.GetToken();
+
+        switch (token.GetType())
+        {
+        case TokenType::INTEGER:
+            EmitConstant(m_bytecode.AddNumber(f64(token.GetValue<u64>())));
+            break;
+        case TokenType::FLOAT:
+            EmitConstant(m_bytecode.AddNumber(token.GetValue<f64>()));
+            break;
+        case TokenType::BOOLEAN:
+            Emit(token.GetValue<b8>() ? OpCode::PUSH_TRUE : OpCode::PUSH_FALSE);
+            break;
+        case TokenType::STRING:
+            EmitConstant(m_bytecode.AddString(GetStringContent(token)));
+            break;
+        case TokenType::IDENTIFIER:
+        {
+            const VariableScopes::Variable *variable = m_scopes.Find(token.GetSymbol());
+            if (variable == NTT_NULL)
+            {
+                SetError(MachineError::UNDEFINED_VARIABLE);
+                break;
+            }
+
+            EmitVariable(OpCode::LOAD_VARIABLE, variable->slot);
+            break;
+        }
+        case TokenType::NONE:
+            // the default value of the `any` variables.
+            Emit(OpCode::PUSH_NULL);
+            break;
+        case TokenType::KEYWORD:
+            if (token.GetSymbol() == Symbol::NULL_VALUE)
+            {
+                Emit(OpCode::PUSH_NULL);
+                break;
+            }
+            SetError(MachineError::UNSUPPORTED_NODE);
+            break;
+        default:
+            SetError(MachineError::UNSUPPORTED_NODE);
+            break;
+        }
+    }
+
+    void BytecodeCompiler::Visit(BlockNode &node)
+    {
+        switch (node.GetType())
+        {
+        case NodeType::PROGRAM:
+        case NodeType::BLOCK:
+            CompileBlock(node.GetChildren());
+            break;
+        case NodeType::STATEMENT:
+            for (const Ref<Node> &child : node.GetChildren())
+            {
+                CompileStatement(*child);
+            }
+            break;
+        case NodeType::EXPRESSION:
+            if (node.GetChildren().size() != 1)
+            {
+                SetError(MachineError::UNSUPPORTED_NODE);
+                break;
+            }
+            CompileNode(*node.GetChildren()[0]);
+            break;
+        default:
+            SetError(MachineError::UNSUPPORTED_NODE);
+            break;
+        }
+    }
+
+    void BytecodeCompiler::Visit(InvalidNode &node)
+    {
+        NTT_UNUSED(node);
+        SetError(MachineError::INVALID_PROGRAM);
+    }
+
+    void BytecodeCompiler::Visit(OperationNode &node)
+    {
+        Symbol operatorSymbol = GetAtomicSymbol(node.GetOperator());
+        if (operatorSymbol == Symbol::ASSIGN)
+        {
+            CompileAssignment(node, NTT_TRUE);
+            return;
+        }
+
+        OpCode opCode = GetBinaryOpCode(operatorSymbol);
+        if (opCode == OpCode::COUNT || node.GetLeftOperand() == NTT_NULL || node.GetRightOperand() == NTT_NULL)
+        {
+            SetError(MachineError::UNSUPPORTED_NODE);
+            return;
+        }
+
+        CompileNode(*node.GetLeftOperand());
+        CompileNode(*node.GetRightOperand());
+        Emit(opCode);
+    }
+
+    void BytecodeCompiler::Visit(UnaryOperationNode &node)
+    {
+        if (GetAtomicSymbol(node.GetOperator()) != Symbol::NOT || node.GetOperand() == NTT_NULL)
+        {
+            SetError(MachineError::UNSUPPORTED_NODE);
+            return;
+        }
+
+        CompileNode(*node.GetOperand());
+        Emit(OpCode::NOT);
+    }
+
+    void BytecodeCompiler::Visit(IfStatementNode &node)
+    {
+        if (node.GetCondition() == NTT_NULL || node.GetBlock() == NTT_NULL)
+        {
+            SetError(MachineError::INVALID_PROGRAM);
+            return;
+        }
+
+        CompileNode(*node.GetCondition());
+        u32 elseJump = EmitJump(OpCode::JUMP_IF_FALSE);
+        CompileStatement(*node.GetBlock());
+
+        const BlockNode *elseBlock = NodeCast<BlockNode>(node.GetElseBlock().get());
+        if (node.GetElseBlock() == NTT_NULL || (elseBlock != NTT_NULL && elseBlock->GetChildren().empty()))
+        {
+            PatchJump(elseJump);
+            return;
+        }
+
+        u32 endJump = EmitJump(OpCode::JUMP);
+        PatchJump(elseJump);
+        CompileStatement(*node.GetElseBlock());
+        PatchJump(endJump);
+    }
+
+    void BytecodeCompiler::Visit(FunctionCallNode &node)
+    {
+        if (!IsIdentifierAtomic(node.GetFunction()))
+        {
+            SetError(MachineError::UNSUPPORTED_NODE);
+            return;
+        }
+
+        const Vector<Ref<Node>> &arguments = node.GetArguments();
+        if (arguments.size() > MAX_NUMBER_OF_ARGUMENTS)
+        {
+            SetError(MachineError::TOO_MANY_ARGUMENTS);
+            return;
+        }
+
+        for (const Ref<Node> &argument : arguments)
+        {
+            CompileNode(*argument);
+        }
+
+        std::string_view name = NodeCast<Atomic>(node.GetFunction().get())->GetToken().GetValue<std::string_view>();
+        u32 functionIndex = m_bytecode.AddFunction(String(name));
+        if (functionIndex > MAX_OPERAND_INDEX)
+        {
+            SetError(MachineError::TOO_MANY_CONSTANTS);
+            return;
+        }
+
+        if (m_error != MachineError::NO_ERROR)
+        {
+            return;
+        }
+
+        Emit(OpCode::CALL);
+        m_bytecode.Append<u16>(u16(functionIndex));
+        m_bytecode.Append<u8>(u8(arguments.size()));
+        m_stackDepth -= u32(arguments.size());
+    }
+
+    void BytecodeCompiler::Visit(VariableDefinitionNode &node)
+    {
+        if (!IsIdentifierAtomic(node.GetName()) || node.GetDefaultValue() == NTT_NULL)
+        {
+            SetError(MachineError::INVALID_PROGRAM);
+            return;
+        }
+
+        Symbol name = GetAtomicSymbol(node.GetName());
+        if (m_scopes.IsDefinedInBlock(name))
+        {
+            SetError(MachineError::REDEFINED_VARIABLE);
+            return;
+        }
+
+        // the default value is compiled first, so it still sees the variables the new
+        //      one hides.
+        CompileNode(*node.GetDefaultValue());
+
+        if (m_bytecode.GetVariableCount() > MAX_OPERAND_INDEX)
+        {
+            SetError(MachineError::TOO_MANY_VARIABLES);
+            return;
+        }
+
+        u32 slot = m_bytecode.AddVariable(String(SymbolTable::Get().GetText(name)));
+        m_scopes.Add(name, slot, GetAtomicSymbol(node.GetDefineType()) == Symbol::CONST);
+        EmitVariable(OpCode::STORE_VARIABLE, slot);
+    }
+
+    void BytecodeCompiler::CompileAssignment(OperationNode &node, b8 isValueKept)
+    {
+        if (!IsIdentifierAtomic(node.GetLeftOperand()) || node.GetRightOperand() == NTT_NULL)
+        {
+            SetError(MachineError::UNSUPPORTED_NODE);
+            return;
+        }
+
+        const VariableScopes::Variable *variable = m_scopes.Find(GetAtomicSymbol(node.GetLeftOperand()));
+        if (variable == NTT_NULL)
+        {
+            SetError(MachineError::UNDEFINED_VARIABLE);
+            return;
+        }
+
+        if (variable->isConstant)
+        {
+            SetError(MachineError::ASSIGN_TO_CONSTANT);
+            return;
+        }
+
+        u32 slot = variable->slot;
+        CompileNode(*node.GetRightOperand());
+        if (isValueKept)
+        {
+            Emit(OpCode::DUPLICATE);
+        }
+        EmitVariable(OpCode::STORE_VARIABLE, slot);
+    }
+
+    void BytecodeCompiler::Emit(OpCode opCode)
+    {
+        if (m_error != MachineError::NO_ERROR)
+        {
+            return;
+        }
+
+        m_bytecode.Emit(opCode);
+        m_stackDepth += GetStackEffect(opCode);
+        m_maxStackDepth = std::max(m_maxStackDepth, m_stackDepth);
+    }
+
+    void BytecodeCompiler::EmitConstant(u32 constantIndex)
+    {
+        if (constantIndex > MAX_OPERAND_INDEX)
+        {
+            SetError(MachineError::TOO_MANY_CONSTANTS);
+            return;
+        }
+
+        Emit(OpCode::PUSH_CONSTANT);
+        m_bytecode.Append<u16>(u16(constantIndex));
+    }
+
+    void BytecodeCompiler::EmitVariable(OpCode opCode, u32 slot)
+    {
+        Emit(opCode);
+        m_bytecode.Append<u16>(u16(slot));
+    }
+
+    u32 BytecodeCompiler::EmitJump(OpCode opCode)
+    {
+        Emit(opCode);
+        m_bytecode.Append<u32>(0);
+        return m_bytecode.GetSize() - sizeof(u32);
+    }
+
+    void BytecodeCompiler::PatchJump(u32 operandOffset)
+    {
+        if (m_error != MachineError::NO_ERROR)
+        {
+            return;
+        }
+
+        m_bytecode.Write<u32>(operandOffset, m_bytecode.GetSize());
+    }
+
+    void BytecodeCompiler::SetError(MachineError error)
+    {
+        if (m_error == MachineError::NO_ERROR)
+        {
+            m_error = error;
+        }
+    }
+} // namespace ntt
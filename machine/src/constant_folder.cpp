@@ -0,0 +1,484 @@
+#include "constant_folder.h"
+#include "lowering_utils.h"
+#include "parser/atomic.h"
+#include "parser/blockNode.h"
+#include "parser/flat_ast.h"
+#include "parser/function_call.h"
+#include "parser/if_statement.h"
+#include "parser/operationNode.h"
+#include "parser/unaryOperationNode.h"
+#include "parser/variable_definition_node.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ntt
+{
+    namespace
+    {
+        // the largest integer a f64 holds exactly, the folded numbers above it are FLOAT.
+        constexpr f64 MAX_EXACT_INTEGER = 9007199254740992.0;
+
+        // an operation node, its operator and its two operands when they are atomics.
+        constexpr u32 NUMBER_OF_OPERATION_NODES = 4;
+
+        // a unary operation node and its operator.
+        constexpr u32 NUMBER_OF_UNARY_OPERATION_NODES = 2;
+
+        u32 CountNodes(const Ref<Node> &node)
+        {
+            return node != NTT_NULL ? FlatAst(*node).GetNodeCount() : 0;
+        }
+
+        b8 IsComparison(Symbol operatorSymbol)
+        {
+            switch (operatorSymbol)
+            {
+            case Symbol::EQUAL:
+            case Symbol::NOT_EQUAL:
+            case Symbol::LESS:
+            case Symbol::LESS_EQUAL:
+            case Symbol::GREATER:
+            case Symbol::GREATER_EQUAL:
+                return NTT_TRUE;
+            default:
+                return NTT_FALSE;
+            }
+        }
+
+        /**
+         * @return Whether the node always gives a boolean: the boolean literals, the
+         *      comparisons and the `!`.
+         */
+        b8 IsBooleanNode(const Ref<Node> &node)
+        {
+            if (const Atomic *atomicNode = NodeCast<Atomic>(node.get()))
+            {
+                return atomicNode->GetToken().GetType() == TokenType::BOOLEAN;
+            }
+
+            if (const OperationNode *operationNode = NodeCast<OperationNode>(node.get()))
+            {
+                return IsComparison(GetAtomicSymbol(operationNode->GetOperator()));
+            }
+
+            const UnaryOperationNode *unaryNode = NodeCast<UnaryOperationNode>(node.get());
+            return unaryNode != NTT_NULL && GetAtomicSymbol(unaryNode->GetOperator()) == Symbol::NOT;
+        }
+
+        /**
+         * `x + 0` is not `x` for `x = -0`, only `x + (-0)` is.
+         *
+         * @param isRightOperand Whether `literal` is the right operand, `x - 0` is `x` but
+         *      `0 - x` is not.
+         * @return Whether the operation gives its other operand when it is a number.
+         */
+        b8 IsIdentityOperand(Symbol operatorSymbol, const Value &literal, b8 isRightOperand)
+        {
+            if (!literal.IsNumber())
+            {
+                return NTT_FALSE;
+            }
+
+            switch (operatorSymbol)
+            {
+            case Symbol::MULTIPLY:
+                return literal.GetNumber() == 1.0;
+            case Symbol::DIVIDE:
+            case Symbol::CARET:
+                return isRightOperand && literal.GetNumber() == 1.0;
+            case Symbol::PLUS:
+                return literal.GetNumber() == 0.0 && std::signbit(literal.GetNumber());
+            case Symbol::MINUS:
+                return isRightOperand && literal.GetNumber() == 0.0 && !std::signbit(literal.GetNumber());
+            default:
+                return NTT_FALSE;
+            }
+        }
+
+        /**
+         * Same results as the instructions of the machine.
+         *
+         * @return Whether the operation can be computed, the ones the machine would stop
+         *      on are left to it.
+         */
+        b8 FoldOperation(Symbol operatorSymbol, const Value &left, const Value &right,
+                         std::deque<String> &strings, Value &outResult)
+        {
+            if (operatorSymbol == Symbol::EQUAL || operatorSymbol == Symbol::NOT_EQUAL)
+            {
+                outResult = Value::FromBoolean(left.Equals(right) == (operatorSymbol == Symbol::EQUAL));
+                return NTT_TRUE;
+            }
+
+            if (operatorSymbol == Symbol::PLUS && left.IsString() && right.IsString())
+            {
+                strings.push_back(left.GetString() + right.GetString());
+                outResult = Value::FromString(&strings.back());
+                return NTT_TRUE;
+            }
+
+            if (!left.IsNumber() || !right.IsNumber())
+            {
+                return NTT_FALSE;
+            }
+
+            f64 leftNumber = left.GetNumber();
+            f64 rightNumber = right.GetNumber();
+            switch (operatorSymbol)
+            {
+            case Symbol::PLUS:
+                outResult = Value::FromNumber(leftNumber + rightNumber);
+                return NTT_TRUE;
+            case Symbol::MINUS:
+                outResult = Value::FromNumber(leftNumber - rightNumber);
+                return NTT_TRUE;
+            case Symbol::MULTIPLY:
+                outResult = Value::FromNumber(leftNumber * rightNumber);
+                return NTT_TRUE;
+            case Symbol::DIVIDE:
+                outResult = Value::FromNumber(leftNumber / rightNumber);
+                return NTT_TRUE;
+            case Symbol::CARET:
+                outResult = Value::FromNumber(std::pow(leftNumber, rightNumber));
+                return NTT_TRUE;
+            case Symbol::LESS:
+                outResult = Value::FromBoolean(leftNumber < rightNumber);
+                return NTT_TRUE;
+            case Symbol::LESS_EQUAL:
+                outResult = Value::FromBoolean(leftNumber <= rightNumber);
+                return NTT_TRUE;
+            case Symbol::GREATER:
+                outResult = Value::FromBoolean(leftNumber > rightNumber);
+                return NTT_TRUE;
+            case Symbol::GREATER_EQUAL:
+                outResult = Value::FromBoolean(leftNumber >= rightNumber);
+                return NTT_TRUE;
+            default:
+                return NTT_FALSE;
+            }
+        }
+
+        /**
+         * @return The text of a string literal, quoted and escaped like the lexed ones.
+         */
+        String QuoteString(const String &content)
+        {
+            String text = "\"";
+            for (char character : content)
+            {
+                switch (character)
+                {
+                case '\n':
+                    text += "\\n";
+                    break;
+                case '\t':
+                    text += "\\t";
+                    break;
+                case '"':
+                case '\\':
+                    text.push_back('\\');
+                    text.push_back(character);
+                    break;
+                default:
+                    text.push_back(character);
+                    break;
+                }
+            }
+            text += "\"";
+            return text;
+        }
+    } // namespace anonymous
+
+    ConstantFolder::ConstantFolder(const TypeInference *types)
+        : m_types(types), m_numberOfEliminatedNodes(0), m_isRemoved(NTT_FALSE)
+    {
+    }
+
+    ConstantFolder::~ConstantFolder()
+    {
+    }
+
+    u32 ConstantFolder::Fold(Node &program)
+    {
+        u32 numberOfEliminatedNodes = m_numberOfEliminatedNodes;
+
+        // the root itself is never replaced, only its children.
+        if (!program.HasErrors())
+        {
+            program.Accept(*this);
+        }
+
+        m_replacement = NTT_NULL;
+        m_isRemoved = NTT_FALSE;
+        m_strings.clear();
+        return m_numberOfEliminatedNodes - numberOfEliminatedNodes;
+    }
+
+    void ConstantFolder::FoldNode(Ref<Node> &node)
+    {
+        if (node == NTT_NULL || node->HasErrors())
+        {
+            return;
+        }
+
+        m_replacement = NTT_NULL;
+        m_isRemoved = NTT_FALSE;
+        node->Accept(*this);
+
+        if (m_isRemoved)
+        {
+            node = NTT_NULL;
+        }
+        else if (m_replacement != NTT_NULL)
+        {
+            node = m_replacement;
+        }
+
+        m_replacement = NTT_NULL;
+        m_isRemoved = NTT_FALSE;
+    }
+
+    void ConstantFolder::Replace(const Ref<Node> &replacement, u32 numberOfEliminatedNodes)
+    {
+        m_replacement = replacement;
+        m_numberOfEliminatedNodes += numberOfEliminatedNodes;
+    }
+
+    void ConstantFolder::Visit(BlockNode &node)
+    {
+        Vector<Ref<Node>> &children = node.GetChildren();
+        for (Ref<Node> &child : children)
+        {
+            FoldNode(child);
+        }
+
+        children.erase(std::remove(children.begin(), children.end(), NTT_NULL), children.end());
+
+        if (node.GetType() == NodeType::EXPRESSION && children.size() == 1)
+        {
+            Replace(children[0], 1);
+        }
+    }
+
+    void ConstantFolder::Visit(OperationNode &node)
+    {
+        FoldNode(node.GetLeftOperand());
+        FoldNode(node.GetRightOperand());
+
+        Symbol operatorSymbol = GetAtomicSymbol(node.GetOperator());
+        if (operatorSymbol == Symbol::ASSIGN)
+        {
+            return;
+        }
+
+        Value left;
+        Value right;
+        b8 isLeftLiteral = GetLiteral(node.GetLeftOperand(), left);
+        b8 isRightLiteral = GetLiteral(node.GetRightOperand(), right);
+
+        if (isLeftLiteral && isRightLiteral)
+        {
+            Value result;
+            if (!FoldOperation(operatorSymbol, left, right, m_strings, result))
+            {
+                return;
+            }
+
+            u32 startIndex = NodeCast<Atomic>(node.GetLeftOperand().get())->GetToken().GetStartIndex();
+            Ref<Node> literal = CreateLiteral(result, startIndex);
+            if (literal != NTT_NULL)
+            {
+                Replace(literal, NUMBER_OF_OPERATION_NODES - 1);
+            }
+            return;
+        }
+
+        // the instructions stop on the operands which are not numbers, so the other
+        //      operand must be known to be one.
+        if (isRightLiteral && IsIdentityOperand(operatorSymbol, right, NTT_TRUE) &&
+            IsNumberNode(node.GetLeftOperand()))
+        {
+            Replace(node.GetLeftOperand(), NUMBER_OF_OPERATION_NODES - 1);
+        }
+        else if (isLeftLiteral && IsIdentityOperand(operatorSymbol, left, NTT_FALSE) &&
+                 IsNumberNode(node.GetRightOperand()))
+        {
+            Replace(node.GetRightOperand(), NUMBER_OF_OPERATION_NODES - 1);
+        }
+    }
+
+    void ConstantFolder::Visit(UnaryOperationNode &node)
+    {
+        FoldNode(node.GetOperand());
+
+        if (GetAtomicSymbol(node.GetOperator()) != Symbol::NOT)
+        {
+            return;
+        }
+
+        Value operand;
+        if (GetLiteral(node.GetOperand(), operand))
+        {
+            u32 startIndex = NodeCast<Atomic>(node.GetOperator().get())->GetToken().GetStartIndex();
+            Replace(CreateLiteral(Value::FromBoolean(!operand.IsTruthy()), startIndex), NUMBER_OF_UNARY_OPERATION_NODES);
+            return;
+        }
+
+        // `!!b` is only `b` when `b` is already a boolean, `!!1` is `true`.
+        UnaryOperationNode *innerNode = NodeCast<UnaryOperationNode>(node.GetOperand().get());
+        if (innerNode != NTT_NULL && GetAtomicSymbol(innerNode->GetOperator()) == Symbol::NOT &&
+            IsBooleanNode(innerNode->GetOperand()))
+        {
+            Replace(innerNode->GetOperand(), 2 * NUMBER_OF_UNARY_OPERATION_NODES);
+        }
+    }
+
+    void ConstantFolder::Visit(IfStatementNode &node)
+    {
+        FoldNode(node.GetCondition());
+        FoldNode(node.GetBlock());
+        FoldNode(node.GetElseBlock());
+
+        Value condition;
+        if (!GetLiteral(node.GetCondition(), condition))
+        {
+            return;
+        }
+
+        const Ref<Node> &takenBlock = condition.IsTruthy() ? node.GetBlock() : node.GetElseBlock();
+        const Ref<Node> &droppedBlock = condition.IsTruthy() ? node.GetElseBlock() : node.GetBlock();
+        u32 numberOfEliminatedNodes = 1 + CountNodes(node.GetCondition()) + CountNodes(droppedBlock);
+
+        const BlockNode *takenBlockNode = NodeCast<BlockNode>(takenBlock.get());
+        if (takenBlock == NTT_NULL || (takenBlockNode != NTT_NULL && takenBlockNode->GetChildren().empty()))
+        {
+            m_isRemoved = NTT_TRUE;
+            m_numberOfEliminatedNodes += numberOfEliminatedNodes + CountNodes(takenBlock);
+            return;
+        }
+
+        Replace(takenBlock, numberOfEliminatedNodes);
+    }
+
+    void ConstantFolder::Visit(FunctionCallNode &node)
+    {
+        for (Ref<Node> &argument : node.GetArguments())
+        {
+            FoldNode(argument);
+        }
+    }
+
+    void ConstantFolder::Visit(VariableDefinitionNode &node)
+    {
+        FoldNode(node.GetDefaultValue());
+    }
+
+    b8 ConstantFolder::IsNumberNode(const Ref<Node> &node) const
+    {
+        if (const Atomic *atomicNode = NodeCast<Atomic>(node.get()))
+        {
+            // only the identifiers are looked up, they are never created by the folder so
+            //      their types are still the inferred ones.
+            switch (atomicNode->GetToken().GetType())
+            {
+            case TokenType::INTEGER:
+            case TokenType::FLOAT:
+                return NTT_TRUE;
+            case TokenType::IDENTIFIER:
+                return m_types != NTT_NULL && m_types->GetType(*atomicNode) == StaticType::NUMBER;
+            default:
+                return NTT_FALSE;
+            }
+        }
+
+        const OperationNode *operationNode = NodeCast<OperationNode>(node.get());
+        if (operationNode == NTT_NULL)
+        {
+            return NTT_FALSE;
+        }
+
+        // the arithmetic either gives a number or stops the machine, `+` only adds two
+        //      numbers when one of them is a number.
+        switch (GetAtomicSymbol(operationNode->GetOperator()))
+        {
+        case Symbol::MINUS:
+        case Symbol::MULTIPLY:
+        case Symbol::DIVIDE:
+        case Symbol::CARET:
+            return NTT_TRUE;
+        case Symbol::PLUS:
+            return IsNumberNode(operationNode->GetLeftOperand()) || IsNumberNode(operationNode->GetRightOperand());
+        default:
+            return NTT_FALSE;
+        }
+    }
+
+    b8 ConstantFolder::GetLiteral(const Ref<Node> &node, Value &outValue)
+    {
+        const Atomic *atomicNode = NodeCast<Atomic>(node.get());
+        if (atomicNode == NTT_NULL)
+        {
+            return NTT_FALSE;
+        }
+
+        const Token &token = atomicNode->GetToken();
+        switch (token.GetType())
+        {
+        case TokenType::INTEGER:
+            outValue = Value::FromNumber(f64(token.GetValue<u64>()));
+            return NTT_TRUE;
+        case TokenType::FLOAT:
+            outValue = Value::FromNumber(token.GetValue<f64>());
+            return NTT_TRUE;
+        case TokenType::BOOLEAN:
+            outValue = Value::FromBoolean(token.GetValue<b8>());
+            return NTT_TRUE;
+        case TokenType::STRING:
+            m_strings.push_back(GetStringContent(token));
+            outValue = Value::FromString(&m_strings.back());
+            return NTT_TRUE;
+        default:
+            return NTT_FALSE;
+        }
+    }
+
+    Ref<Node> ConstantFolder::CreateLiteral(const Value &value, u32 startIndex) const
+    {
+        switch (value.GetType())
+        {
+        case ValueType::NUMBER:
+        {
+            f64 number = value.GetNumber();
+            if (!std::isfinite(number))
+            {
+                return NTT_NULL;
+            }
+
+            if (number >= 0.0 && number <= MAX_EXACT_INTEGER && number == std::floor(number) && !std::signbit(number))
+            {
+                Token token(TokenType::INTEGER, startIndex);
+                token.SetValue<u64>(u64(number));
+                return CreateRef<Atomic>(NodeType::ATOMIC, token);
+            }
+
+            Token token(TokenType::FLOAT, startIndex);
+            token.SetValue<f64>(number);
+            return CreateRef<Atomic>(NodeType::ATOMIC, token);
+        }
+        case ValueType::BOOLEAN:
+        {
+            Token token(TokenType::BOOLEAN, startIndex);
+            token.SetValue<b8>(value.GetBoolean());
+            return CreateRef<Atomic>(NodeType::ATOMIC, token);
+        }
+        case ValueType::STRING:
+        {
+            Token token(TokenType::STRING, startIndex);
+            token.SetValue<std::string>(QuoteString(value.GetString()));
+            return CreateRef<Atomic>(NodeType::ATOMIC, token);
+        }
+        default:
+            return NTT_NULL;
+        }
+    }
+} // namespace ntt
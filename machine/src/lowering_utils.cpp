@@ -0,0 +1,87 @@
+#include "lowering_utils.h"
+#include "parser/atomic.h"
+
+namespace ntt
+{
+    Symbol GetAtomicSymbol(const Ref<Node> &node)
+    {
+        const Atomic *atomicNode = NodeCast<Atomic>(node.get());
+        return atomicNode != NTT_NULL ? atomicNode->GetToken().GetSymbol() : Symbol::NONE;
+    }
+
+    b8 IsIdentifierAtomic(const Ref<Node> &node)
+    {
+        const Atomic *atomicNode = NodeCast<Atomic>(node.get());
+        return atomicNode != NTT_NULL && atomicNode->GetToken().GetType() == TokenType::IDENTIFIER;
+    }
+
+    String GetStringContent(const Token &token)
+    {
+        std::string_view text = token.GetValue<std::string_view>();
+        if (text.length() < 2 || text.front() != '"' || text.back() != '"')
+        {
+            return String(text);
+        }
+
+        String content;
+        content.reserve(text.length() - 2);
+        for (u32 characterIndex = 1; characterIndex + 1 < text.length(); characterIndex++)
+        {
+            char character = text[characterIndex];
+            if (character == '\\' && characterIndex + 2 < text.length())
+            {
+                characterIndex++;
+                character = text[characterIndex];
+                character = character == 'n'   ? '\n'
+                            : character == 't' ? '\t'
+                                               : character;
+            }
+            content.push_back(character);
+        }
+        return content;
+    }
+
+    VariableScopes::VariableScopes()
+    {
+    }
+
+    VariableScopes::~VariableScopes()
+    {
+    }
+
+    void VariableScopes::PushBlock()
+    {
+        m_blockStarts.push_back(u32(m_variables.size()));
+    }
+
+    void VariableScopes::PopBlock()
+    {
+        m_variables.resize(m_blockStarts.back());
+        m_blockStarts.pop_back();
+    }
+
+    const VariableScopes::Variable *VariableScopes::Find(Symbol name) const
+    {
+        for (auto variable = m_variables.rbegin(); variable != m_variables.rend(); variable++)
+        {
+            if (variable->name == name)
+            {
+                return &*variable;
+            }
+        }
+        return NTT_NULL;
+    }
+
+    b8 VariableScopes::IsDefinedInBlock(Symbol name) const
+    {
+        u32 blockStart = m_blockStarts.empty() ? 0 : m_blockStarts.back();
+        for (u32 variableIndex = blockStart; variableIndex < m_variables.size(); variableIndex++)
+        {
+            if (m_variables[variableIndex].name == name)
+            {
+                return NTT_TRUE;
+            }
+        }
+        return NTT_FALSE;
+    }
+} // namespace ntt
@@ -0,0 +1,654 @@
+#include "machine.h"
+#include "bytecode_compiler.h"
+#include "register_compiler.h"
+#include "type_inference.h"
+#include <algorithm>
+#include <cmath>
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(NTT_MACHINE_SWITCH_DISPATCH)
+#define NTT_MACHINE_COMPUTED_GOTO
+#endif
+
+namespace ntt
+{
+    namespace
+    {
+        template <typename T>
+        inline T ReadOperand(const u8 *instruction, u32 offset = 1)
+        {
+            T value;
+            std::memcpy(&value, instruction + offset, sizeof(T));
+            return value;
+        }
+
+        Value Print(Machine &machine, const Value *arguments, u32 numberOfArguments)
+        {
+            String line;
+            for (u32 argumentIndex = 0; argumentIndex < numberOfArguments; argumentIndex++)
+            {
+                if (argumentIndex != 0)
+                {
+                    line += " ";
+                }
+                line += arguments[argumentIndex].ToString();
+            }
+            line += "\n";
+
+            machine.Write(line);
+            return Value();
+        }
+    } // namespace anonymous
+
+    Machine::Machine(MachineBackend backend)
+        : m_backend(backend), m_executedInstructionCount(0)
+    {
+        RegisterFunction("print", Print);
+    }
+
+    Machine::~Machine()
+    {
+    }
+
+    void Machine::RegisterFunction(const String &name, NativeFunction function)
+    {
+        m_functions[name] = function;
+    }
+
+    MachineError Machine::Compile(Node &program)
+    {
+        m_bytecode = NTT_NULL;
+        m_registerBytecode = NTT_NULL;
+        m_boundFunctions.clear();
+
+        if (m_backend == MachineBackend::REGISTER)
+        {
+            // a type mismatch does not stop the program, the variables which have one are
+            //      only not specialized.
+            TypeInference types;
+            types.Infer(program);
+
+            Scope<RegisterBytecode> bytecode = CreateScope<RegisterBytecode>();
+            RegisterCompiler compiler(*bytecode, &types);
+
+            MachineError error = compiler.Compile(program);
+            if (error == MachineError::NO_ERROR)
+            {
+                error = BindFunctions(bytecode->GetFunctionNames());
+            }
+
+            if (error == MachineError::NO_ERROR)
+            {
+                m_registerBytecode = std::move(bytecode);
+            }
+            return error;
+        }
+
+        Scope<Bytecode> bytecode = CreateScope<Bytecode>();
+        BytecodeCompiler compiler(*bytecode);
+
+        MachineError error = compiler.Compile(program);
+        if (error == MachineError::NO_ERROR)
+        {
+            error = BindFunctions(bytecode->GetFunctionNames());
+        }
+
+        if (error == MachineError::NO_ERROR)
+        {
+            m_bytecode = std::move(bytecode);
+        }
+        return error;
+    }
+
+    MachineError Machine::BindFunctions(const Vector<String> &functionNames)
+    {
+        for (const String &functionName : functionNames)
+        {
+            auto function = m_functions.find(functionName);
+            if (function == m_functions.end())
+            {
+                m_boundFunctions.clear();
+                return MachineError::UNDEFINED_FUNCTION;
+            }
+
+            m_boundFunctions.push_back(function->second);
+        }
+
+        return MachineError::NO_ERROR;
+    }
+
+    Value Machine::GetVariable(const String &name) const
+    {
+        if (m_registerBytecode != NTT_NULL)
+        {
+            const Vector<String> &variableNames = m_registerBytecode->GetVariableNames();
+            auto variableName = std::find(variableNames.begin(), variableNames.end(), name);
+            u32 slot = u32(variableName - variableNames.begin());
+            u32 variableRegister = m_registerBytecode->GetVariableRegister(slot);
+
+            return slot < variableNames.size() && variableRegister < m_registers.size()
+                       ? m_registers[variableRegister]
+                       : Value();
+        }
+
+        if (m_bytecode == NTT_NULL)
+        {
+            return Value();
+        }
+
+        const Vector<String> &variableNames = m_bytecode->GetVariableNames();
+        auto variableName = std::find(variableNames.begin(), variableNames.end(), name);
+        u32 slot = u32(variableName - variableNames.begin());
+
+        return slot < m_variables.size() ? m_variables[slot] : Value();
+    }
+
+    const String *Machine::CreateString(String &&text)
+    {
+        m_runtimeStrings.push_back(std::move(text));
+        return &m_runtimeStrings.back();
+    }
+
+    MachineError Machine::Run()
+    {
+        m_runtimeStrings.clear();
+        m_output.clear();
+
+        if (m_registerBytecode != NTT_NULL)
+        {
+            return RunRegisters();
+        }
+
+        if (m_bytecode == NTT_NULL)
+        {
+            return MachineError::NOT_COMPILED;
+        }
+
+        return RunStack();
+    }
+
+    MachineError Machine::RunStack()
+    {
+        m_variables.assign(m_bytecode->GetVariableCount(), Value());
+        m_stack.resize(std::max(1u, m_bytecode->GetMaxStackDepth()));
+
+        // the state of the loop is kept in locals, so it can stay in registers.
+        const u8 *instruction = m_bytecode->GetCode().data();
+        const u8 *code = instruction;
+        const Value *constants = m_bytecode->GetConstants();
+        const NativeFunction *functions = m_boundFunctions.data();
+        Value *variables = m_variables.data();
+        Value *stackTop = m_stack.data();
+        u64 executedInstructionCount = 0;
+        MachineError error = MachineError::NO_ERROR;
+
+#ifdef NTT_MACHINE_COMPUTED_GOTO
+        static const void *const dispatchTable[] = {
+            &&PUSH_CONSTANT_LABEL,
+            &&PUSH_NULL_LABEL,
+            &&PUSH_TRUE_LABEL,
+            &&PUSH_FALSE_LABEL,
+            &&LOAD_VARIABLE_LABEL,
+            &&STORE_VARIABLE_LABEL,
+            &&DUPLICATE_LABEL,
+            &&POP_LABEL,
+            &&ADD_LABEL,
+            &&SUBTRACT_LABEL,
+            &&MULTIPLY_LABEL,
+            &&DIVIDE_LABEL,
+            &&POWER_LABEL,
+            &&EQUAL_LABEL,
+            &&NOT_EQUAL_LABEL,
+            &&LESS_LABEL,
+            &&LESS_EQUAL_LABEL,
+            &&GREATER_LABEL,
+            &&GREATER_EQUAL_LABEL,
+            &&NOT_LABEL,
+            &&JUMP_LABEL,
+            &&JUMP_IF_FALSE_LABEL,
+            &&CALL_LABEL,
+            &&HALT_LABEL,
+        };
+
+        static_assert(sizeof(dispatchTable) / sizeof(dispatchTable[0]) == u32(OpCode::COUNT),
+                      "Every op code needs its label.");
+
+#define NTT_DISPATCH()                          \
+    {                                           \
+        executedInstructionCount++;             \
+        goto *dispatchTable[*instruction];      \
+    }
+#define NTT_INSTRUCTION(name) name##_LABEL:
+
+        NTT_DISPATCH();
+#else
+#define NTT_DISPATCH() continue
+#define NTT_INSTRUCTION(name) case OpCode::name:
+
+        for (;;)
+        {
+            executedInstructionCount++;
+            switch (OpCode(*instruction))
+            {
+#endif
+
+// the operands are the two values on the top of the stack, the result replaces them.
+#define NTT_NUMBER_OPERATION(result)                          \
+    {                                                         \
+        Value &left = stackTop[-2];                           \
+        const Value &right = stackTop[-1];                    \
+        if (!left.IsNumber() || !right.IsNumber())            \
+        {                                                     \
+            error = MachineError::INVALID_OPERANDS;           \
+            goto finish;                                      \
+        }                                                     \
+        left = result;                                        \
+        stackTop--;                                           \
+        instruction++;                                        \
+        NTT_DISPATCH();                                       \
+    }
+
+        NTT_INSTRUCTION(PUSH_CONSTANT)
+        {
+            *stackTop++ = constants[ReadOperand<u16>(instruction)];
+            instruction += 3;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(PUSH_NULL)
+        {
+            *stackTop++ = Value();
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(PUSH_TRUE)
+        {
+            *stackTop++ = Value::FromBoolean(NTT_TRUE);
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(PUSH_FALSE)
+        {
+            *stackTop++ = Value::FromBoolean(NTT_FALSE);
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(LOAD_VARIABLE)
+        {
+            *stackTop++ = variables[ReadOperand<u16>(instruction)];
+            instruction += 3;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(STORE_VARIABLE)
+        {
+            variables[ReadOperand<u16>(instruction)] = *--stackTop;
+            instruction += 3;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(DUPLICATE)
+        {
+            *stackTop = stackTop[-1];
+            stackTop++;
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(POP)
+        {
+            stackTop--;
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(ADD)
+        {
+            Value &left = stackTop[-2];
+            const Value &right = stackTop[-1];
+            if (left.IsString() && right.IsString())
+            {
+                left = Value::FromString(CreateString(left.GetString() + right.GetString()));
+                stackTop--;
+                instruction++;
+                NTT_DISPATCH();
+            }
+
+            NTT_NUMBER_OPERATION(Value::FromOperationResult(left.GetNumber() + right.GetNumber()));
+        }
+
+        NTT_INSTRUCTION(SUBTRACT)
+        NTT_NUMBER_OPERATION(Value::FromOperationResult(left.GetNumber() - right.GetNumber()));
+
+        NTT_INSTRUCTION(MULTIPLY)
+        NTT_NUMBER_OPERATION(Value::FromOperationResult(left.GetNumber() * right.GetNumber()));
+
+        NTT_INSTRUCTION(DIVIDE)
+        NTT_NUMBER_OPERATION(Value::FromOperationResult(left.GetNumber() / right.GetNumber()));
+
+        NTT_INSTRUCTION(POWER)
+        NTT_NUMBER_OPERATION(Value::FromOperationResult(std::pow(left.GetNumber(), right.GetNumber())));
+
+        NTT_INSTRUCTION(EQUAL)
+        {
+            stackTop[-2] = Value::FromBoolean(stackTop[-2].Equals(stackTop[-1]));
+            stackTop--;
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(NOT_EQUAL)
+        {
+            stackTop[-2] = Value::FromBoolean(!stackTop[-2].Equals(stackTop[-1]));
+            stackTop--;
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(LESS)
+        NTT_NUMBER_OPERATION(Value::FromBoolean(left.GetNumber() < right.GetNumber()));
+
+        NTT_INSTRUCTION(LESS_EQUAL)
+        NTT_NUMBER_OPERATION(Value::FromBoolean(left.GetNumber() <= right.GetNumber()));
+
+        NTT_INSTRUCTION(GREATER)
+        NTT_NUMBER_OPERATION(Value::FromBoolean(left.GetNumber() > right.GetNumber()));
+
+        NTT_INSTRUCTION(GREATER_EQUAL)
+        NTT_NUMBER_OPERATION(Value::FromBoolean(left.GetNumber() >= right.GetNumber()));
+
+        NTT_INSTRUCTION(NOT)
+        {
+            stackTop[-1] = Value::FromBoolean(!stackTop[-1].IsTruthy());
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(JUMP)
+        {
+            instruction = code + ReadOperand<u32>(instruction);
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(JUMP_IF_FALSE)
+        {
+            stackTop--;
+            instruction = stackTop->IsTruthy() ? instruction + 5 : code + ReadOperand<u32>(instruction);
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(CALL)
+        {
+            u8 numberOfArguments = ReadOperand<u8>(instruction, 3);
+            stackTop -= numberOfArguments;
+            *stackTop = functions[ReadOperand<u16>(instruction)](*this, stackTop, numberOfArguments);
+            stackTop++;
+            instruction += 4;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(HALT)
+        {
+            goto finish;
+        }
+
+#ifndef NTT_MACHINE_COMPUTED_GOTO
+            default:
+                goto finish;
+            }
+        }
+#endif
+
+#undef NTT_NUMBER_OPERATION
+#undef NTT_INSTRUCTION
+#undef NTT_DISPATCH
+
+    finish:
+        m_executedInstructionCount = executedInstructionCount;
+        return error;
+    }
+
+    MachineError Machine::RunRegisters()
+    {
+        const RegisterBytecode &bytecode = *m_registerBytecode;
+        const Vector<Value> &constantValues = bytecode.GetConstants();
+
+        // the constants are in the first registers, the variables and the temporaries
+        //      start as null.
+        m_registers.assign(bytecode.GetRegisterCount(), Value());
+        std::copy(constantValues.begin(), constantValues.end(), m_registers.begin());
+
+        const RegisterInstruction *instruction = bytecode.GetInstructions().data();
+        const RegisterInstruction *code = instruction;
+        const u16 *argumentRegisters = bytecode.GetArgumentRegisters().data();
+        const NativeFunction *functions = m_boundFunctions.data();
+        Value *registers = m_registers.data();
+        u64 executedInstructionCount = 0;
+        MachineError error = MachineError::NO_ERROR;
+
+#ifdef NTT_MACHINE_COMPUTED_GOTO
+        static const void *const dispatchTable[] = {
+            &&MOVE_LABEL,
+            &&ADD_LABEL,
+            &&SUBTRACT_LABEL,
+            &&MULTIPLY_LABEL,
+            &&DIVIDE_LABEL,
+            &&POWER_LABEL,
+            &&EQUAL_LABEL,
+            &&NOT_EQUAL_LABEL,
+            &&LESS_LABEL,
+            &&LESS_EQUAL_LABEL,
+            &&GREATER_LABEL,
+            &&GREATER_EQUAL_LABEL,
+            &&NOT_LABEL,
+            &&ADD_NUMBERS_LABEL,
+            &&SUBTRACT_NUMBERS_LABEL,
+            &&MULTIPLY_NUMBERS_LABEL,
+            &&DIVIDE_NUMBERS_LABEL,
+            &&POWER_NUMBERS_LABEL,
+            &&LESS_NUMBERS_LABEL,
+            &&LESS_EQUAL_NUMBERS_LABEL,
+            &&GREATER_NUMBERS_LABEL,
+            &&GREATER_EQUAL_NUMBERS_LABEL,
+            &&JUMP_LABEL,
+            &&JUMP_IF_FALSE_LABEL,
+            &&CALL_LABEL,
+            &&HALT_LABEL,
+        };
+
+        static_assert(sizeof(dispatchTable) / sizeof(dispatchTable[0]) == u32(RegisterOpCode::COUNT),
+                      "Every op code needs its label.");
+
+#define NTT_DISPATCH()                                      \
+    {                                                       \
+        executedInstructionCount++;                         \
+        goto *dispatchTable[u32(instruction->opCode)];      \
+    }
+#define NTT_INSTRUCTION(name) name##_LABEL:
+
+        NTT_DISPATCH();
+#else
+#define NTT_DISPATCH() continue
+#define NTT_INSTRUCTION(name) case RegisterOpCode::name:
+
+        for (;;)
+        {
+            executedInstructionCount++;
+            switch (instruction->opCode)
+            {
+#endif
+
+// the operands are the registers `b` and `c`, the result is written to `a` once both
+//      are read.
+#define NTT_NUMBER_OPERATION(result)                          \
+    {                                                         \
+        const Value &left = registers[instruction->b];        \
+        const Value &right = registers[instruction->c];       \
+        if (!left.IsNumber() || !right.IsNumber())            \
+        {                                                     \
+            error = MachineError::INVALID_OPERANDS;           \
+            goto finish;                                      \
+        }                                                     \
+        registers[instruction->a] = result;                   \
+        instruction++;                                        \
+        NTT_DISPATCH();                                       \
+    }
+
+// same as `NTT_NUMBER_OPERATION` for the operands which are known to be numbers.
+#define NTT_NUMBERS_OPERATION(result)                         \
+    {                                                         \
+        f64 left = registers[instruction->b].GetNumber();     \
+        f64 right = registers[instruction->c].GetNumber();    \
+        registers[instruction->a] = result;                   \
+        instruction++;                                        \
+        NTT_DISPATCH();                                       \
+    }
+
+        NTT_INSTRUCTION(MOVE)
+        {
+            registers[instruction->a] = registers[instruction->b];
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(ADD)
+        {
+            const Value &left = registers[instruction->b];
+            const Value &right = registers[instruction->c];
+            if (left.IsString() && right.IsString())
+            {
+                registers[instruction->a] = Value::FromString(CreateString(left.GetString() + right.GetString()));
+                instruction++;
+                NTT_DISPATCH();
+            }
+
+            NTT_NUMBER_OPERATION(Value::FromOperationResult(left.GetNumber() + right.GetNumber()));
+        }
+
+        NTT_INSTRUCTION(SUBTRACT)
+        NTT_NUMBER_OPERATION(Value::FromOperationResult(left.GetNumber() - right.GetNumber()));
+
+        NTT_INSTRUCTION(MULTIPLY)
+        NTT_NUMBER_OPERATION(Value::FromOperationResult(left.GetNumber() * right.GetNumber()));
+
+        NTT_INSTRUCTION(DIVIDE)
+        NTT_NUMBER_OPERATION(Value::FromOperationResult(left.GetNumber() / right.GetNumber()));
+
+        NTT_INSTRUCTION(POWER)
+        NTT_NUMBER_OPERATION(Value::FromOperationResult(std::pow(left.GetNumber(), right.GetNumber())));
+
+        NTT_INSTRUCTION(EQUAL)
+        {
+            registers[instruction->a] = Value::FromBoolean(registers[instruction->b].Equals(registers[instruction->c]));
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(NOT_EQUAL)
+        {
+            registers[instruction->a] = Value::FromBoolean(!registers[instruction->b].Equals(registers[instruction->c]));
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(LESS)
+        NTT_NUMBER_OPERATION(Value::FromBoolean(left.GetNumber() < right.GetNumber()));
+
+        NTT_INSTRUCTION(LESS_EQUAL)
+        NTT_NUMBER_OPERATION(Value::FromBoolean(left.GetNumber() <= right.GetNumber()));
+
+        NTT_INSTRUCTION(GREATER)
+        NTT_NUMBER_OPERATION(Value::FromBoolean(left.GetNumber() > right.GetNumber()));
+
+        NTT_INSTRUCTION(GREATER_EQUAL)
+        NTT_NUMBER_OPERATION(Value::FromBoolean(left.GetNumber() >= right.GetNumber()));
+
+        NTT_INSTRUCTION(NOT)
+        {
+            registers[instruction->a] = Value::FromBoolean(!registers[instruction->b].IsTruthy());
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(ADD_NUMBERS)
+        NTT_NUMBERS_OPERATION(Value::FromOperationResult(left + right));
+
+        NTT_INSTRUCTION(SUBTRACT_NUMBERS)
+        NTT_NUMBERS_OPERATION(Value::FromOperationResult(left - right));
+
+        NTT_INSTRUCTION(MULTIPLY_NUMBERS)
+        NTT_NUMBERS_OPERATION(Value::FromOperationResult(left * right));
+
+        NTT_INSTRUCTION(DIVIDE_NUMBERS)
+        NTT_NUMBERS_OPERATION(Value::FromOperationResult(left / right));
+
+        NTT_INSTRUCTION(POWER_NUMBERS)
+        NTT_NUMBERS_OPERATION(Value::FromOperationResult(std::pow(left, right)));
+
+        NTT_INSTRUCTION(LESS_NUMBERS)
+        NTT_NUMBERS_OPERATION(Value::FromBoolean(left < right));
+
+        NTT_INSTRUCTION(LESS_EQUAL_NUMBERS)
+        NTT_NUMBERS_OPERATION(Value::FromBoolean(left <= right));
+
+        NTT_INSTRUCTION(GREATER_NUMBERS)
+        NTT_NUMBERS_OPERATION(Value::FromBoolean(left > right));
+
+        NTT_INSTRUCTION(GREATER_EQUAL_NUMBERS)
+        NTT_NUMBERS_OPERATION(Value::FromBoolean(left >= right));
+
+        NTT_INSTRUCTION(JUMP)
+        {
+            instruction = code + instruction->GetWideOperand();
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(JUMP_IF_FALSE)
+        {
+            instruction = registers[instruction->a].IsTruthy() ? instruction + 1 : code + instruction->GetWideOperand();
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(CALL)
+        {
+            const CallSite &callSite = bytecode.GetCallSite(instruction->GetWideOperand());
+            if (m_callArguments.size() < callSite.numberOfArguments)
+            {
+                m_callArguments.resize(callSite.numberOfArguments);
+            }
+
+            for (u32 argumentIndex = 0; argumentIndex < callSite.numberOfArguments; argumentIndex++)
+            {
+                m_callArguments[argumentIndex] = registers[argumentRegisters[callSite.firstArgument + argumentIndex]];
+            }
+
+            registers[instruction->a] = functions[callSite.function](*this, m_callArguments.data(),
+                                                                     callSite.numberOfArguments);
+            instruction++;
+            NTT_DISPATCH();
+        }
+
+        NTT_INSTRUCTION(HALT)
+        {
+            goto finish;
+        }
+
+#ifndef NTT_MACHINE_COMPUTED_GOTO
+            default:
+                goto finish;
+            }
+        }
+#endif
+
+#undef NTT_NUMBERS_OPERATION
+#undef NTT_NUMBER_OPERATION
+#undef NTT_INSTRUCTION
+#undef NTT_DISPATCH
+
+    finish:
+        m_executedInstructionCount = executedInstructionCount;
+        return error;
+    }
+} // namespace ntt
@@ -0,0 +1,41 @@
+#include "machine_error.h"
+
+namespace ntt
+{
+    String MachineErrorToString(MachineError error)
+    {
+        switch (error)
+        {
+        case MachineError::NO_ERROR:
+            return "No error";
+
+        case MachineError::INVALID_PROGRAM:
+            return "Program has syntax errors";
+        case MachineError::UNSUPPORTED_NODE:
+            return "Unsupported node";
+        case MachineError::UNDEFINED_VARIABLE:
+            return "Undefined variable";
+        case MachineError::REDEFINED_VARIABLE:
+            return "Redefined variable";
+        case MachineError::ASSIGN_TO_CONSTANT:
+            return "Assignment to constant";
+        case MachineError::UNDEFINED_FUNCTION:
+            return "Undefined function";
+        case MachineError::TOO_MANY_CONSTANTS:
+            return "Too many constants";
+        case MachineError::TOO_MANY_VARIABLES:
+            return "Too many variables";
+        case MachineError::TOO_MANY_ARGUMENTS:
+            return "Too many arguments";
+        case MachineError::TYPE_MISMATCH:
+            return "Type mismatch";
+
+        case MachineError::INVALID_OPERANDS:
+            return "Invalid operands";
+        case MachineError::NOT_COMPILED:
+            return "No compiled program";
+        default:
+            return "Unknown error";
+        }
+    }
+} // namespace ntt
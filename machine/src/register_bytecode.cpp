@@ -0,0 +1,162 @@
+#include "register_bytecode.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ntt
+{
+    namespace
+    {
+        constexpr const char *registerOpCodeNames[] = {
+            "MOVE",
+
+            "ADD",
+            "SUBTRACT",
+            "MULTIPLY",
+            "DIVIDE",
+            "POWER",
+
+            "EQUAL",
+            "NOT_EQUAL",
+            "LESS",
+            "LESS_EQUAL",
+            "GREATER",
+            "GREATER_EQUAL",
+            "NOT",
+
+            "ADD_NUMBERS",
+            "SUBTRACT_NUMBERS",
+            "MULTIPLY_NUMBERS",
+            "DIVIDE_NUMBERS",
+            "POWER_NUMBERS",
+            "LESS_NUMBERS",
+            "LESS_EQUAL_NUMBERS",
+            "GREATER_NUMBERS",
+            "GREATER_EQUAL_NUMBERS",
+
+            "JUMP",
+            "JUMP_IF_FALSE",
+            "CALL",
+
+            "HALT",
+        };
+
+        static_assert(sizeof(registerOpCodeNames) / sizeof(registerOpCodeNames[0]) == u32(RegisterOpCode::COUNT),
+                      "Every op code needs its name.");
+    } // namespace anonymous
+
+    String RegisterOpCodeToString(RegisterOpCode opCode)
+    {
+        return opCode < RegisterOpCode::COUNT ? registerOpCodeNames[u32(opCode)] : "UNKNOWN";
+    }
+
+    RegisterBytecode::RegisterBytecode()
+        : m_temporaryCount(0)
+    {
+        m_constants.push_back(Value());
+        m_constants.push_back(Value::FromBoolean(NTT_TRUE));
+        m_constants.push_back(Value::FromBoolean(NTT_FALSE));
+    }
+
+    RegisterBytecode::~RegisterBytecode()
+    {
+    }
+
+    u32 RegisterBytecode::AddNumber(f64 number)
+    {
+        u64 numberBits;
+        std::memcpy(&numberBits, &number, sizeof(number));
+
+        auto constant = m_numberConstants.find(numberBits);
+        if (constant != m_numberConstants.end())
+        {
+            return constant->second;
+        }
+
+        u32 constantIndex = GetConstantCount();
+        m_constants.push_back(Value::FromNumber(number));
+        m_numberConstants.emplace(numberBits, constantIndex);
+        return constantIndex;
+    }
+
+    u32 RegisterBytecode::AddString(const String &text)
+    {
+        auto constant = m_stringConstants.find(text);
+        if (constant != m_stringConstants.end())
+        {
+            return constant->second;
+        }
+
+        u32 constantIndex = GetConstantCount();
+        m_strings.push_back(text);
+        m_constants.push_back(Value::FromString(&m_strings.back()));
+        m_stringConstants.emplace(text, constantIndex);
+        return constantIndex;
+    }
+
+    u32 RegisterBytecode::AddVariable(const String &name)
+    {
+        m_variableNames.push_back(name);
+        return GetVariableCount() - 1;
+    }
+
+    u32 RegisterBytecode::AddFunction(const String &name)
+    {
+        auto function = std::find(m_functionNames.begin(), m_functionNames.end(), name);
+        if (function != m_functionNames.end())
+        {
+            return u32(function - m_functionNames.begin());
+        }
+
+        m_functionNames.push_back(name);
+        return u32(m_functionNames.size()) - 1;
+    }
+
+    u32 RegisterBytecode::AddCallSite(u32 function, u32 numberOfArguments)
+    {
+        m_callSites.push_back({function, u32(m_argumentRegisters.size()), numberOfArguments});
+        return u32(m_callSites.size()) - 1;
+    }
+
+    String RegisterBytecode::Disassemble() const
+    {
+        String text;
+        for (u32 instructionIndex = 0; instructionIndex < GetInstructionCount(); instructionIndex++)
+        {
+            const RegisterInstruction &instruction = m_instructions[instructionIndex];
+            text += std::to_string(instructionIndex) + " " + RegisterOpCodeToString(instruction.opCode);
+
+            switch (instruction.opCode)
+            {
+            case RegisterOpCode::MOVE:
+            case RegisterOpCode::NOT:
+                text += " r" + std::to_string(instruction.a) + " r" + std::to_string(instruction.b);
+                break;
+            case RegisterOpCode::JUMP:
+                text += " " + std::to_string(instruction.GetWideOperand());
+                break;
+            case RegisterOpCode::JUMP_IF_FALSE:
+                text += " r" + std::to_string(instruction.a) + " " + std::to_string(instruction.GetWideOperand());
+                break;
+            case RegisterOpCode::CALL:
+            {
+                const CallSite &callSite = m_callSites[instruction.GetWideOperand()];
+                text += " r" + std::to_string(instruction.a) + " " + m_functionNames[callSite.function];
+                for (u32 argumentIndex = 0; argumentIndex < callSite.numberOfArguments; argumentIndex++)
+                {
+                    text += " r" + std::to_string(m_argumentRegisters[callSite.firstArgument + argumentIndex]);
+                }
+                break;
+            }
+            case RegisterOpCode::HALT:
+                break;
+            default:
+                text += " r" + std::to_string(instruction.a) + " r" + std::to_string(instruction.b) +
+                        " r" + std::to_string(instruction.c);
+                break;
+            }
+
+            text += "\n";
+        }
+        return text;
+    }
+} // namespace ntt
@@ -0,0 +1,641 @@
+#include "register_compiler.h"
+#include "parser/atomic.h"
+#include "parser/blockNode.h"
+#include "parser/function_call.h"
+#include "parser/if_statement.h"
+#include "parser/operationNode.h"
+#include "parser/unaryOperationNode.h"
+#include "parser/variable_definition_node.h"
+#include <algorithm>
+#include <queue>
+
+namespace ntt
+{
+    namespace
+    {
+        constexpr u32 MAX_NUMBER_OF_REGISTERS = 0x10000;
+
+        /**
+         * @return The instruction of a binary operator, `RegisterOpCode::COUNT` for the
+         *      ones the machine does not support.
+         */
+        RegisterOpCode GetBinaryOpCode(Symbol operatorSymbol)
+        {
+            switch (operatorSymbol)
+            {
+            case Symbol::PLUS:
+                return RegisterOpCode::ADD;
+            case Symbol::MINUS:
+                return RegisterOpCode::SUBTRACT;
+            case Symbol::MULTIPLY:
+                return RegisterOpCode::MULTIPLY;
+            case Symbol::DIVIDE:
+                return RegisterOpCode::DIVIDE;
+            case Symbol::CARET:
+                return RegisterOpCode::POWER;
+            case Symbol::EQUAL:
+                return RegisterOpCode::EQUAL;
+            case Symbol::NOT_EQUAL:
+                return RegisterOpCode::NOT_EQUAL;
+            case Symbol::LESS:
+                return RegisterOpCode::LESS;
+            case Symbol::LESS_EQUAL:
+                return RegisterOpCode::LESS_EQUAL;
+            case Symbol::GREATER:
+                return RegisterOpCode::GREATER;
+            case Symbol::GREATER_EQUAL:
+                return RegisterOpCode::GREATER_EQUAL;
+            default:
+                return RegisterOpCode::COUNT;
+            }
+        }
+
+        /**
+         * @return The instruction which skips the type checks of `opCode`, `opCode` when
+         *      it has none.
+         */
+        RegisterOpCode GetNumbersOpCode(RegisterOpCode opCode)
+        {
+            switch (opCode)
+            {
+            case RegisterOpCode::ADD:
+                return RegisterOpCode::ADD_NUMBERS;
+            case RegisterOpCode::SUBTRACT:
+                return RegisterOpCode::SUBTRACT_NUMBERS;
+            case RegisterOpCode::MULTIPLY:
+                return RegisterOpCode::MULTIPLY_NUMBERS;
+            case RegisterOpCode::DIVIDE:
+                return RegisterOpCode::DIVIDE_NUMBERS;
+            case RegisterOpCode::POWER:
+                return RegisterOpCode::POWER_NUMBERS;
+            case RegisterOpCode::LESS:
+                return RegisterOpCode::LESS_NUMBERS;
+            case RegisterOpCode::LESS_EQUAL:
+                return RegisterOpCode::LESS_EQUAL_NUMBERS;
+            case RegisterOpCode::GREATER:
+                return RegisterOpCode::GREATER_NUMBERS;
+            case RegisterOpCode::GREATER_EQUAL:
+                return RegisterOpCode::GREATER_EQUAL_NUMBERS;
+            default:
+                return opCode;
+            }
+        }
+
+        /**
+         * @return Whether the instruction writes the register `a`.
+         */
+        b8 WritesFirstOperand(RegisterOpCode opCode)
+        {
+            return opCode != RegisterOpCode::JUMP &&
+                   opCode != RegisterOpCode::JUMP_IF_FALSE &&
+                   opCode != RegisterOpCode::HALT;
+        }
+    } // namespace anonymous
+
+    RegisterCompiler::RegisterCompiler(RegisterBytecode &bytecode, const TypeInference *types)
+        : m_bytecode(bytecode), m_types(types), m_error(MachineError::NO_ERROR), m_numberOfTemporaries(0),
+          m_numberOfAssignments(0), m_destination(NO_OPERAND), m_result(NO_OPERAND)
+    {
+    }
+
+    RegisterCompiler::~RegisterCompiler()
+    {
+    }
+
+    MachineError RegisterCompiler::Compile(Node &program)
+    {
+        CompileStatement(program);
+        Emit(RegisterOpCode::HALT, NO_OPERAND);
+
+        if (m_error != MachineError::NO_ERROR)
+        {
+            return m_error;
+        }
+
+        u32 numberOfTemporaries = 0;
+        Vector<u32> temporaries = AssignTemporaries(numberOfTemporaries);
+        m_bytecode.SetTemporaryCount(numberOfTemporaries);
+
+        if (m_bytecode.GetRegisterCount() > MAX_NUMBER_OF_REGISTERS)
+        {
+            return MachineError::TOO_MANY_VARIABLES;
+        }
+
+        Encode(temporaries);
+        return MachineError::NO_ERROR;
+    }
+
+    RegisterCompiler::Operand RegisterCompiler::CompileExpression(Node &node, Operand destination)
+    {
+        Operand previousDestination = m_destination;
+        m_destination = destination;
+        m_result = CONSTANT | RegisterBytecode::NULL_CONSTANT;
+
+        CompileNode(node);
+
+        Operand result = m_result;
+        m_destination = previousDestination;
+
+        if (destination != NO_OPERAND && result != destination)
+        {
+            Emit(RegisterOpCode::MOVE, destination, result);
+            result = destination;
+        }
+        return result;
+    }
+
+    void RegisterCompiler::CompileNode(Node &node)
+    {
+        if (m_error != MachineError::NO_ERROR)
+        {
+            return;
+        }
+
+        if (node.HasErrors())
+        {
+            SetError(MachineError::INVALID_PROGRAM);
+            return;
+        }
+
+        node.Accept(*this);
+    }
+
+    void RegisterCompiler::CompileStatement(Node &node)
+    {
+        switch (node.GetType())
+        {
+        case NodeType::ATOMIC:
+        case NodeType::EXPRESSION:
+        case NodeType::OPERATION:
+        case NodeType::UNARY_OPERATION:
+        case NodeType::FUNCTION_CALL:
+            // the value is dropped, an assignment already wrote its variable.
+            CompileExpression(node);
+            break;
+        default:
+            CompileNode(node);
+            break;
+        }
+    }
+
+    void RegisterCompiler::CompileBlock(const Vector<Ref<Node>> &children)
+    {
+        m_scopes.PushBlock();
+
+        for (const Ref<Node> &child : children)
+        {
+            CompileStatement(*child);
+        }
+
+        m_scopes.PopBlock();
+    }
+
+    RegisterCompiler::Operand RegisterCompiler::TakeDestination()
+    {
+        return m_destination != NO_OPERAND ? m_destination : TEMPORARY | m_numberOfTemporaries++;
+    }
+
+    RegisterCompiler::Operand RegisterCompiler::ProtectOperand(Operand operand, u32 position, u32 numberOfAssignments)
+    {
+        if ((operand & OPERAND_KIND_MASK) != VARIABLE ||
+            numberOfAssignments == m_numberOfAssignments ||
+            m_error != MachineError::NO_ERROR)
+        {
+            return operand;
+        }
+
+        Operand temporary = TEMPORARY | m_numberOfTemporaries++;
+        m_instructions.insert(m_instructions.begin() + position,
+                              {RegisterOpCode::MOVE, temporary, operand, NO_OPERAND, 0, 0});
+        return temporary;
+    }
+
+    void RegisterCompiler::Visit(Atomic &node)
+    {
+        const Token &token = node.GetToken();
+
+        switch (token.GetType())
+        {
+        case TokenType::INTEGER:
+            m_result = CONSTANT | m_bytecode.AddNumber(f64(token.GetValue<u64>()));
+            break;
+        case TokenType::FLOAT:
+            m_result = CONSTANT | m_bytecode.AddNumber(token.GetValue<f64>());
+            break;
+        case TokenType::BOOLEAN:
+            m_result = CONSTANT | (token.GetValue<b8>() ? RegisterBytecode::TRUE_CONSTANT
+                                                        : RegisterBytecode::FALSE_CONSTANT);
+            break;
+        case TokenType::STRING:
+            m_result = CONSTANT | m_bytecode.AddString(GetStringContent(token));
+            break;
+        case TokenType::IDENTIFIER:
+        {
+            const VariableScopes::Variable *variable = m_scopes.Find(token.GetSymbol());
+            if (variable == NTT_NULL)
+            {
+                SetError(MachineError::UNDEFINED_VARIABLE);
+                break;
+            }
+
+            m_result = VARIABLE | variable->slot;
+            break;
+        }
+        case TokenType::NONE:
+            // the default value of the `any` variables.
+            m_result = CONSTANT | RegisterBytecode::NULL_CONSTANT;
+            break;
+        case TokenType::KEYWORD:
+            if (token.GetSymbol() == Symbol::NULL_VALUE)
+            {
+                m_result = CONSTANT | RegisterBytecode::NULL_CONSTANT;
+                break;
+            }
+            SetError(MachineError::UNSUPPORTED_NODE);
+            break;
+        default:
+            SetError(MachineError::UNSUPPORTED_NODE);
+            break;
+        }
+    }
+
+    void RegisterCompiler::Visit(BlockNode &node)
+    {
+        switch (node.GetType())
+        {
+        case NodeType::PROGRAM:
+        case NodeType::BLOCK:
+            CompileBlock(node.GetChildren());
+            break;
+        case NodeType::STATEMENT:
+            for (const Ref<Node> &child : node.GetChildren())
+            {
+                CompileStatement(*child);
+            }
+            break;
+        case NodeType::EXPRESSION:
+            if (node.GetChildren().size() != 1)
+            {
+                SetError(MachineError::UNSUPPORTED_NODE);
+                break;
+            }
+            m_result = CompileExpression(*node.GetChildren()[0], m_destination);
+            break;
+        default:
+            SetError(MachineError::UNSUPPORTED_NODE);
+            break;
+        }
+    }
+
+    void RegisterCompiler::Visit(InvalidNode &node)
+    {
+        NTT_UNUSED(node);
+        SetError(MachineError::INVALID_PROGRAM);
+    }
+
+    void RegisterCompiler::Visit(OperationNode &node)
+    {
+        Symbol operatorSymbol = GetAtomicSymbol(node.GetOperator());
+        if (operatorSymbol == Symbol::ASSIGN)
+        {
+            if (!IsIdentifierAtomic(node.GetLeftOperand()) || node.GetRightOperand() == NTT_NULL)
+            {
+                SetError(MachineError::UNSUPPORTED_NODE);
+                return;
+            }
+
+            const VariableScopes::Variable *variable = m_scopes.Find(GetAtomicSymbol(node.GetLeftOperand()));
+            if (variable == NTT_NULL)
+            {
+                SetError(MachineError::UNDEFINED_VARIABLE);
+                return;
+            }
+
+            if (variable->isConstant)
+            {
+                SetError(MachineError::ASSIGN_TO_CONSTANT);
+                return;
+            }
+
+            m_result = CompileExpression(*node.GetRightOperand(), VARIABLE | variable->slot);
+            m_numberOfAssignments++;
+            return;
+        }
+
+        RegisterOpCode opCode = GetBinaryOpCode(operatorSymbol);
+        if (opCode == RegisterOpCode::COUNT || node.GetLeftOperand() == NTT_NULL || node.GetRightOperand() == NTT_NULL)
+        {
+            SetError(MachineError::UNSUPPORTED_NODE);
+            return;
+        }
+
+        if (m_types != NTT_NULL &&
+            m_types->GetType(*node.GetLeftOperand()) == StaticType::NUMBER &&
+            m_types->GetType(*node.GetRightOperand()) == StaticType::NUMBER)
+        {
+            opCode = GetNumbersOpCode(opCode);
+        }
+
+        Operand leftOperand = CompileExpression(*node.GetLeftOperand());
+        u32 position = u32(m_instructions.size());
+        u32 numberOfAssignments = m_numberOfAssignments;
+
+        Operand rightOperand = CompileExpression(*node.GetRightOperand());
+        leftOperand = ProtectOperand(leftOperand, position, numberOfAssignments);
+
+        Operand destination = TakeDestination();
+        Emit(opCode, destination, leftOperand, rightOperand);
+        m_result = destination;
+    }
+
+    void RegisterCompiler::Visit(UnaryOperationNode &node)
+    {
+        if (GetAtomicSymbol(node.GetOperator()) != Symbol::NOT || node.GetOperand() == NTT_NULL)
+        {
+            SetError(MachineError::UNSUPPORTED_NODE);
+            return;
+        }
+
+        Operand operand = CompileExpression(*node.GetOperand());
+        Operand destination = TakeDestination();
+        Emit(RegisterOpCode::NOT, destination, operand);
+        m_result = destination;
+    }
+
+    void RegisterCompiler::Visit(IfStatementNode &node)
+    {
+        if (node.GetCondition() == NTT_NULL || node.GetBlock() == NTT_NULL)
+        {
+            SetError(MachineError::INVALID_PROGRAM);
+            return;
+        }
+
+        Operand condition = CompileExpression(*node.GetCondition());
+        u32 elseJump = u32(m_instructions.size());
+        Emit(RegisterOpCode::JUMP_IF_FALSE, condition);
+        CompileStatement(*node.GetBlock());
+
+        const BlockNode *elseBlock = NodeCast<BlockNode>(node.GetElseBlock().get());
+        if (node.GetElseBlock() == NTT_NULL || (elseBlock != NTT_NULL && elseBlock->GetChildren().empty()))
+        {
+            PatchJump(elseJump);
+            return;
+        }
+
+        u32 endJump = u32(m_instructions.size());
+        Emit(RegisterOpCode::JUMP, NO_OPERAND);
+        PatchJump(elseJump);
+        CompileStatement(*node.GetElseBlock());
+        PatchJump(endJump);
+    }
+
+    void RegisterCompiler::Visit(FunctionCallNode &node)
+    {
+        if (!IsIdentifierAtomic(node.GetFunction()))
+        {
+            SetError(MachineError::UNSUPPORTED_NODE);
+            return;
+        }
+
+        // all the arguments are read by the call itself, the ones which are variables
+        //      must not see the assignments of the arguments after them.
+        const Vector<Ref<Node>> &arguments = node.GetArguments();
+        Vector<Operand> argumentOperands;
+        Vector<u32> positions;
+        Vector<u32> numbersOfAssignments;
+        for (const Ref<Node> &argument : arguments)
+        {
+            argumentOperands.push_back(CompileExpression(*argument));
+            positions.push_back(u32(m_instructions.size()));
+            numbersOfAssignments.push_back(m_numberOfAssignments);
+        }
+
+        for (u32 argumentIndex = u32(arguments.size()); argumentIndex-- > 0;)
+        {
+            argumentOperands[argumentIndex] = ProtectOperand(argumentOperands[argumentIndex],
+                                                             positions[argumentIndex],
+                                                             numbersOfAssignments[argumentIndex]);
+        }
+
+        if (m_error != MachineError::NO_ERROR)
+        {
+            return;
+        }
+
+        std::string_view name = NodeCast<Atomic>(node.GetFunction().get())->GetToken().GetValue<std::string_view>();
+        u32 functionIndex = m_bytecode.AddFunction(String(name));
+
+        Operand destination = TakeDestination();
+        m_instructions.push_back({RegisterOpCode::CALL, destination, functionIndex, NO_OPERAND,
+                                  u32(m_arguments.size()), u32(argumentOperands.size())});
+        m_arguments.insert(m_arguments.end(), argumentOperands.begin(), argumentOperands.end());
+        m_result = destination;
+    }
+
+    void RegisterCompiler::Visit(VariableDefinitionNode &node)
+    {
+        if (!IsIdentifierAtomic(node.GetName()) || node.GetDefaultValue() == NTT_NULL)
+        {
+            SetError(MachineError::INVALID_PROGRAM);
+            return;
+        }
+
+        Symbol name = GetAtomicSymbol(node.GetName());
+        if (m_scopes.IsDefinedInBlock(name))
+        {
+            SetError(MachineError::REDEFINED_VARIABLE);
+            return;
+        }
+
+        // the variable is only visible once its default value is compiled, so the default
+        //      value still sees the variables the new one hides.
+        u32 slot = m_bytecode.AddVariable(String(SymbolTable::Get().GetText(name)));
+        CompileExpression(*node.GetDefaultValue(), VARIABLE | slot);
+        m_scopes.Add(name, slot, GetAtomicSymbol(node.GetDefineType()) == Symbol::CONST);
+    }
+
+    void RegisterCompiler::Emit(RegisterOpCode opCode, Operand a, Operand b, Operand c)
+    {
+        if (m_error != MachineError::NO_ERROR)
+        {
+            return;
+        }
+
+        m_instructions.push_back({opCode, a, b, c, 0, 0});
+    }
+
+    void RegisterCompiler::PatchJump(u32 jumpIndex)
+    {
+        if (m_error != MachineError::NO_ERROR)
+        {
+            return;
+        }
+
+        m_instructions[jumpIndex].b = u32(m_instructions.size());
+    }
+
+    Vector<u32> RegisterCompiler::AssignTemporaries(u32 &outNumberOfTemporaries) const
+    {
+        constexpr u32 NO_POSITION = 0xFFFFFFFF;
+        Vector<u32> starts(m_numberOfTemporaries, NO_POSITION);
+        Vector<u32> ends(m_numberOfTemporaries, 0);
+
+        auto readOperand = [&](Operand operand, u32 position)
+        {
+            if ((operand & OPERAND_KIND_MASK) == TEMPORARY)
+            {
+                ends[operand & ~OPERAND_KIND_MASK] = position;
+            }
+        };
+
+        for (u32 position = 0; position < m_instructions.size(); position++)
+        {
+            const PendingInstruction &instruction = m_instructions[position];
+            switch (instruction.opCode)
+            {
+            case RegisterOpCode::JUMP:
+            case RegisterOpCode::HALT:
+                break;
+            case RegisterOpCode::JUMP_IF_FALSE:
+                readOperand(instruction.a, position);
+                break;
+            case RegisterOpCode::CALL:
+                for (u32 argumentIndex = 0; argumentIndex < instruction.numberOfArguments; argumentIndex++)
+                {
+                    readOperand(m_arguments[instruction.firstArgument + argumentIndex], position);
+                }
+                break;
+            default:
+                readOperand(instruction.b, position);
+                readOperand(instruction.c, position);
+                break;
+            }
+
+            if (WritesFirstOperand(instruction.opCode) && (instruction.a & OPERAND_KIND_MASK) == TEMPORARY)
+            {
+                u32 temporary = instruction.a & ~OPERAND_KIND_MASK;
+                starts[temporary] = position;
+                ends[temporary] = std::max(ends[temporary], position);
+            }
+        }
+
+        Vector<u32> order(m_numberOfTemporaries);
+        for (u32 temporary = 0; temporary < m_numberOfTemporaries; temporary++)
+        {
+            order[temporary] = temporary;
+        }
+        std::sort(order.begin(), order.end(), [&](u32 left, u32 right)
+                  { return starts[left] < starts[right]; });
+
+        // a range which ends at the instruction where another one starts can share its
+        //      register, the instructions read all their operands before they write.
+        typedef std::pair<u32, u32> ActiveRange;
+        std::priority_queue<ActiveRange, Vector<ActiveRange>, std::greater<ActiveRange>> activeRanges;
+        std::priority_queue<u32, Vector<u32>, std::greater<u32>> freeRegisters;
+
+        Vector<u32> assignedRegisters(m_numberOfTemporaries, 0);
+        outNumberOfTemporaries = 0;
+
+        for (u32 temporary : order)
+        {
+            while (!activeRanges.empty() && activeRanges.top().first <= starts[temporary])
+            {
+                freeRegisters.push(activeRanges.top().second);
+                activeRanges.pop();
+            }
+
+            u32 assignedRegister;
+            if (freeRegisters.empty())
+            {
+                assignedRegister = outNumberOfTemporaries++;
+            }
+            else
+            {
+                assignedRegister = freeRegisters.top();
+                freeRegisters.pop();
+            }
+
+            assignedRegisters[temporary] = assignedRegister;
+            activeRanges.push({ends[temporary], assignedRegister});
+        }
+
+        return assignedRegisters;
+    }
+
+    void RegisterCompiler::Encode(const Vector<u32> &temporaries)
+    {
+        u32 numberOfConstants = m_bytecode.GetConstantCount();
+        u32 numberOfVariables = m_bytecode.GetVariableCount();
+
+        auto toRegister = [&](Operand operand) -> u16
+        {
+            u32 index = operand & ~OPERAND_KIND_MASK;
+            switch (operand & OPERAND_KIND_MASK)
+            {
+            case CONSTANT:
+                return u16(index);
+            case VARIABLE:
+                return u16(numberOfConstants + index);
+            case TEMPORARY:
+                return u16(numberOfConstants + numberOfVariables + temporaries[index]);
+            default:
+                return 0;
+            }
+        };
+
+        Vector<RegisterInstruction> instructions;
+        instructions.reserve(m_instructions.size());
+
+        for (const PendingInstruction &pendingInstruction : m_instructions)
+        {
+            RegisterInstruction instruction = {pendingInstruction.opCode, 0, 0, 0};
+            u32 wideOperand = 0;
+
+            switch (pendingInstruction.opCode)
+            {
+            case RegisterOpCode::JUMP:
+                wideOperand = pendingInstruction.b;
+                break;
+            case RegisterOpCode::JUMP_IF_FALSE:
+                instruction.a = toRegister(pendingInstruction.a);
+                wideOperand = pendingInstruction.b;
+                break;
+            case RegisterOpCode::CALL:
+                instruction.a = toRegister(pendingInstruction.a);
+                wideOperand = m_bytecode.AddCallSite(pendingInstruction.b, pendingInstruction.numberOfArguments);
+                for (u32 argumentIndex = 0; argumentIndex < pendingInstruction.numberOfArguments; argumentIndex++)
+                {
+                    m_bytecode.AddArgumentRegister(toRegister(m_arguments[pendingInstruction.firstArgument + argumentIndex]));
+                }
+                break;
+            case RegisterOpCode::HALT:
+                break;
+            default:
+                instruction.a = toRegister(pendingInstruction.a);
+                instruction.b = toRegister(pendingInstruction.b);
+                instruction.c = toRegister(pendingInstruction.c);
+                break;
+            }
+
+            if (pendingInstruction.opCode == RegisterOpCode::JUMP ||
+                pendingInstruction.opCode == RegisterOpCode::JUMP_IF_FALSE ||
+                pendingInstruction.opCode == RegisterOpCode::CALL)
+            {
+                instruction.b = u16(wideOperand & 0xFFFF);
+                instruction.c = u16(wideOperand >> 16);
+            }
+
+            instructions.push_back(instruction);
+        }
+
+        m_bytecode.SetInstructions(std::move(instructions));
+    }
+
+    void RegisterCompiler::SetError(MachineError error)
+    {
+        if (m_error == MachineError::NO_ERROR)
+        {
+            m_error = error;
+        }
+    }
+} // namespace ntt
@@ -0,0 +1,312 @@
+#include "type_inference.h"
+#include "parser/atomic.h"
+#include "parser/blockNode.h"
+#include "parser/function_call.h"
+#include "parser/if_statement.h"
+#include "parser/operationNode.h"
+#include "parser/unaryOperationNode.h"
+#include "parser/variable_definition_node.h"
+
+namespace ntt
+{
+    namespace
+    {
+        StaticType GetHintType(const Ref<Node> &typeNode)
+        {
+            switch (GetAtomicSymbol(typeNode))
+            {
+            case Symbol::NUMBER:
+                return StaticType::NUMBER;
+            case Symbol::STRING:
+                return StaticType::STRING;
+            case Symbol::BOOLEAN:
+                return StaticType::BOOLEAN;
+            default:
+                return StaticType::ANY;
+            }
+        }
+    } // namespace anonymous
+
+    String StaticTypeToString(StaticType type)
+    {
+        switch (type)
+        {
+        case StaticType::ANY:
+            return "any";
+        case StaticType::NUMBER:
+            return "number";
+        case StaticType::STRING:
+            return "string";
+        case StaticType::BOOLEAN:
+            return "boolean";
+        default:
+            return "unknown";
+        }
+    }
+
+    TypeInference::TypeInference()
+        : m_numberOfVisitedVariables(0), m_hasVariableChanged(NTT_FALSE),
+          m_result(StaticType::ANY), m_error(MachineError::NO_ERROR)
+    {
+    }
+
+    TypeInference::~TypeInference()
+    {
+    }
+
+    MachineError TypeInference::Infer(Node &program)
+    {
+        m_variableTypes.clear();
+        m_error = MachineError::NO_ERROR;
+
+        // the variables only ever change to ANY, so the walks stop after at most one
+        //      walk per variable.
+        do
+        {
+            m_types.clear();
+            m_numberOfVisitedVariables = 0;
+            m_hasVariableChanged = NTT_FALSE;
+            InferNode(program);
+        } while (m_hasVariableChanged);
+
+        return m_error;
+    }
+
+    StaticType TypeInference::GetType(const Node &node) const
+    {
+        auto type = m_types.find(&node);
+        return type != m_types.end() ? type->second : StaticType::ANY;
+    }
+
+    StaticType TypeInference::InferNode(Node &node)
+    {
+        m_result = StaticType::ANY;
+        node.Accept(*this);
+
+        StaticType type = m_result;
+        m_types[&node] = type;
+        return type;
+    }
+
+    void TypeInference::Visit(Atomic &node)
+    {
+        const Token &token = node.GetToken();
+
+        switch (token.GetType())
+        {
+        case TokenType::INTEGER:
+        case TokenType::FLOAT:
+            m_result = StaticType::NUMBER;
+            break;
+        case TokenType::STRING:
+            m_result = StaticType::STRING;
+            break;
+        case TokenType::BOOLEAN:
+            m_result = StaticType::BOOLEAN;
+            break;
+        case TokenType::IDENTIFIER:
+        {
+            // the undefined variables are reported by the compilers.
+            const VariableScopes::Variable *variable = m_scopes.Find(token.GetSymbol());
+            m_result = variable != NTT_NULL ? m_variableTypes[variable->slot] : StaticType::ANY;
+            break;
+        }
+        default:
+            m_result = StaticType::ANY;
+            break;
+        }
+    }
+
+    void TypeInference::Visit(BlockNode &node)
+    {
+        switch (node.GetType())
+        {
+        case NodeType::PROGRAM:
+        case NodeType::BLOCK:
+            m_scopes.PushBlock();
+            for (const Ref<Node> &child : node.GetChildren())
+            {
+                InferNode(*child);
+            }
+            m_scopes.PopBlock();
+            m_result = StaticType::ANY;
+            break;
+        case NodeType::EXPRESSION:
+        {
+            StaticType type = StaticType::ANY;
+            for (const Ref<Node> &child : node.GetChildren())
+            {
+                type = InferNode(*child);
+            }
+            m_result = node.GetChildren().size() == 1 ? type : StaticType::ANY;
+            break;
+        }
+        default:
+            for (const Ref<Node> &child : node.GetChildren())
+            {
+                InferNode(*child);
+            }
+            m_result = StaticType::ANY;
+            break;
+        }
+    }
+
+    void TypeInference::Visit(InvalidNode &node)
+    {
+        NTT_UNUSED(node);
+        m_result = StaticType::ANY;
+    }
+
+    void TypeInference::Visit(OperationNode &node)
+    {
+        if (node.GetLeftOperand() == NTT_NULL || node.GetRightOperand() == NTT_NULL)
+        {
+            m_result = StaticType::ANY;
+            return;
+        }
+
+        Symbol operatorSymbol = GetAtomicSymbol(node.GetOperator());
+        if (operatorSymbol == Symbol::ASSIGN)
+        {
+            // the value of an assignment is the assigned value.
+            StaticType valueType = InferNode(*node.GetRightOperand());
+            const VariableScopes::Variable *variable = m_scopes.Find(GetAtomicSymbol(node.GetLeftOperand()));
+            if (variable != NTT_NULL)
+            {
+                Assign(variable->slot, valueType);
+            }
+
+            InferNode(*node.GetLeftOperand());
+            m_result = valueType;
+            return;
+        }
+
+        StaticType leftType = InferNode(*node.GetLeftOperand());
+        StaticType rightType = InferNode(*node.GetRightOperand());
+
+        switch (operatorSymbol)
+        {
+        case Symbol::PLUS:
+            // the machine adds two numbers or two strings, one known operand tells both.
+            if (leftType == StaticType::BOOLEAN || rightType == StaticType::BOOLEAN ||
+                (leftType != StaticType::ANY && rightType != StaticType::ANY && leftType != rightType))
+            {
+                SetError(MachineError::TYPE_MISMATCH);
+                m_result = StaticType::ANY;
+            }
+            else
+            {
+                m_result = leftType != StaticType::ANY ? leftType : rightType;
+            }
+            break;
+        case Symbol::MINUS:
+        case Symbol::MULTIPLY:
+        case Symbol::DIVIDE:
+        case Symbol::CARET:
+            CheckOperand(leftType, StaticType::NUMBER);
+            CheckOperand(rightType, StaticType::NUMBER);
+            m_result = StaticType::NUMBER;
+            break;
+        case Symbol::LESS:
+        case Symbol::LESS_EQUAL:
+        case Symbol::GREATER:
+        case Symbol::GREATER_EQUAL:
+            CheckOperand(leftType, StaticType::NUMBER);
+            CheckOperand(rightType, StaticType::NUMBER);
+            m_result = StaticType::BOOLEAN;
+            break;
+        case Symbol::EQUAL:
+        case Symbol::NOT_EQUAL:
+            m_result = StaticType::BOOLEAN;
+            break;
+        default:
+            m_result = StaticType::ANY;
+            break;
+        }
+    }
+
+    void TypeInference::Visit(UnaryOperationNode &node)
+    {
+        if (node.GetOperand() != NTT_NULL)
+        {
+            InferNode(*node.GetOperand());
+        }
+
+        m_result = GetAtomicSymbol(node.GetOperator()) == Symbol::NOT ? StaticType::BOOLEAN : StaticType::ANY;
+    }
+
+    void TypeInference::Visit(IfStatementNode &node)
+    {
+        for (const Ref<Node> &child : {node.GetCondition(), node.GetBlock(), node.GetElseBlock()})
+        {
+            if (child != NTT_NULL)
+            {
+                InferNode(*child);
+            }
+        }
+
+        m_result = StaticType::ANY;
+    }
+
+    void TypeInference::Visit(FunctionCallNode &node)
+    {
+        for (const Ref<Node> &argument : node.GetArguments())
+        {
+            InferNode(*argument);
+        }
+
+        // the native functions can return anything.
+        m_result = StaticType::ANY;
+    }
+
+    void TypeInference::Visit(VariableDefinitionNode &node)
+    {
+        u32 slot = m_numberOfVisitedVariables++;
+        if (slot == m_variableTypes.size())
+        {
+            m_variableTypes.push_back(GetHintType(node.GetTypeNode()));
+        }
+
+        // like in the compilers the default value does not see the new variable yet.
+        if (node.GetDefaultValue() != NTT_NULL)
+        {
+            Assign(slot, InferNode(*node.GetDefaultValue()));
+        }
+
+        m_scopes.Add(GetAtomicSymbol(node.GetName()), slot, GetAtomicSymbol(node.GetDefineType()) == Symbol::CONST);
+        m_result = m_variableTypes[slot];
+    }
+
+    void TypeInference::Assign(u32 slot, StaticType valueType)
+    {
+        StaticType &variableType = m_variableTypes[slot];
+        if (variableType == StaticType::ANY || variableType == valueType)
+        {
+            return;
+        }
+
+        if (valueType != StaticType::ANY)
+        {
+            SetError(MachineError::TYPE_MISMATCH);
+        }
+
+        variableType = StaticType::ANY;
+        m_hasVariableChanged = NTT_TRUE;
+    }
+
+    void TypeInference::CheckOperand(StaticType operandType, StaticType expectedType)
+    {
+        if (operandType != StaticType::ANY && operandType != expectedType)
+        {
+            SetError(MachineError::TYPE_MISMATCH);
+        }
+    }
+
+    void TypeInference::SetError(MachineError error)
+    {
+        if (m_error == MachineError::NO_ERROR)
+        {
+            m_error = error;
+        }
+    }
+} // namespace ntt
@@ -0,0 +1,81 @@
+#include "value.h"
+#include <cmath>
+
+namespace ntt
+{
+    String ValueTypeToString(ValueType type)
+    {
+        switch (type)
+        {
+        case ValueType::NULL_VALUE:
+            return "null";
+        case ValueType::NUMBER:
+            return "number";
+        case ValueType::BOOLEAN:
+            return "boolean";
+        case ValueType::STRING:
+            return "string";
+        default:
+            return "unknown";
+        }
+    }
+
+    b8 Value::IsTruthy() const
+    {
+        if (IsNumber())
+        {
+            return GetNumber() != 0.0;
+        }
+
+        if (IsString())
+        {
+            return !GetString().empty();
+        }
+
+        return m_bits == TRUE_BITS;
+    }
+
+    b8 Value::Equals(const Value &other) const
+    {
+        if (IsNumber() || other.IsNumber())
+        {
+            // compared as numbers so that `0 == -0` and `NaN != NaN`, a number is never
+            //      equal to a boxed value.
+            return IsNumber() && other.IsNumber() && GetNumber() == other.GetNumber();
+        }
+
+        if (m_bits == other.m_bits)
+        {
+            return NTT_TRUE;
+        }
+
+        return IsString() && other.IsString() && GetString() == other.GetString();
+    }
+
+    String Value::ToString() const
+    {
+        switch (GetType())
+        {
+        case ValueType::NUMBER:
+        {
+            f64 number = GetNumber();
+            char text[32];
+            if (std::trunc(number) == number && std::fabs(number) < 1e15)
+            {
+                snprintf(text, sizeof(text), "%lld", (long long)number);
+            }
+            else
+            {
+                snprintf(text, sizeof(text), "%.15g", number);
+            }
+            return text;
+        }
+        case ValueType::BOOLEAN:
+            return GetBoolean() ? "true" : "false";
+        case ValueType::STRING:
+            return GetString();
+        default:
+            return "null";
+        }
+    }
+} // namespace ntt